@@ -0,0 +1,385 @@
+#!/usr/bin/env python3
+"""
+Throughput and Latency Benchmark for ST7735 Displays
+Reproducible end-to-end measurements of the firmware and the serial link
+
+Two parts:
+- Device kernels: CMD:BENCH runs synthetic fills, band blits and decoders
+  on the Arduino and reports microseconds per frame (no USB in the loop)
+- Host transfers: binary BLIT frames per encoding, image size and display,
+  measuring frames per second and time to first pixel (the ack of a
+  single-row frame: header, decode, address window and SPI for one row)
+
+Results are written as JSON (--json) and can be compared against a
+baseline run (--baseline) to catch regressions after a firmware change;
+the exit status is 1 when any result is worse than --tolerance.
+
+Requirements:
+- Python 3.6+
+- pyserial: pip install pyserial
+- Pillow (PIL): pip install Pillow
+
+Usage:
+    python3 benchmark.py [serial_port] --device DueLCD01 [--json results.json]
+
+Example:
+    python3 benchmark.py --device all --json baseline.json
+    python3 benchmark.py --device DueLCD01 --sizes full,64x64 --encodings raw,qoi
+    python3 benchmark.py --device all --baseline baseline.json --tolerance 10
+"""
+
+import sys
+import time
+import json
+import argparse
+import platform
+import subprocess
+import statistics
+import serial
+from PIL import Image, ImageOps
+
+try:
+    from st7735_tools.config_loader import find_config_files, get_config_by_device_name
+    from st7735_tools import binary_protocol
+    from st7735_tools import pixel_codec
+except ImportError:
+    print("Error: st7735_tools module not found. Run from the project directory.")
+    sys.exit(1)
+
+SERIAL_BAUDRATE = 115200
+TIMEOUT_SECONDS = 10
+STARTUP_SECONDS = 5        # Native USB open resets the Due
+RESULT_SCHEMA = 1
+
+# Host transfer encodings (--encodings)
+ENCODING_CHOICES = {
+    'raw': binary_protocol.ENC_RGB565,
+    'rle': binary_protocol.ENC_RLE,
+    'qoi': binary_protocol.ENC_QOI,
+    'idx4': binary_protocol.ENC_INDEXED4,
+    'rgb888': binary_protocol.ENC_RGB888,
+    'fs': binary_protocol.ENC_RGB888 | binary_protocol.ENC_DITHER_DIFFUSE,
+}
+
+# Result fields compared against a baseline: (field, True if higher is better)
+DEVICE_METRICS = [('avg_us', False)]
+HOST_METRICS = [('fps', True), ('ttfp_ms', False)]
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def synthetic_image(width, height, source=None):
+    """Benchmark image: a photo-like gradient with a checker overlay, or source fitted to the size"""
+    if source:
+        return ImageOps.fit(Image.open(source).convert('RGB'), (width, height))
+    image = Image.new('RGB', (width, height))
+    image.putdata([((x * 255) // max(width - 1, 1),
+                    (y * 255) // max(height - 1, 1),
+                    255 if (x // 8 + y // 8) & 1 else 64)
+                   for y in range(height) for x in range(width)])
+    return image
+
+
+def encode_image(image, encoding):
+    """(encoding as sent, payload) for a PIL RGB image"""
+    if pixel_codec.is_true_color(encoding):
+        return encoding, image.tobytes()
+    if encoding in pixel_codec.INDEX_BITS:
+        image = image.quantize(1 << pixel_codec.INDEX_BITS[encoding]).convert('RGB')
+    pixels = [rgb565(*p) for p in image.getdata()]
+    return pixel_codec.encode(pixels, encoding)
+
+
+def parse_size(text, config):
+    """'full' (the display's usable area) or WxH"""
+    if text == 'full':
+        return config.usable_width, config.usable_height
+    width, height = (int(v) for v in text.lower().split('x'))
+    return width, height
+
+
+class Benchmark:
+    def __init__(self, connection, verbose=False):
+        self.connection = connection
+        self.verbose = verbose
+        self.link = binary_protocol.BinaryFrameLink(connection, ack_timeout=TIMEOUT_SECONDS,
+                                                    on_text=self._log)
+
+    def _log(self, line):
+        if self.verbose:
+            print(f"Arduino: {line}")
+
+    def command(self, line, end, timeout=TIMEOUT_SECONDS):
+        """
+        Send a text command and collect its reply lines
+
+        Returns:
+            list of lines up to (excluding) the one starting with end
+
+        Raises:
+            RuntimeError: on an ERROR: reply
+            TimeoutError: if end does not arrive in time
+        """
+        self.connection.reset_input_buffer()
+        self.connection.write(line.encode() + b"\n")
+        self.connection.flush()
+        lines = []
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            reply = self.connection.readline().decode('utf-8', errors='ignore').strip()
+            if not reply:
+                continue
+            self._log(reply)
+            if reply.startswith('ERROR:'):
+                raise RuntimeError(f"{line}: {reply}")
+            if reply.startswith(end):
+                return lines
+            lines.append(reply)
+        raise TimeoutError(f"No {end} after {line}")
+
+    def select(self, name):
+        """Make name the selected display for CMD: commands"""
+        self.connection.write(f"DISPLAY:{name}\n".encode())
+        self.connection.flush()
+        time.sleep(0.2)
+        self.connection.reset_input_buffer()
+
+    def device_kernels(self, name, frames, size=None):
+        """
+        CMD:BENCH on one display
+
+        Returns:
+            list of result dicts (kernel, display, width, height, frames, avg_us, ...)
+        """
+        self.select(name)
+        command = f"CMD:BENCH:ALL,{frames}"
+        if size:
+            command += f",{size[0]},{size[1]}"
+        results = []
+        for line in self.command(command, 'END_BENCH', timeout=TIMEOUT_SECONDS + frames):
+            if not line.startswith('BENCH:'):
+                continue
+            fields = dict(item.split('=', 1) for item in line[6:].split(','))
+            results.append({key: (value if key in ('kernel', 'display') else int(value))
+                            for key, value in fields.items()})
+        return results
+
+    def host_transfer(self, name, index, encoding_name, width, height, frames, source=None):
+        """
+        Binary BLIT frames of one encoding and size, centred on one display
+
+        Returns:
+            result dict
+
+        Raises:
+            RuntimeError: if the firmware rejects a frame (e.g. an encoding it lacks)
+        """
+        image = synthetic_image(width, height, source)
+        encoding, payload = encode_image(image, ENCODING_CHOICES[encoding_name])
+        first_encoding, first_row = encode_image(image.crop((0, 0, width, 1)), ENCODING_CHOICES[encoding_name])
+        flags = (binary_protocol.FLAG_DISPLAY_MASK | binary_protocol.FLAG_CENTER |
+                 binary_protocol.FLAG_CREDIT)
+
+        def blit(data, blit_encoding, rows):
+            start = time.perf_counter()
+            ack = self.link.blit(data, width, rows, display_id=1 << index, flags=flags,
+                                 encoding=blit_encoding)
+            if not ack.ok:
+                raise RuntimeError(f"{encoding_name} {width}x{rows}: {ack.status_name}")
+            return time.perf_counter() - start
+
+        # Time to first pixel: single-row frames; full frames back to back for the rate
+        first_pixel = [blit(first_row, first_encoding, 1) for _ in range(frames)]
+        start = time.perf_counter()
+        frame_times = [blit(payload, encoding, height) for _ in range(frames)]
+        elapsed = time.perf_counter() - start
+        return {
+            'display': name,
+            'encoding': encoding_name,
+            'width': width,
+            'height': height,
+            'payload_bytes': len(payload),
+            'frames': frames,
+            'fps': round(frames / elapsed, 2),
+            'frame_ms_avg': round(statistics.mean(frame_times) * 1000, 2),
+            'frame_ms_max': round(max(frame_times) * 1000, 2),
+            'throughput_kib_s': round(len(payload) * frames / elapsed / 1024, 1),
+            'ttfp_ms': round(statistics.median(first_pixel) * 1000, 2),
+        }
+
+
+def git_revision():
+    try:
+        return subprocess.check_output(['git', 'rev-parse', '--short', 'HEAD'],
+                                       stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def result_key(result, fields):
+    return tuple(result[field] for field in fields)
+
+
+def compare(results, baseline, tolerance):
+    """
+    Print results that are worse than the baseline by more than tolerance percent
+
+    Returns:
+        number of regressions
+    """
+    regressions = 0
+    for section, key_fields, metrics in (
+            ('device', ('kernel', 'display', 'width', 'height'), DEVICE_METRICS),
+            ('host_transfers', ('encoding', 'display', 'width', 'height'), HOST_METRICS)):
+        previous = {result_key(r, key_fields): r for r in baseline.get(section, [])}
+        for result in results.get(section, []):
+            old = previous.get(result_key(result, key_fields))
+            if not old:
+                continue
+            for metric, higher_is_better in metrics:
+                if not old.get(metric):
+                    continue
+                change = (result[metric] - old[metric]) / old[metric] * 100
+                if (-change if higher_is_better else change) > tolerance:
+                    regressions += 1
+                    label = ' '.join(str(v) for v in result_key(result, key_fields))
+                    print(f"REGRESSION {section} {label} {metric}: {old[metric]} -> {result[metric]} "
+                          f"({change:+.1f}%)")
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark ST7735 firmware kernels and serial transfers",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  python3 benchmark.py --device DueLCD01                      # Print results
+  python3 benchmark.py --device all --json baseline.json      # Save a baseline
+  python3 benchmark.py --device all --baseline baseline.json  # Fail on regressions
+  python3 benchmark.py --device DueLCD01 --sizes full,32x32 --encodings raw,rle,qoi
+  python3 benchmark.py --device DueLCD01 --image tiger.png --skip-device
+        """
+    )
+    parser.add_argument('serial_port', nargs='?', default='/dev/ttyACM0',
+                        help='Serial port (default: /dev/ttyACM0 - Arduino Due Native USB port)')
+    parser.add_argument('--device', '-d', type=str, required=True,
+                        help='Device name(s), comma-separated, or "all"')
+    parser.add_argument('--sizes', type=str, default='full,64x64,16x16',
+                        help='Image sizes: "full" (usable area) or WxH, comma-separated '
+                             '(default: full,64x64,16x16)')
+    parser.add_argument('--encodings', type=str, default=','.join(ENCODING_CHOICES),
+                        help=f'Host transfer encodings (default: {",".join(ENCODING_CHOICES)})')
+    parser.add_argument('--frames', type=int, default=10,
+                        help='Frames per measurement (default: 10)')
+    parser.add_argument('--image', type=str,
+                        help='Use this picture (fitted to each size) instead of the synthetic image')
+    parser.add_argument('--skip-device', action='store_true', help='Skip the CMD:BENCH kernels')
+    parser.add_argument('--skip-host', action='store_true', help='Skip the host transfers')
+    parser.add_argument('--json', type=str, help='Write results to this file')
+    parser.add_argument('--label', type=str, help='Free-form build label stored with the results')
+    parser.add_argument('--baseline', type=str, help='Compare against an earlier --json file')
+    parser.add_argument('--tolerance', type=float, default=10.0,
+                        help='Allowed slowdown against --baseline in percent (default: 10)')
+    parser.add_argument('--verbose', '-v', action='store_true', help='Echo firmware output')
+    args = parser.parse_args()
+
+    if args.device.lower() == 'all':
+        names = sorted(find_config_files().keys())
+    else:
+        names = [name.strip() for name in args.device.split(',') if name.strip()]
+    configs = []
+    for name in names:
+        config = get_config_by_device_name(name)
+        if not config:
+            print(f"Error: No configuration found for device '{name}'")
+            return 1
+        configs.append(config)
+    encodings = [name.strip() for name in args.encodings.split(',') if name.strip()]
+    for name in encodings:
+        if name not in ENCODING_CHOICES:
+            print(f"Error: Unknown encoding '{name}' (choose from {', '.join(ENCODING_CHOICES)})")
+            return 1
+    sizes = [size.strip() for size in args.sizes.split(',') if size.strip()]
+
+    results = {
+        'schema': RESULT_SCHEMA,
+        'timestamp': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'revision': git_revision(),
+        'label': args.label,
+        'machine': platform.node(),
+        'port': args.serial_port,
+        'frames': args.frames,
+        'device': [],
+        'host_transfers': [],
+    }
+
+    try:
+        print(f"Connecting to Arduino Due on {args.serial_port}...")
+        connection = serial.Serial(args.serial_port, SERIAL_BAUDRATE, timeout=0.5,
+                                   write_timeout=TIMEOUT_SECONDS)
+    except serial.SerialException as e:
+        print(f"Error connecting to serial port: {e}")
+        return 1
+
+    try:
+        time.sleep(STARTUP_SECONDS)
+        connection.reset_input_buffer()
+        bench = Benchmark(connection, verbose=args.verbose)
+
+        for config in configs:
+            index = binary_protocol.resolve_display_index(connection, config.name)
+            if index is None:
+                print(f"Error: Display {config.name} not registered on Arduino")
+                return 1
+
+            for size_text in sizes:
+                width, height = parse_size(size_text, config)
+                if not args.skip_device:
+                    size = None if size_text == 'full' else (width, height)
+                    for result in bench.device_kernels(config.name, args.frames, size):
+                        results['device'].append(result)
+                        print(f"device {result['kernel']:<7} {config.name} {width}x{height}: "
+                              f"{result['avg_us']} us/frame (min {result['min_us']}, max {result['max_us']})")
+                if args.skip_host:
+                    continue
+                for encoding_name in encodings:
+                    try:
+                        result = bench.host_transfer(config.name, index, encoding_name,
+                                                     width, height, args.frames, args.image)
+                    except (RuntimeError, ValueError) as e:
+                        print(f"host   {encoding_name:<7} {config.name} {width}x{height}: skipped ({e})")
+                        continue
+                    results['host_transfers'].append(result)
+                    print(f"host   {encoding_name:<7} {config.name} {width}x{height}: "
+                          f"{result['fps']} fps, first pixel {result['ttfp_ms']} ms, "
+                          f"{result['payload_bytes']} bytes ({result['throughput_kib_s']} KiB/s)")
+    except (TimeoutError, RuntimeError) as e:
+        print(f"Error: {e}")
+        return 1
+    except KeyboardInterrupt:
+        print("\nBenchmark cancelled by user")
+        return 1
+    finally:
+        connection.close()
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(results, f, indent=2)
+        print(f"Results written to {args.json}")
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(results, baseline, args.tolerance)
+        if regressions:
+            print(f"✗ {regressions} result(s) regressed by more than {args.tolerance:g}%")
+            return 1
+        print(f"✓ No regressions against {args.baseline} (tolerance {args.tolerance:g}%)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -17,6 +17,13 @@ Usage:
 Example:
     python3 bitmap_sender.py image.jpg /dev/ttyACM1
     python3 bitmap_sender.py --gui --device DueLCD01
+    python3 bitmap_sender.py --binary --device DueLCD01 image.jpg
+    python3 bitmap_sender.py --device DueLCD01,DueLCD02 image.jpg
+    python3 bitmap_sender.py --diff --device DueLCD01 dashboard.png
+    python3 bitmap_sender.py --encoding auto --device DueLCD01 ui.png
+    python3 bitmap_sender.py --encoding idx4 --device DueLCD01 icon.png
+    python3 bitmap_sender.py --stream --fps 15 --device DueLCD01 anim.gif
+    python3 bitmap_sender.py --encoding rgb888 --dither fs --device DueLCD01 photo.jpg
 """
 
 import sys
@@ -32,6 +39,9 @@ import json
 # Import config loader from st7735_tools
 try:
     from st7735_tools.config_loader import load_display_config, find_config_files, get_config_by_device_name
+    from st7735_tools import binary_protocol
+    from st7735_tools.dirty_rects import find_dirty_rects, extract_rect, bounding_rect
+    from st7735_tools import pixel_codec
 except ImportError:
     print("Error: st7735_tools module not found. Make sure config_loader.py exists.")
     sys.exit(1)
@@ -43,11 +53,35 @@ SERIAL_BAUDRATE = 115200
 TIMEOUT_SECONDS = 10
 
 # GUI settings file
+# Pixel encodings selectable with --encoding ('auto' picks the smallest)
+ENCODING_CHOICES = {
+    'raw': binary_protocol.ENC_RGB565,
+    'rle': binary_protocol.ENC_RLE,
+    'qoi': binary_protocol.ENC_QOI,
+    'idx1': binary_protocol.ENC_INDEXED1,
+    'idx2': binary_protocol.ENC_INDEXED2,
+    'idx4': binary_protocol.ENC_INDEXED4,
+    'idx8': binary_protocol.ENC_INDEXED8,
+    'rgb888': binary_protocol.ENC_RGB888,
+    'auto': None,
+}
+
+# Device-side dithering for --encoding rgb888
+DITHER_CHOICES = {
+    'none': 0,
+    'ordered': binary_protocol.ENC_DITHER_ORDERED,
+    'fs': binary_protocol.ENC_DITHER_DIFFUSE,
+}
+
+# Cache id an --atlas file is stored under before --text uses it
+TEXT_ATLAS_CACHE_ID = 250
+
 SETTINGS_FILE = Path.home() / '.st7735_bitmap_sender.json'
 DEFAULT_IMAGE_DIR = Path.home() / 'Pictures'
 
 class BitmapSender:
-    def __init__(self, serial_port='/dev/ttyACM0', baudrate=SERIAL_BAUDRATE, display_config=None):
+    def __init__(self, serial_port='/dev/ttyACM0', baudrate=SERIAL_BAUDRATE, display_config=None,
+                 extra_configs=None, encoding='raw', dither='none', fit=False):
         """
         Initialize the bitmap sender
         
@@ -55,14 +89,34 @@ class BitmapSender:
             serial_port (str): Serial port path (e.g., '/dev/ttyACM0')
             baudrate (int): Serial communication baud rate
             display_config: DisplayConfig object (optional, uses defaults if None)
+            extra_configs: Additional DisplayConfig objects to broadcast the same
+                           image to (one transfer, centred on every display)
+            encoding (str): Pixel encoding, one of ENCODING_CHOICES
+            dither (str): Firmware dithering for 'rgb888', one of DITHER_CHOICES
+            fit (bool): Send one landscape asset for the largest display; the
+                        firmware turns and scales it to each panel (CMD:FIT_ON)
         """
         self.serial_port = serial_port
         self.baudrate = baudrate
         self.connection = None
         self.display_config = display_config
+        self.display_configs = [display_config] + list(extra_configs or []) if display_config else []
+        self.encoding = encoding
+        self.dither = dither
+        self.fit = fit
         
         # Set display dimensions from config or use defaults
-        if display_config:
+        if fit and self.display_configs:
+            # Canonical asset: the largest usable area, landscape
+            self.display_width = max(max(cfg.usable_width, cfg.usable_height) for cfg in self.display_configs)
+            self.display_height = max(min(cfg.usable_width, cfg.usable_height) for cfg in self.display_configs)
+            print(f"Fitting on device: {self.display_names} ({self.display_width}x{self.display_height} asset)")
+        elif len(self.display_configs) > 1:
+            # Broadcast: the image must fit the smallest usable area
+            self.display_width = min(cfg.usable_width for cfg in self.display_configs)
+            self.display_height = min(cfg.usable_height for cfg in self.display_configs)
+            print(f"Using configs: {self.display_names} ({self.display_width}x{self.display_height})")
+        elif display_config:
             self.display_width = display_config.usable_width
             self.display_height = display_config.usable_height
             print(f"Using config: {display_config.name} ({display_config.usable_width}x{display_config.usable_height})")
@@ -71,6 +125,53 @@ class BitmapSender:
             self.display_height = DISPLAY_HEIGHT
             print(f"Using default dimensions: {self.display_width}x{self.display_height}")
         
+    @property
+    def display_names(self):
+        """Target display names as used by the DISPLAY: command (comma-separated)"""
+        return ','.join(cfg.name for cfg in self.display_configs)
+    
+    def encode_pixels(self, pixel_data):
+        """
+        Encode packed pixels with the selected encoding
+        
+        Returns:
+            tuple: (encoding id, payload bytes)
+        """
+        encoding = ENCODING_CHOICES[self.encoding]
+        if encoding == binary_protocol.ENC_RGB565:
+            return encoding, b''.join(pixel_data)
+        if encoding == binary_protocol.ENC_RGB888:
+            # prepare_image() kept the RGB bytes; the firmware converts them
+            return encoding | DITHER_CHOICES[self.dither], b''.join(pixel_data)
+        pixels = pixel_codec.unpack_pixels(pixel_data)
+        if encoding is None:
+            return pixel_codec.best_encoding(pixels)
+        try:
+            return pixel_codec.encode(pixels, encoding)
+        except ValueError as e:
+            print(f"Warning: {e}, sending raw RGB565")
+            return binary_protocol.ENC_RGB565, b''.join(pixel_data)
+    
+    def raw_payload(self, pixel_data):
+        """Raw RGB565 payload of prepared pixels (fallback when an encoding is refused)"""
+        if ENCODING_CHOICES[self.encoding] == binary_protocol.ENC_RGB888:
+            pixel_data = pixel_codec.rgb888_to_rgb565(pixel_data)
+        return b''.join(pixel_data)
+    
+    def size_command(self, width, height, encoding, payload, origin=None):
+        """SIZE line, with the encoding options for compressed payloads and credit flow control"""
+        command = f"SIZE:{width},{height}"
+        if origin is not None:
+            command += f",{origin[0]},{origin[1]}"
+        if encoding != binary_protocol.ENC_RGB565:
+            command += f";ENC={pixel_codec.encoding_name(encoding)}"
+            if pixel_codec.has_palette(encoding):
+                command += ";PAL"
+            if pixel_codec.dither_name(encoding):
+                command += f";DITHER={pixel_codec.dither_name(encoding)}"
+            command += f";LEN={len(payload)}"
+        return command + ";CREDIT\n"
+    
     def connect(self):
         """Establish serial connection to Arduino Due"""
         try:
@@ -164,21 +265,26 @@ class BitmapSender:
         rgb565 = (r5 << 11) | (g6 << 5) | b5
         return rgb565
     
-    def prepare_image(self, image_path):
+    def prepare_image(self, image_path, frame=0):
         """
         Load and prepare image for display
         
         Args:
             image_path (str): Path to image file
+            frame (int): Frame index for animated images (GIF, APNG)
             
         Returns:
-            tuple: (width, height, pixel_data) or None if error
+            tuple: (width, height, pixel_data) or None if error. pixel_data holds
+            packed big-endian RGB565 pixels, or 3-byte RGB pixels with
+            --encoding rgb888 (converted on the device instead)
         """
         try:
-            print(f"Loading image: {image_path}")
+            print(f"Loading image: {image_path}" + (f" (frame {frame})" if frame else ""))
             
             # Open and convert image
             with Image.open(image_path) as img:
+                if frame:
+                    img.seek(frame)
                 print(f"Original image size: {img.size}")
                 print(f"Original image mode: {img.mode}")
                 
@@ -238,6 +344,13 @@ class BitmapSender:
                     new_width, new_height = img_resized.size
                     print(f"Final cropped size: {new_width}x{new_height}")
                 
+                if ENCODING_CHOICES[self.encoding] == binary_protocol.ENC_RGB888:
+                    # No per-pixel work on the host: the firmware converts (and dithers)
+                    rgb = img_resized.tobytes()
+                    pixel_data = [rgb[i:i + 3] for i in range(0, len(rgb), 3)]
+                    print(f"Prepared {len(pixel_data)} RGB888 pixels")
+                    return new_width, new_height, pixel_data
+                
                 # Convert to RGB565 pixel data
                 print("Converting to RGB565 format...")
                 pixel_data = []
@@ -281,10 +394,19 @@ class BitmapSender:
         try:
             print("\n=== Starting bitmap transmission ===")
             
+            # Centred images are turned/scaled per display from here on
+            if self.fit:
+                self.connection.write(b"CMD:FIT_ON\n")
+                self.connection.flush()
+                response = self.wait_for_response("OK:Fit", timeout=3)
+                if not response or "OK:Fit" not in response:
+                    print("Error: Firmware does not support on-device fitting")
+                    return False
+            
             # Step 0: Select target display (v3.0 protocol)
             if self.display_config:
-                print(f"Selecting display: {self.display_config.name}...")
-                display_command = f"DISPLAY:{self.display_config.name}\n"
+                print(f"Selecting display: {self.display_names}...")
+                display_command = f"DISPLAY:{self.display_names}\n"
                 self.connection.write(display_command.encode('utf-8'))
                 self.connection.flush()
                 
@@ -296,16 +418,17 @@ class BitmapSender:
                     else:
                         print("Error: Arduino did not confirm display selection")
                     return False
-                print(f"✓ Display {self.display_config.name} selected")
+                print(f"✓ Display {self.display_names} selected")
             
             # Step 1: Send start marker
             print("Sending start marker...")
             self.connection.write(b"BMPStart\n")
             self.connection.flush()
             
-            # Step 2: Send dimensions
+            # Step 2: Send dimensions (and encoding, negotiated by the READY reply)
+            encoding, payload = self.encode_pixels(pixel_data)
             print(f"Sending dimensions: {width}x{height}")
-            size_command = f"SIZE:{width},{height}\n"
+            size_command = self.size_command(width, height, encoding, payload)
             self.connection.write(size_command.encode('utf-8'))
             self.connection.flush()
             
@@ -315,54 +438,415 @@ class BitmapSender:
                 print("Error: Arduino did not confirm ready state")
                 return False
             
-            # Give Arduino a moment to prepare for data reception
-            time.sleep(0.1)
+            # Step 3: Send pixel data, streamed against the firmware's credit window
+            if encoding != binary_protocol.ENC_RGB565 and not response.startswith("READY:"):
+                print("Firmware did not accept encoding, sending raw RGB565")
+                encoding, payload = binary_protocol.ENC_RGB565, self.raw_payload(pixel_data)
+            print(f"Sending {len(payload)} bytes ({pixel_codec.encoding_name(encoding)}, "
+                  f"{len(payload) / (len(pixel_data) * 2) * 100:.1f}% of raw)...")
+            self.stream_payload(payload)
+            return self._finish_bitmap()
+                
+        except Exception as e:
+            print(f"Error during transmission: {e}")
+            return False
+    
+    def stream_payload(self, payload):
+        """Write a text transfer's pixel data as fast as the firmware's credits allow"""
+        link = binary_protocol.BinaryFrameLink(self.connection, ack_timeout=TIMEOUT_SECONDS,
+                                               on_text=lambda line: print(f"Arduino: {line}"))
+        start_time = time.time()
+        link.stream_payload(payload)
+        elapsed = max(time.time() - start_time, 1e-6)
+        print(f"Pixel data sent: {len(payload)} bytes in {elapsed:.3f}s "
+              f"({len(payload) / elapsed / 1024:.1f} KiB/s)")
+    
+    def _finish_bitmap(self):
+        """Send the end marker and wait for COMPLETE"""
+        print("Sending end marker...")
+        self.connection.write(b"BMPEnd\n")
+        self.connection.flush()
+        
+        # Wait for completion confirmation
+        response = self.wait_for_response("COMPLETE", timeout=10)
+        if response and "COMPLETE" in response:
+            print("✓ Bitmap transmission completed successfully!")
+            return True
+        else:
+            print("Warning: Did not receive completion confirmation")
+            return True  # Still consider it successful
+    
+    def send_bitmap_binary(self, image_path):
+        """
+        Send bitmap using the binary framed protocol (single frame, no text handshake)
+        
+        Args:
+            image_path (str): Path to image file
+            
+        Returns:
+            bool: True if the firmware acknowledged the frame, False otherwise
+        """
+        if not self.connection or not self.connection.is_open:
+            print("Error: Not connected to Arduino")
+            return False
+        
+        image_data = self.prepare_image(image_path)
+        if not image_data:
+            return False
+        
+        width, height, pixel_data = image_data
+        
+        try:
+            print("\n=== Starting binary bitmap transmission ===")
+            
+            target = self.binary_display_target()
+            if target is None:
+                return False
+            display_id, flags = target
+            flags |= binary_protocol.FLAG_CENTER | binary_protocol.FLAG_CLEAR | binary_protocol.FLAG_CREDIT
+            if self.fit:
+                flags |= binary_protocol.FLAG_FIT
             
-            # Step 3: Send pixel data
-            print(f"Sending {len(pixel_data)} pixels...")
-            bytes_sent = 0
+            link = binary_protocol.BinaryFrameLink(self.connection, ack_timeout=TIMEOUT_SECONDS,
+                                                   on_text=lambda line: print(f"Arduino: {line}"))
             
-            # Send pixels in smaller chunks to prevent buffer overflow
-            chunk_size = 50  # Send 50 pixels at a time
-            for chunk_start in range(0, len(pixel_data), chunk_size):
-                chunk_end = min(chunk_start + chunk_size, len(pixel_data))
-                
-                # Send chunk of pixels
-                for i in range(chunk_start, chunk_end):
-                    self.connection.write(pixel_data[i])
-                    bytes_sent += 2
-                
-                # Flush after each chunk
-                self.connection.flush()
-                
-                # Progress indication
-                if (chunk_end) % 1000 == 0 or chunk_end == len(pixel_data):
-                    progress = chunk_end / len(pixel_data) * 100
-                    print(f"Progress: {progress:.1f}% ({chunk_end}/{len(pixel_data)} pixels, {bytes_sent} bytes)")
-                
-                # Small delay between chunks to allow Arduino to process
-                time.sleep(0.01)
+            encoding, payload = self.encode_pixels(pixel_data)
+            start_time = time.time()
+            ack = link.blit(payload, width, height, display_id=display_id, flags=flags, encoding=encoding)
+            elapsed = time.time() - start_time
             
-            print(f"Pixel data sent: {bytes_sent} bytes")
+            if not ack.ok:
+                print(f"Error: Frame rejected ({ack.status_name})")
+                return False
             
-            # Step 4: Send end marker
-            print("Sending end marker...")
-            self.connection.write(b"BMPEnd\n")
-            self.connection.flush()
+            print(f"✓ {ack.value} pixels written in {elapsed:.3f}s "
+                  f"({len(payload) / elapsed / 1024:.1f} KiB/s, "
+                  f"{pixel_codec.encoding_name(encoding)} {len(payload)} bytes)")
+            return True
             
-            # Wait for completion confirmation
-            response = self.wait_for_response("COMPLETE", timeout=10)
-            if response and "COMPLETE" in response:
-                print("✓ Bitmap transmission completed successfully!")
-                return True
-            else:
-                print("Warning: Did not receive completion confirmation")
-                return True  # Still consider it successful
-                
+        except TimeoutError as e:
+            print(f"Error: {e}")
+            return False
         except Exception as e:
             print(f"Error during transmission: {e}")
             return False
     
+    def send_text(self, text, x=0, y=0, foreground=0xFFFF, background=None, scale=1, atlas_path=None):
+        """
+        Draw a line of text on the device instead of uploading its pixels
+        
+        Args:
+            text (str): Up to 128 characters
+            x, y (int): Display position of the text box's top-left corner
+            foreground, background (int): RGB565 colours; background None = transparent
+            scale (int): Integer magnification (1-8)
+            atlas_path (str): Glyph atlas file (glyph_atlas.py -o) stored first, or None
+                for the built-in 5x7 font
+            
+        Returns:
+            bool: True if the firmware drew the text
+        """
+        target = self.binary_display_target()
+        if target is None:
+            return False
+        display_id, flags = target
+        
+        link = binary_protocol.BinaryFrameLink(self.connection, ack_timeout=TIMEOUT_SECONDS,
+                                               on_text=lambda line: print(f"Arduino: {line}"))
+        atlas = binary_protocol.BUILTIN_ATLAS
+        if atlas_path:
+            with open(atlas_path, 'rb') as f:
+                ack = link.atlas_store(TEXT_ATLAS_CACHE_ID, f.read())
+            if not ack.ok:
+                print(f"Error: Atlas rejected ({ack.status_name})")
+                return False
+            atlas = TEXT_ATLAS_CACHE_ID
+        
+        ack = link.text(text, x=x, y=y, foreground=foreground, background=background, scale=scale,
+                        atlas=atlas, display_id=display_id, flags=flags)
+        if not ack.ok:
+            print(f"Error: Text rejected ({ack.status_name})")
+            return False
+        print(f"✓ Text drawn at {x},{y} ({ack.value >> 16}x{ack.value & 0xFFFF} pixels)")
+        return True
+    
+    def store_tiles(self, image_path, tile_width, tile_height, first_id=0):
+        """
+        Cut a sprite sheet into tiles and store each one in the image cache
+        
+        Tiles are numbered row by row from first_id and kept as raw RGB565,
+        which is what OP_TILES / CMD:TILES composite in place.
+        
+        Returns:
+            int: Number of tiles stored, or 0 on error
+        """
+        sheet = Image.open(image_path).convert('RGB')
+        columns, rows = sheet.width // tile_width, sheet.height // tile_height
+        count = columns * rows
+        if not 0 < count <= binary_protocol.MAX_CACHE_ID + 1 - first_id:
+            print(f"Error: {columns}x{rows} tiles do not fit cache ids {first_id}-{binary_protocol.MAX_CACHE_ID}")
+            return 0
+        
+        link = binary_protocol.BinaryFrameLink(self.connection, ack_timeout=TIMEOUT_SECONDS,
+                                               on_text=lambda line: print(f"Arduino: {line}"))
+        for index in range(count):
+            left, top = (index % columns) * tile_width, (index // columns) * tile_height
+            tile = sheet.crop((left, top, left + tile_width, top + tile_height))
+            payload = b''.join(struct.pack('>H', self.rgb888_to_rgb565(*pixel)) for pixel in tile.getdata())
+            ack = link.cache_store(first_id + index, payload, tile_width, tile_height)
+            if not ack.ok:
+                print(f"Error: Tile {first_id + index} rejected ({ack.status_name})")
+                return 0
+        print(f"✓ Stored {count} {tile_width}x{tile_height} tiles as ids {first_id}-{first_id + count - 1}")
+        return count
+    
+    def send_tiles(self, draws, x=0, y=0):
+        """
+        Composite cached tiles from a list of (cache id, x, y) placements
+        
+        Returns:
+            bool: True if the firmware drew every tile
+        """
+        target = self.binary_display_target()
+        if target is None:
+            return False
+        display_id, flags = target
+        
+        link = binary_protocol.BinaryFrameLink(self.connection, ack_timeout=TIMEOUT_SECONDS,
+                                               on_text=lambda line: print(f"Arduino: {line}"))
+        for start in range(0, len(draws), binary_protocol.MAX_TILE_DRAWS):
+            chunk = draws[start:start + binary_protocol.MAX_TILE_DRAWS]
+            ack = link.tiles(chunk, x=x, y=y, display_id=display_id, flags=flags)
+            if not ack.ok:
+                print(f"Error: Tiles rejected ({ack.status_name}, id {ack.value})")
+                return False
+            print(f"✓ {len(chunk)} tiles drawn in {ack.value} windows")
+        return True
+    
+    def binary_display_target(self):
+        """
+        Header display id and flags addressing the configured displays
+        
+        Returns:
+            tuple: (display_id, flags) or None if a display is not registered
+        """
+        if not self.display_configs:
+            return binary_protocol.ACTIVE_DISPLAY, 0
+        
+        # Address displays by bitmask so a broadcast is still one frame
+        display_id = 0
+        for cfg in self.display_configs:
+            index = binary_protocol.resolve_display_index(self.connection, cfg.name)
+            if index is None:
+                print(f"Error: Display {cfg.name} not registered on Arduino")
+                return None
+            print(f"✓ Display {cfg.name} is index {index}")
+            display_id |= 1 << index
+        return display_id, binary_protocol.FLAG_DISPLAY_MASK
+    
+    def send_animation(self, image_path, fps=0, drop_late=False):
+        """
+        Play an animated image (or a still, as one frame) in binary stream mode
+        
+        Frames are prepared up front, the stream is opened once (centred and
+        cleared) and every later frame only sends the bounding box of the
+        pixels that changed. With fps the firmware paces the frames through
+        its acks and, with drop_late, skips frames that fall behind.
+        
+        Args:
+            image_path (str): GIF, APNG or any image Pillow can open
+            fps (int): Target frame rate (0 = as fast as the link allows)
+            drop_late (bool): Let the firmware drop late frames to keep up
+            
+        Returns:
+            bool: True if the whole animation was streamed
+        """
+        if not self.connection or not self.connection.is_open:
+            print("Error: Not connected to Arduino")
+            return False
+        
+        with Image.open(image_path) as img:
+            frame_count = getattr(img, 'n_frames', 1)
+        frames = []
+        for index in range(frame_count):
+            image_data = self.prepare_image(image_path, frame=index)
+            if not image_data:
+                return False
+            frames.append(image_data)
+        width, height = frames[0][:2]
+        if any(frame[:2] != (width, height) for frame in frames):
+            print("Error: Animation frames differ in size")
+            return False
+        
+        # One encoding for the whole stream ('auto' -> QOI, the usual winner on animations)
+        encoding = ENCODING_CHOICES[self.encoding]
+        if encoding is None:
+            encoding = binary_protocol.ENC_QOI
+        if encoding in pixel_codec.INDEX_BITS:
+            encoding |= binary_protocol.ENC_PALETTE
+        elif encoding == binary_protocol.ENC_RGB888:
+            encoding |= DITHER_CHOICES[self.dither]
+        
+        target = self.binary_display_target()
+        if target is None:
+            return False
+        display_id, flags = target
+        
+        try:
+            link = binary_protocol.BinaryFrameLink(self.connection, ack_timeout=TIMEOUT_SECONDS,
+                                                   on_text=lambda line: print(f"Arduino: {line}"))
+            ack = link.stream_begin(width, height, fps=fps, drop_late=drop_late, display_id=display_id,
+                                    flags=flags | binary_protocol.FLAG_CENTER | binary_protocol.FLAG_CLEAR,
+                                    encoding=encoding)
+            if not ack.ok:
+                print(f"Error: Stream rejected ({ack.status_name})")
+                return False
+            
+            print(f"\n=== Streaming {frame_count} frame(s) {width}x{height} "
+                  f"{pixel_codec.encoding_name(encoding)} at {fps or 'max'} FPS ===")
+            previous = None
+            drawn = dropped = sent_bytes = 0
+            start_time = time.time()
+            for _, _, pixel_data in frames:
+                rects = find_dirty_rects(previous, pixel_data, width, height)
+                previous = pixel_data
+                if not rects:
+                    continue
+                rect = bounding_rect(rects)
+                region = extract_rect(pixel_data, width, rect)
+                if pixel_codec.is_true_color(encoding):
+                    payload = b''.join(region)
+                else:
+                    _, payload = pixel_codec.encode(pixel_codec.unpack_pixels(region),
+                                                    encoding & ~binary_protocol.ENC_PALETTE)
+                if rect == (0, 0, width, height):
+                    ack = link.stream_frame(payload)
+                else:
+                    ack = link.stream_frame(payload, *rect)
+                if ack.status == binary_protocol.STATUS_DROPPED:
+                    dropped += 1
+                elif not ack.ok:
+                    print(f"Error: Frame rejected ({ack.status_name})")
+                    return False
+                else:
+                    drawn += 1
+                sent_bytes += len(payload)
+            elapsed = time.time() - start_time
+            
+            ack = link.stream_end()
+            print(f"✓ {drawn} frame(s) drawn, {dropped} dropped in {elapsed:.2f}s "
+                  f"({drawn / elapsed if elapsed > 0 else 0:.1f} FPS, {sent_bytes} bytes)")
+            return ack.ok
+            
+        except ValueError as e:
+            print(f"Error: {e}")
+            return False
+        except TimeoutError as e:
+            print(f"Error: {e}")
+            return False
+    
+    def send_region(self, x, y, width, height, pixel_data, binary=False):
+        """
+        Write one window at display coordinates (x, y) without clearing the screen
+        
+        Args:
+            x, y (int): Display position of the window's top-left pixel
+            width, height (int): Window size in pixels
+            pixel_data (list): Packed big-endian RGB565 pixels, row-major
+            binary (bool): Send as a binary BLIT frame instead of the text handshake
+            
+        Returns:
+            bool: True if the firmware accepted the window
+        """
+        encoding, payload = self.encode_pixels(pixel_data)
+        if binary:
+            link = binary_protocol.BinaryFrameLink(self.connection, ack_timeout=TIMEOUT_SECONDS)
+            ack = link.blit(payload, width, height, x=x, y=y, encoding=encoding,
+                            flags=binary_protocol.FLAG_CREDIT)
+            if not ack.ok:
+                print(f"Error: Region rejected ({ack.status_name})")
+            return ack.ok
+        
+        self.connection.write(b"BMPStart\n")
+        self.connection.write(self.size_command(width, height, encoding, payload, origin=(x, y)).encode('utf-8'))
+        self.connection.flush()
+        response = self.wait_for_response("READY", timeout=5)
+        if not response or "READY" not in response:
+            print("Error: Arduino did not accept region")
+            return False
+        
+        if encoding != binary_protocol.ENC_RGB565 and not response.startswith("READY:"):
+            payload = self.raw_payload(pixel_data)
+        binary_protocol.BinaryFrameLink(self.connection, ack_timeout=TIMEOUT_SECONDS).stream_payload(payload)
+        self.connection.write(b"BMPEnd\n")
+        self.connection.flush()
+        response = self.wait_for_response("COMPLETE", timeout=5)
+        return bool(response and "COMPLETE" in response)
+    
+    def send_bitmap_diff(self, image_path, interval=1.0, binary=False):
+        """
+        Watch image_path and send only the rectangles that changed
+        
+        The first frame is sent in full; afterwards every modification of the
+        file is diffed against the last frame sent and the dirty rectangles are
+        written in place (SIZE:w,h,x,y or binary BLIT at x/y). Runs until
+        interrupted.
+        
+        Args:
+            image_path (str): Image file rewritten by e.g. a dashboard renderer
+            interval (float): Polling interval in seconds
+            binary (bool): Use binary frames for both full and partial updates
+            
+        Returns:
+            bool: False if a transfer failed
+        """
+        if len(self.display_configs) != 1:
+            print("Error: --diff needs exactly one display (--device or --config)")
+            return False
+        cfg = self.display_config
+        
+        previous = None
+        last_mtime = None
+        print(f"Watching {image_path} (Ctrl+C to stop)")
+        while True:
+            mtime = os.path.getmtime(image_path)
+            if mtime == last_mtime:
+                time.sleep(interval)
+                continue
+            last_mtime = mtime
+            
+            image_data = self.prepare_image(image_path)
+            if not image_data:
+                time.sleep(interval)
+                continue
+            width, height, pixel_data = image_data
+            
+            if previous is None or previous[:2] != (width, height):
+                # Full frame: centred (and cleared) exactly like a normal send
+                sent = self.send_bitmap_binary(image_path) if binary else self.send_bitmap(image_path)
+                if not sent:
+                    return False
+                previous = image_data
+                continue
+            
+            # Same centring as SerialProtocol::calculateOffsets
+            origin_x = cfg.calibration['left'] + cfg.usable_width // 2 - width // 2
+            origin_y = cfg.calibration['top'] + cfg.usable_height // 2 - height // 2
+            
+            rects = find_dirty_rects(previous[2], pixel_data, width, height)
+            sent_bytes = 0
+            for rect in rects:
+                rx, ry, rw, rh = rect
+                region = extract_rect(pixel_data, width, rect)
+                if not self.send_region(origin_x + rx, origin_y + ry, rw, rh, region, binary=binary):
+                    return False
+                sent_bytes += len(region) * 2
+            
+            full_bytes = width * height * 2
+            print(f"✓ {len(rects)} region(s), {sent_bytes} of {full_bytes} bytes "
+                  f"({sent_bytes / full_bytes * 100:.1f}%)")
+            previous = image_data
+    
     def send_test_pattern(self):
         """Send a test pattern to verify connection"""
         print("Sending test pattern...")
@@ -384,8 +868,8 @@ class BitmapSender:
         try:
             # Step 0: Select target display (v3.0 protocol)
             if self.display_config:
-                print(f"Selecting display: {self.display_config.name}...")
-                display_command = f"DISPLAY:{self.display_config.name}\n"
+                print(f"Selecting display: {self.display_names}...")
+                display_command = f"DISPLAY:{self.display_names}\n"
                 self.connection.write(display_command.encode('utf-8'))
                 self.connection.flush()
                 
@@ -394,7 +878,7 @@ class BitmapSender:
                 if not response or "DISPLAY_READY" not in response:
                     print("Error: Arduino did not confirm display selection")
                     return False
-                print(f"✓ Display {self.display_config.name} selected")
+                print(f"✓ Display {self.display_names} selected")
             
             # Send start marker
             self.connection.write(b"BMPStart\n")
@@ -528,6 +1012,17 @@ Examples:
   python3 bitmap_sender.py --config DueLCD02.config photo.png
   python3 bitmap_sender.py --test-pattern /dev/ttyUSB0
   python3 bitmap_sender.py --list-configs
+  python3 bitmap_sender.py --binary --device DueLCD01 image.jpg
+  python3 bitmap_sender.py --device DueLCD01,DueLCD02 image.jpg   # Broadcast to both
+  python3 bitmap_sender.py --diff --device DueLCD01 dash.png      # Send changed regions only
+  python3 bitmap_sender.py --encoding auto --device DueLCD01 ui.png # Compress pixel data
+  python3 bitmap_sender.py --encoding idx4 --device DueLCD01 icon.png # 16-colour palette
+  python3 bitmap_sender.py --stream --fps 15 --device DueLCD01 anim.gif # Paced animation
+  python3 bitmap_sender.py -e rgb888 --dither fs --device DueLCD01 photo.jpg # Convert on device
+  python3 bitmap_sender.py --fit --device all photo.jpg        # One asset, fitted per panel
+  python3 bitmap_sender.py --text "21.5 C" --at 10,20 --bg 0 --device DueLCD01 # On-device text
+  python3 bitmap_sender.py --tile-sheet 16x16 --device DueLCD01 icons.png  # Cache tiles 0..n
+  python3 bitmap_sender.py --tiles "0,0,0;1,16,0;5,0,16" --device DueLCD01  # Draw cached tiles
         """
     )
     
@@ -541,11 +1036,47 @@ Examples:
     parser.add_argument('--list-ports', action='store_true',
                        help='List available serial ports')
     parser.add_argument('--device', '-d', type=str,
-                       help='Device name (e.g., DueLCD01). Auto-loads config file.')
+                       help='Device name (e.g., DueLCD01). Auto-loads config file. '
+                            'Comma-separate names (DueLCD01,DueLCD02) or use "all" to broadcast.')
     parser.add_argument('--config', '-c', type=str,
                        help='Path to device config file (e.g., DueLCD01.config)')
     parser.add_argument('--list-configs', action='store_true',
                        help='List available device configurations')
+    parser.add_argument('--binary', action='store_true',
+                       help='Use the binary framed protocol instead of the text handshake')
+    parser.add_argument('--encoding', '-e', choices=list(ENCODING_CHOICES), default='raw',
+                       help='Pixel encoding: raw RGB565, rle, qoi, idx1-idx8 (palette), '
+                            'rgb888 (converted by the firmware) or auto (smallest) (default: raw)')
+    parser.add_argument('--dither', choices=list(DITHER_CHOICES), default='none',
+                       help='Firmware dithering for --encoding rgb888 (default: none)')
+    parser.add_argument('--diff', action='store_true',
+                       help='Watch the image file and send only changed rectangles')
+    parser.add_argument('--interval', type=float, default=1.0,
+                       help='Polling interval in seconds for --diff (default: 1.0)')
+    parser.add_argument('--stream', action='store_true',
+                       help='Play an animated image (GIF/APNG) in binary stream mode')
+    parser.add_argument('--fps', type=int, default=0,
+                       help='Target frame rate for --stream (default: 0 = unpaced)')
+    parser.add_argument('--drop-late', action='store_true',
+                       help='Let the firmware drop --stream frames that fall behind the target rate')
+    parser.add_argument('--fit', action='store_true',
+                       help='Send one landscape asset and let the firmware turn and scale it per display')
+    parser.add_argument('--text', type=str,
+                       help='Draw this text on the device (binary OP_TEXT) instead of sending an image')
+    parser.add_argument('--at', type=str, default='0,0',
+                       help='Display position x,y of the --text box (default: 0,0)')
+    parser.add_argument('--fg', type=lambda v: int(v, 0), default=0xFFFF,
+                       help='--text colour, RGB565 (default: 0xFFFF)')
+    parser.add_argument('--bg', type=lambda v: int(v, 0), default=None,
+                       help='--text background, RGB565 (default: transparent)')
+    parser.add_argument('--text-scale', type=int, default=1,
+                       help='--text magnification 1-8 (default: 1)')
+    parser.add_argument('--tile-sheet', type=str, metavar='WxH',
+                       help='Cut the image into WxH tiles and store them in the image cache (ids from 0)')
+    parser.add_argument('--tiles', type=str, metavar='ID,X,Y;...',
+                       help='Draw cached tiles at display positions (e.g. "0,0,0;1,16,0")')
+    parser.add_argument('--atlas', type=str,
+                       help='Glyph atlas file for --text (st7735_tools/glyph_atlas.py; default: built-in 5x7)')
     
     args = parser.parse_args()
     
@@ -575,6 +1106,7 @@ Examples:
     
     # Load display configuration
     display_config = None
+    extra_configs = []
     if args.config:
         # Load specific config file
         try:
@@ -584,13 +1116,25 @@ Examples:
             print(f"Error loading config file: {e}")
             return 1
     elif args.device:
-        # Load config by device name
-        print(f"Looking for device: {args.device}")
-        display_config = get_config_by_device_name(args.device)
-        if not display_config:
-            print(f"Error: No configuration found for device '{args.device}'")
-            print("Use --list-configs to see available devices")
+        # Load config(s) by device name
+        if args.device.lower() == 'all':
+            device_names = sorted(find_config_files().keys())
+        else:
+            device_names = [name.strip() for name in args.device.split(',') if name.strip()]
+        
+        configs = []
+        for device_name in device_names:
+            print(f"Looking for device: {device_name}")
+            config = get_config_by_device_name(device_name)
+            if not config:
+                print(f"Error: No configuration found for device '{device_name}'")
+                print("Use --list-configs to see available devices")
+                return 1
+            configs.append(config)
+        if not configs:
+            print("Error: No device configurations found")
             return 1
+        display_config, extra_configs = configs[0], configs[1:]
     
     # Handle GUI file picker
     if args.gui:
@@ -607,7 +1151,7 @@ Examples:
             return 0
     
     # Validate arguments
-    if not args.test_pattern and not args.image_file:
+    if not args.test_pattern and not args.image_file and args.text is None and args.tiles is None:
         print("Error: Please specify an image file, use --gui, or use --test-pattern")
         parser.print_help()
         return 1
@@ -617,7 +1161,8 @@ Examples:
         return 1
     
     # Create bitmap sender with optional display config
-    sender = BitmapSender(args.serial_port, display_config=display_config)
+    sender = BitmapSender(args.serial_port, display_config=display_config, extra_configs=extra_configs,
+                          encoding=args.encoding, dither=args.dither, fit=args.fit)
     
     try:
         # Connect to Arduino
@@ -625,8 +1170,24 @@ Examples:
             return 1
         
         # Send test pattern or image
-        if args.test_pattern:
+        if args.tile_sheet:
+            tile_width, tile_height = (int(v) for v in args.tile_sheet.lower().split('x'))
+            success = sender.store_tiles(args.image_file, tile_width, tile_height) > 0
+        elif args.tiles is not None:
+            draws = [tuple(int(v) for v in entry.split(',')) for entry in args.tiles.split(';') if entry]
+            success = sender.send_tiles(draws)
+        elif args.text is not None:
+            x, y = (int(v) for v in args.at.split(','))
+            success = sender.send_text(args.text, x, y, foreground=args.fg, background=args.bg,
+                                       scale=args.text_scale, atlas_path=args.atlas)
+        elif args.test_pattern:
             success = sender.send_test_pattern()
+        elif args.stream:
+            success = sender.send_animation(args.image_file, fps=args.fps, drop_late=args.drop_late)
+        elif args.diff:
+            success = sender.send_bitmap_diff(args.image_file, interval=args.interval, binary=args.binary)
+        elif args.binary:
+            success = sender.send_bitmap_binary(args.image_file)
         else:
             success = sender.send_bitmap(args.image_file)
         
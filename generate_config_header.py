@@ -9,6 +9,12 @@ from pathlib import Path
 from datetime import datetime
 import sys
 
+# Adafruit_ST77xx default SCK, used when a .config has no max_spi_hz
+DEFAULT_SPI_HZ = 32000000
+
+# DisplayConfig::te value of a panel without a wired TE (vsync) line
+PIN_NONE = 'DISPLAY_PIN_NONE'
+
 
 def parse_config(config_file):
     """Parse a single .config file"""
@@ -26,9 +32,11 @@ def parse_config(config_file):
         'model': device.get('model', 'Unknown'),
         'width': device['published_resolution'][0],
         'height': device['published_resolution'][1],
+        'spi_hz': device.get('max_spi_hz', DEFAULT_SPI_HZ),
         'orientation': cal.get('orientation', 'landscape'),
         'rotation': 1 if cal.get('orientation', 'landscape') == 'landscape' else 0,
         'pins': pinout,
+        'te': pinout.get('te', PIN_NONE),
         'left': cal['left'],
         'right': cal['right'],
         'top': cal['top'],
@@ -86,6 +94,10 @@ def generate_header(configs):
             f'#define {name_upper}_TFT_DC {cfg["pins"]["dc"]}',
             f'#define {name_upper}_TFT_RST {cfg["pins"]["rst"]}',
             f'#define {name_upper}_TFT_BL {cfg["pins"]["bl"]}',
+            f'#define {name_upper}_TFT_TE {cfg["te"]}',
+            '',
+            '// SPI Clock (maximum SCK in Hz)',
+            f'#define {name_upper}_SPI_FREQUENCY {cfg["spi_hz"]}UL',
             '',
             '// Display Dimensions',
             f'#define {name_upper}_DISPLAY_WIDTH {cfg["width"]}',
@@ -104,47 +116,48 @@ def generate_header(configs):
             '',
         ])
     
-    # Generate initialization function
+    # Generate constexpr descriptors (checked by the compiler, not at boot)
     lines.extend([
-        '// Display Registry Initialization',
-        'inline void initializeDisplayRegistry(DisplayManager& manager) {',
-        ''
+        '// Display Descriptors',
+        '// constexpr: folded into flash and validated at compile time',
     ])
-    
     for cfg in configs:
         name_upper = cfg['name'].upper()
         lines.extend([
-            f'    // Add {cfg["name"]}',
-            '    {',
-            '        DisplayConfig cfg;',
-            f'        cfg.name = {name_upper}_NAME;',
-            f'        cfg.manufacturer = {name_upper}_MANUFACTURER;',
-            f'        cfg.model = {name_upper}_MODEL;',
-            f'        cfg.cs = {name_upper}_TFT_CS;',
-            f'        cfg.dc = {name_upper}_TFT_DC;',
-            f'        cfg.rst = {name_upper}_TFT_RST;',
-            f'        cfg.bl = {name_upper}_TFT_BL;',
-            f'        cfg.width = {name_upper}_DISPLAY_WIDTH;',
-            f'        cfg.height = {name_upper}_DISPLAY_HEIGHT;',
-            f'        cfg.rotation = {name_upper}_DISPLAY_ROTATION;',
-            f'        cfg.usableX = {name_upper}_USABLE_ORIGIN_X;',
-            f'        cfg.usableY = {name_upper}_USABLE_ORIGIN_Y;',
-            f'        cfg.usableWidth = {name_upper}_USABLE_WIDTH;',
-            f'        cfg.usableHeight = {name_upper}_USABLE_HEIGHT;',
-            f'        cfg.centerX = {name_upper}_CENTER_X;',
-            f'        cfg.centerY = {name_upper}_CENTER_Y;',
-            '        manager.addDisplay(cfg);',
-            '    }',
-            ''
+            f'constexpr DisplayConfig {name_upper}_CONFIG = {{',
+            f'    {name_upper}_NAME, {name_upper}_MANUFACTURER, {name_upper}_MODEL,',
+            f'    {name_upper}_TFT_CS, {name_upper}_TFT_DC, {name_upper}_TFT_RST, {name_upper}_TFT_BL, '
+            f'{name_upper}_TFT_TE,',
+            f'    {name_upper}_DISPLAY_WIDTH, {name_upper}_DISPLAY_HEIGHT, {name_upper}_DISPLAY_ROTATION,',
+            f'    {name_upper}_USABLE_ORIGIN_X, {name_upper}_USABLE_ORIGIN_Y, '
+            f'{name_upper}_USABLE_WIDTH, {name_upper}_USABLE_HEIGHT,',
+            f'    {name_upper}_CENTER_X, {name_upper}_CENTER_Y,',
+            f'    {name_upper}_SPI_FREQUENCY',
+            '};',
+            f'static_assert(isValidDisplayConfig({name_upper}_CONFIG), '
+            f'"{cfg["name"]}: usable area or centre outside the panel, CS = DC, TE on CS/DC or no SPI clock");',
+            '',
         ])
     
+    table = ', '.join(f'{cfg["name"].upper()}_CONFIG' for cfg in configs)
     lines.extend([
+        '// Display Registry (index = display index)',
+        f'constexpr DisplayConfig DISPLAY_CONFIGS[NUM_DISPLAYS] = {{ {table} }};',
+        'static_assert(NUM_DISPLAYS <= DisplayManager::MAX_DISPLAYS, "Too many displays");',
+        'static_assert(hasUniqueChipSelects(DISPLAY_CONFIGS, NUM_DISPLAYS), '
+        '"Two displays share a CS pin");',
+        '',
+        '// Display Registry Initialization',
+        'inline void initializeDisplayRegistry(DisplayManager& manager) {',
+        '    for (uint8_t i = 0; i < NUM_DISPLAYS; i++) {',
+        '        manager.addDisplay(DISPLAY_CONFIGS[i]);',
+        '    }',
         '}',
         '',
         '#endif // DISPLAY_CONFIG_H'
     ])
     
-    return '\n'.join(lines)
+    return '\n'.join(lines) + '\n'
 
 
 def main():
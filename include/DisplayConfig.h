@@ -1,7 +1,7 @@
 /*
  * DisplayConfig.h - Multi-Display Configuration
  * Auto-generated from all .config files
- * Generated: 2025-11-06 03:23:47
+ * Generated: 2026-10-14 06:29:52
  * 
  * DO NOT EDIT THIS FILE MANUALLY!
  * Edit the .config files and regenerate using generate_config_header.py
@@ -32,6 +32,10 @@
 #define DUELCD01_TFT_DC 10
 #define DUELCD01_TFT_RST 8
 #define DUELCD01_TFT_BL 9
+#define DUELCD01_TFT_TE DISPLAY_PIN_NONE
+
+// SPI Clock (maximum SCK in Hz)
+#define DUELCD01_SPI_FREQUENCY 32000000UL
 
 // Display Dimensions
 #define DUELCD01_DISPLAY_WIDTH 160
@@ -61,6 +65,10 @@
 #define DUELCD02_TFT_DC 31
 #define DUELCD02_TFT_RST 33
 #define DUELCD02_TFT_BL 35
+#define DUELCD02_TFT_TE DISPLAY_PIN_NONE
+
+// SPI Clock (maximum SCK in Hz)
+#define DUELCD02_SPI_FREQUENCY 32000000UL
 
 // Display Dimensions
 #define DUELCD02_DISPLAY_WIDTH 128
@@ -77,53 +85,38 @@
 #define DUELCD02_CENTER_X 65
 #define DUELCD02_CENTER_Y 80
 
+// Display Descriptors
+// constexpr: folded into flash and validated at compile time
+constexpr DisplayConfig DUELCD01_CONFIG = {
+    DUELCD01_NAME, DUELCD01_MANUFACTURER, DUELCD01_MODEL,
+    DUELCD01_TFT_CS, DUELCD01_TFT_DC, DUELCD01_TFT_RST, DUELCD01_TFT_BL, DUELCD01_TFT_TE,
+    DUELCD01_DISPLAY_WIDTH, DUELCD01_DISPLAY_HEIGHT, DUELCD01_DISPLAY_ROTATION,
+    DUELCD01_USABLE_ORIGIN_X, DUELCD01_USABLE_ORIGIN_Y, DUELCD01_USABLE_WIDTH, DUELCD01_USABLE_HEIGHT,
+    DUELCD01_CENTER_X, DUELCD01_CENTER_Y,
+    DUELCD01_SPI_FREQUENCY
+};
+static_assert(isValidDisplayConfig(DUELCD01_CONFIG), "DueLCD01: usable area or centre outside the panel, CS = DC, TE on CS/DC or no SPI clock");
+
+constexpr DisplayConfig DUELCD02_CONFIG = {
+    DUELCD02_NAME, DUELCD02_MANUFACTURER, DUELCD02_MODEL,
+    DUELCD02_TFT_CS, DUELCD02_TFT_DC, DUELCD02_TFT_RST, DUELCD02_TFT_BL, DUELCD02_TFT_TE,
+    DUELCD02_DISPLAY_WIDTH, DUELCD02_DISPLAY_HEIGHT, DUELCD02_DISPLAY_ROTATION,
+    DUELCD02_USABLE_ORIGIN_X, DUELCD02_USABLE_ORIGIN_Y, DUELCD02_USABLE_WIDTH, DUELCD02_USABLE_HEIGHT,
+    DUELCD02_CENTER_X, DUELCD02_CENTER_Y,
+    DUELCD02_SPI_FREQUENCY
+};
+static_assert(isValidDisplayConfig(DUELCD02_CONFIG), "DueLCD02: usable area or centre outside the panel, CS = DC, TE on CS/DC or no SPI clock");
+
+// Display Registry (index = display index)
+constexpr DisplayConfig DISPLAY_CONFIGS[NUM_DISPLAYS] = { DUELCD01_CONFIG, DUELCD02_CONFIG };
+static_assert(NUM_DISPLAYS <= DisplayManager::MAX_DISPLAYS, "Too many displays");
+static_assert(hasUniqueChipSelects(DISPLAY_CONFIGS, NUM_DISPLAYS), "Two displays share a CS pin");
+
 // Display Registry Initialization
 inline void initializeDisplayRegistry(DisplayManager& manager) {
-
-    // Add DueLCD01
-    {
-        DisplayConfig cfg;
-        cfg.name = DUELCD01_NAME;
-        cfg.manufacturer = DUELCD01_MANUFACTURER;
-        cfg.model = DUELCD01_MODEL;
-        cfg.cs = DUELCD01_TFT_CS;
-        cfg.dc = DUELCD01_TFT_DC;
-        cfg.rst = DUELCD01_TFT_RST;
-        cfg.bl = DUELCD01_TFT_BL;
-        cfg.width = DUELCD01_DISPLAY_WIDTH;
-        cfg.height = DUELCD01_DISPLAY_HEIGHT;
-        cfg.rotation = DUELCD01_DISPLAY_ROTATION;
-        cfg.usableX = DUELCD01_USABLE_ORIGIN_X;
-        cfg.usableY = DUELCD01_USABLE_ORIGIN_Y;
-        cfg.usableWidth = DUELCD01_USABLE_WIDTH;
-        cfg.usableHeight = DUELCD01_USABLE_HEIGHT;
-        cfg.centerX = DUELCD01_CENTER_X;
-        cfg.centerY = DUELCD01_CENTER_Y;
-        manager.addDisplay(cfg);
+    for (uint8_t i = 0; i < NUM_DISPLAYS; i++) {
+        manager.addDisplay(DISPLAY_CONFIGS[i]);
     }
-
-    // Add DueLCD02
-    {
-        DisplayConfig cfg;
-        cfg.name = DUELCD02_NAME;
-        cfg.manufacturer = DUELCD02_MANUFACTURER;
-        cfg.model = DUELCD02_MODEL;
-        cfg.cs = DUELCD02_TFT_CS;
-        cfg.dc = DUELCD02_TFT_DC;
-        cfg.rst = DUELCD02_TFT_RST;
-        cfg.bl = DUELCD02_TFT_BL;
-        cfg.width = DUELCD02_DISPLAY_WIDTH;
-        cfg.height = DUELCD02_DISPLAY_HEIGHT;
-        cfg.rotation = DUELCD02_DISPLAY_ROTATION;
-        cfg.usableX = DUELCD02_USABLE_ORIGIN_X;
-        cfg.usableY = DUELCD02_USABLE_ORIGIN_Y;
-        cfg.usableWidth = DUELCD02_USABLE_WIDTH;
-        cfg.usableHeight = DUELCD02_USABLE_HEIGHT;
-        cfg.centerX = DUELCD02_CENTER_X;
-        cfg.centerY = DUELCD02_CENTER_Y;
-        manager.addDisplay(cfg);
-    }
-
 }
 
 #endif // DISPLAY_CONFIG_H
@@ -0,0 +1,191 @@
+/*
+ * Benchmark.cpp
+ * CMD:BENCH fill, blit and decoder kernels
+ */
+
+#include "Benchmark.h"
+#include "BinaryFrame.h"
+
+namespace {
+
+const BenchKernel KERNELS[] = {
+    { "FILL", BENCH_FILL, 0 },
+    { "BLIT", BENCH_BLIT, 0 },
+    { "RLE", BENCH_DECODE, BIN_ENC_RLE },
+    { "QOI", BENCH_DECODE, BIN_ENC_QOI },
+    { "IDX4", BENCH_DECODE, BIN_ENC_INDEXED4 },
+    { "RGB888", BENCH_DECODE, BIN_ENC_RGB888 },
+    { "FS", BENCH_DECODE, BIN_ENC_RGB888 | BIN_ENC_DITHER_DIFFUSE },
+};
+const uint8_t KERNEL_COUNT = sizeof(KERNELS) / sizeof(KERNELS[0]);
+
+// Swallows decoded pixels so decode kernels time the decoder alone
+class BenchSink : public PixelSink {
+public:
+    uint32_t pixels = 0;
+    uint16_t checksum = 0;
+    void emitPixel(uint16_t wirePixel) override { pixels++; checksum ^= wirePixel; }
+    void emitRun(uint16_t wirePixel, uint32_t count) override { pixels += count; checksum ^= wirePixel; }
+};
+
+} // namespace
+
+namespace Benchmark {
+
+uint8_t getKernelCount() {
+    return KERNEL_COUNT;
+}
+
+const BenchKernel& getKernel(uint8_t index) {
+    return KERNELS[index];
+}
+
+int findKernel(const char* name) {
+    for (uint8_t k = 0; k < KERNEL_COUNT; k++) {
+        if (strcmp(name, KERNELS[k].name) == 0) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+size_t makePayload(uint8_t encoding, uint32_t pixels, uint8_t* out, size_t capacity, uint32_t& covered) {
+    size_t length = 0;
+    covered = 0;
+    for (uint32_t op = 0; covered < pixels; op++) {
+        uint32_t left = pixels - covered;
+        uint8_t value = (uint8_t)(op * 37);
+        uint8_t bytes[17];
+        size_t size = 1;
+        uint32_t count = 1;
+        switch (encoding & ~BIN_ENC_DITHER_MASK) {
+            case BIN_ENC_RLE:
+                // Alternating 8-pixel literals and 24-pixel runs
+                if (op & 1) {
+                    count = min(left, (uint32_t)24);
+                    bytes[0] = 0x80 | (count - 1);
+                    bytes[1] = value;
+                    bytes[2] = ~value;
+                    size = 3;
+                } else {
+                    count = min(left, (uint32_t)8);
+                    bytes[0] = count - 1;
+                    for (uint32_t i = 0; i < count; i++) {
+                        bytes[1 + i * 2] = value + i;
+                        bytes[2 + i * 2] = i * 29;
+                    }
+                    size = 1 + count * 2;
+                }
+                break;
+                
+            case BIN_ENC_QOI:
+                // 16-op cycle: 10 DIFF, 3 LUMA, 1 INDEX, 1 RUN of 14, 1 literal
+                switch (op & 15) {
+                    case 10: case 11: case 12:
+                        bytes[0] = 0x80 | (value & 0x3F);
+                        bytes[1] = value;
+                        size = 2;
+                        break;
+                    case 13:
+                        bytes[0] = value & 0x3F;
+                        break;
+                    case 14:
+                        count = min(left, (uint32_t)14);
+                        bytes[0] = 0xC0 | (count - 1);
+                        break;
+                    case 15:
+                        bytes[0] = 0xFE;
+                        bytes[1] = value;
+                        bytes[2] = ~value;
+                        size = 3;
+                        break;
+                    default:
+                        bytes[0] = 0x40 | (value & 0x3F);
+                        break;
+                }
+                break;
+                
+            case BIN_ENC_INDEXED4:
+                count = min(left, (uint32_t)2);
+                bytes[0] = value;
+                break;
+                
+            default:
+                // RGB888: one pixel per op
+                bytes[0] = value;
+                bytes[1] = op;
+                bytes[2] = value ^ op;
+                size = 3;
+                break;
+        }
+        if (length + size > capacity) {
+            break;
+        }
+        memcpy(out + length, bytes, size);
+        length += size;
+        covered += count;
+    }
+    return length;
+}
+
+void run(uint8_t kernel, DisplayManager& displays, const DisplayTarget* targets, uint8_t targetCount,
+         int width, int height, uint16_t* const bands[2], size_t bandPixels, int bandRows,
+         PixelDecoder& decoder, uint16_t frames, BenchResult& result) {
+    const BenchKernel& bench = KERNELS[kernel];
+    uint32_t pixels = (uint32_t)width * height;
+    
+    // Everything outside the frame loop is set up untimed
+    uint8_t* chunk = reinterpret_cast<uint8_t*>(bands[0]);
+    uint8_t* tail = reinterpret_cast<uint8_t*>(bands[1]);
+    size_t chunkBytes = 0;
+    size_t tailBytes = 0;
+    uint32_t chunkPixels = 0;
+    uint32_t chunkRepeats = 0;
+    if (bench.kind == BENCH_BLIT) {
+        // Same gradient in both band buffers, pushed alternately like received bands
+        for (size_t p = 0; p < bandPixels; p++) {
+            uint16_t color = (uint16_t)((p % width) * 0x0841 + (p / width) * 0x1000);
+            bands[0][p] = bands[1][p] = (color >> 8) | (color << 8);
+        }
+    } else if (bench.kind == BENCH_DECODE) {
+        // One payload chunk replayed, then a shorter tail for the remaining pixels
+        chunkBytes = makePayload(bench.encoding, pixels, chunk, bandPixels * sizeof(uint16_t), chunkPixels);
+        chunkRepeats = pixels / chunkPixels;
+        uint32_t tailPixels = 0;
+        tailBytes = makePayload(bench.encoding, pixels % chunkPixels, tail, bandPixels * sizeof(uint16_t),
+                                tailPixels);
+    }
+    
+    result.totalMicros = 0;
+    result.minMicros = UINT32_MAX;
+    result.maxMicros = 0;
+    result.complete = false;
+    uint32_t checksum = 0;
+    for (uint16_t frame = 0; frame < frames; frame++) {
+        unsigned long start = micros();
+        if (bench.kind == BENCH_FILL) {
+            displays.fillRows(targets, targetCount, (frame & 1) ? ST77XX_BLUE : ST77XX_RED, 0, height);
+        } else if (bench.kind == BENCH_BLIT) {
+            for (int row = 0, band = 0; row < height; row += bandRows, band ^= 1) {
+                displays.pushBand(targets, targetCount, bands[band], width, row, min(bandRows, height - row));
+            }
+            DisplayInstance::finishPendingPush();
+        } else {
+            BenchSink sink;
+            decoder.begin(bench.encoding, pixels, width);
+            for (uint32_t r = 0; r < chunkRepeats; r++) {
+                decoder.decode(chunk, chunkBytes, sink);
+            }
+            decoder.decode(tail, tailBytes, sink);
+            checksum += sink.checksum;
+        }
+        uint32_t elapsed = micros() - start;
+        result.totalMicros += elapsed;
+        result.minMicros = min(result.minMicros, elapsed);
+        result.maxMicros = max(result.maxMicros, elapsed);
+    }
+    result.complete = bench.kind == BENCH_DECODE && decoder.isComplete();
+    result.checksum = checksum & 0xFFFF;
+}
+
+} // namespace Benchmark
@@ -0,0 +1,62 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "DisplayManager.h"
+#include "PixelDecoder.h"
+
+// Synthetic on-device kernels behind CMD:BENCH. FILL and BLIT time the panel
+// path (DisplayManager::fillRows, and pushBand with two alternating band
+// buffers like received bands, DMA included); decode kernels run
+// PixelDecoder alone over generated payloads, so the numbers exclude USB.
+//
+// Kernels work on the caller's targets and band buffers: SerialProtocol sets
+// up the targets exactly as for a received image and parses / formats the
+// command. Timing covers the frame loop only; setup runs untimed.
+
+enum BenchKind {
+    BENCH_FILL,
+    BENCH_BLIT,
+    BENCH_DECODE
+};
+
+struct BenchKernel {
+    const char* name;
+    BenchKind kind;
+    uint8_t encoding;   // BENCH_DECODE only
+};
+
+struct BenchResult {
+    uint32_t totalMicros;
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    bool complete;      // Decode kernels: every pixel decoded
+    uint16_t checksum;  // Decode kernels: XOR of decoded pixels, summed over frames
+};
+
+namespace Benchmark {
+
+static const uint16_t MAX_FRAMES = 1000;
+
+uint8_t getKernelCount();
+const BenchKernel& getKernel(uint8_t index);
+
+// Index of a kernel by name ("FILL", "QOI", ...), or -1
+int findKernel(const char* name);
+
+// Synthetic payload of whole ops for at most pixels pixels (fewer if capacity
+// runs out); covered receives the pixel count. The op mix is fixed, so a
+// shorter request yields a prefix of the same bytes
+size_t makePayload(uint8_t encoding, uint32_t pixels, uint8_t* out, size_t capacity, uint32_t& covered);
+
+// Time frames passes of a kernel over a width x height image on the targets.
+// bands are two buffers of bandPixels pixels each (overwritten), bandRows the
+// rows one of them holds at this width; decoder is reset for decode kernels
+void run(uint8_t kernel, DisplayManager& displays, const DisplayTarget* targets, uint8_t targetCount,
+         int width, int height, uint16_t* const bands[2], size_t bandPixels, int bandRows,
+         PixelDecoder& decoder, uint16_t frames, BenchResult& result);
+
+} // namespace Benchmark
+
+#endif // BENCHMARK_H
@@ -4,15 +4,88 @@
  */
 
 #include "DisplayManager.h"
+#include "Telemetry.h"
+
+// ST7735 scrolling commands (not named by Adafruit_ST77xx)
+static const uint8_t ST7735_VSCRDEF = 0x33;   // Scroll definition: top fixed, scroll, bottom fixed lines
+static const uint8_t ST7735_VSCRSADD = 0x37;  // Memory line shown first in the scroll area
+static const uint8_t ST7735_TEON = 0x35;      // Tearing-effect line on (argument 0: V-blank pulses only)
+
+// ST7735Panel: initR(INITR_BLACKTAB) as single commands (Adafruit's Rcmd1,
+// Rcmd2red and Rcmd3 lists; MADCTL is left to setRotation())
+struct PanelInitStep {
+    uint8_t command;
+    uint8_t argCount;
+    uint16_t waitMs;      // Before the next command
+    uint8_t args[16];
+};
+
+static const PanelInitStep PANEL_INIT_STEPS[] = {
+    { ST77XX_SWRESET, 0, 150, {} },
+    { ST77XX_SLPOUT, 0, 500, {} },
+    { ST7735_FRMCTR1, 3, 0, { 0x01, 0x2C, 0x2D } },   // Frame rate: normal / idle / partial
+    { ST7735_FRMCTR2, 3, 0, { 0x01, 0x2C, 0x2D } },
+    { ST7735_FRMCTR3, 6, 0, { 0x01, 0x2C, 0x2D, 0x01, 0x2C, 0x2D } },
+    { ST7735_INVCTR, 1, 0, { 0x07 } },                // No inversion
+    { ST7735_PWCTR1, 3, 0, { 0xA2, 0x02, 0x84 } },    // Power control
+    { ST7735_PWCTR2, 1, 0, { 0xC5 } },
+    { ST7735_PWCTR3, 2, 0, { 0x0A, 0x00 } },
+    { ST7735_PWCTR4, 2, 0, { 0x8A, 0x2A } },
+    { ST7735_PWCTR5, 2, 0, { 0x8A, 0xEE } },
+    { ST7735_VMCTR1, 1, 0, { 0x0E } },
+    { ST77XX_INVOFF, 0, 0, {} },
+    { ST77XX_COLMOD, 1, 0, { 0x05 } },                // 16-bit colour
+    { ST77XX_CASET, 4, 0, { 0x00, 0x00, 0x00, 0x7F } },
+    { ST77XX_RASET, 4, 0, { 0x00, 0x00, 0x00, 0x9F } },
+    { ST7735_GMCTRP1, 16, 0, { 0x02, 0x1C, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2D,
+                               0x29, 0x25, 0x2B, 0x39, 0x00, 0x01, 0x03, 0x10 } },
+    { ST7735_GMCTRN1, 16, 0, { 0x03, 0x1D, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D,
+                               0x2E, 0x2E, 0x37, 0x3F, 0x00, 0x00, 0x02, 0x10 } },
+    { ST77XX_NORON, 0, 10, {} },
+    { ST77XX_DISPON, 0, 100, {} },
+};
+const uint8_t ST7735Panel::INIT_STEP_COUNT = sizeof(PANEL_INIT_STEPS) / sizeof(PANEL_INIT_STEPS[0]);
+
+uint16_t ST7735Panel::sendInitStep(uint8_t step) {
+    const PanelInitStep& init = PANEL_INIT_STEPS[step];
+    sendCommand(init.command, init.args, init.argCount);
+    return init.waitMs;
+}
+
+void ST7735Panel::setRotation(uint8_t m) {
+    // Adafruit_ST7735::setRotation() for INITR_BLACKTAB
+    static const uint8_t MADCTL[4] = {
+        ST77XX_MADCTL_MX | ST77XX_MADCTL_MY | ST77XX_MADCTL_RGB,
+        ST77XX_MADCTL_MY | ST77XX_MADCTL_MV | ST77XX_MADCTL_RGB,
+        ST77XX_MADCTL_RGB,
+        ST77XX_MADCTL_MX | ST77XX_MADCTL_MV | ST77XX_MADCTL_RGB
+    };
+    rotation = m & 3;
+    bool landscape = rotation & 1;
+    _width = landscape ? ST7735_TFTHEIGHT_160 : ST7735_TFTWIDTH_128;
+    _height = landscape ? ST7735_TFTWIDTH_128 : ST7735_TFTHEIGHT_160;
+    _xstart = landscape ? _rowstart : _colstart;
+    _ystart = landscape ? _colstart : _rowstart;
+    sendCommand(ST77XX_MADCTL, &MADCTL[rotation], 1);
+}
 
 // DisplayInstance implementation
+DisplayInstance* DisplayInstance::pendingPush = nullptr;
+
 DisplayInstance::DisplayInstance(const DisplayConfig& cfg) 
-    : config(cfg), tft(nullptr), initialized(false),
+    : config(cfg), tft(nullptr), initialized(false), spiFrequency(DEFAULT_SPI_FREQUENCY),
       imageFrameEnabled(false), imageFrameColor(ST77XX_WHITE), 
-      imageFrameThickness(1), frameBuffer(nullptr), frameBufferAllocated(false) {
+      imageFrameThickness(1), frameBuffer(nullptr), frameBufferPixels(0), frameSaveValid(false),
+      drawnFrameX(0), drawnFrameY(0), drawnFrameW(0), drawnFrameH(0), drawnFrameThickness(0),
+      drawnFrameColor(ST77XX_WHITE), calibrationShown(false),
+      scrollStart(0), scrollLength(0), scrollOffset(0),
+      lastVsyncMicros(0), vsyncPeriodMicros(0), vsyncTimeouts(0), vsyncSeen(false) {
 }
 
 DisplayInstance::~DisplayInstance() {
+    if (pendingPush == this) {
+        finishPendingPush();
+    }
     if (tft) {
         delete tft;
     }
@@ -27,50 +100,132 @@ bool DisplayInstance::initialize() {
         return true;
     }
     
+    // One panel on its own: the phases DisplayManager::initializeAll() interleaves
+    if (!beginInitialize()) {
+        return false;
+    }
+    delay(ST7735Panel::RESET_PULSE_MS);
+    releaseReset();
+    delay(ST7735Panel::RESET_RECOVERY_MS);
+    for (uint8_t step = 0; step < ST7735Panel::INIT_STEP_COUNT; step++) {
+        delay(sendInitStep(step));
+    }
+    finishInitialize();
+    return true;
+}
+
+bool DisplayInstance::beginInitialize() {
     // Validate config before initializing
     if (config.cs == 0 || config.dc == 0 || config.rst == 0) {
         return false;  // Invalid pin configuration
     }
     
-    // Create TFT instance
-    tft = new Adafruit_ST7735(config.cs, config.dc, config.rst);
+    // Create TFT instance; the reset pin stays ours so all panels reset together
     if (!tft) {
-        return false;  // Memory allocation failed
+        tft = new ST7735Panel(config.cs, config.dc, -1);
+        if (!tft) {
+            return false;  // Memory allocation failed
+        }
     }
     
     // Initialize backlight control
     pinMode(config.bl, OUTPUT);
     digitalWrite(config.bl, HIGH);  // Turn on backlight
     
-    // Initialize display hardware
-    tft->initR(INITR_BLACKTAB);
+    // Hold the controller in reset until releaseReset()
+    pinMode(config.rst, OUTPUT);
+    digitalWrite(config.rst, LOW);
+    
+    finishPendingPush();
+    tft->beginInit();
+    return true;
+}
+
+void DisplayInstance::releaseReset() {
+    digitalWrite(config.rst, HIGH);
+}
+
+void DisplayInstance::finishInitialize() {
     tft->setRotation(config.rotation);
     
+    // The panel's own clock for every later transaction (library drawing too)
+    spiFrequency = config.spiFrequency ? config.spiFrequency : DEFAULT_SPI_FREQUENCY;
+    tft->setSPISpeed(spiFrequency);
+#if DISPLAY_FAST_PINIO
+    spiSettings = SPISettings(spiFrequency, MSBFIRST, SPI_MODE0);
+    csPort = g_APinDescription[config.cs].pPort;
+    csMask = g_APinDescription[config.cs].ulPin;
+    dcPort = g_APinDescription[config.dc].pPort;
+    dcMask = g_APinDescription[config.dc].ulPin;
+#endif
+    
+    // TE output for vsync-timed pushes (the period is measured on first use)
+    if (config.te != DISPLAY_PIN_NONE) {
+        static const uint8_t teMode = 0x00;
+        pinMode(config.te, INPUT);
+        tft->sendCommand(ST7735_TEON, &teMode, 1);
+    }
+    
+    // Bulk pixel pushes use DMA where available
+    SpiDma::begin();
+    
+    // Frame-edge copy sized for the configured usable area, allocated once here
+    // (UPDATE_CONFIG can only shrink what it covers)
+    if (!frameBuffer) {
+        uint8_t t = frameSaveThickness();
+        frameBufferPixels = 2 * (size_t)t * (config.usableWidth + config.usableHeight - 2 * t);
+        if (frameBufferPixels) {
+            frameBuffer = new uint16_t[frameBufferPixels];
+        }
+        if (!frameBuffer) {
+            frameBufferPixels = 0;
+        }
+    }
+    
     initialized = true;
-    return true;
 }
 
 void DisplayInstance::showTestPattern() {
     if (!tft || !initialized) {
         return;
     }
+    finishPendingPush();
     
     // Clear screen
     tft->fillScreen(ST77XX_BLACK);
+    frameSaveValid = false;
+    calibrationShown = false;
+    drawnFrameThickness = 0;
     
     // Draw gradient FIRST (background)
     drawColorBars();
     
-    // Draw calibration frame SECOND (on top of gradient)
-    drawCalibrationFrame();
+    // Draw calibration frame SECOND (on top of gradient; drawCalibrationFrame()
+    // would clear the screen again first)
+    drawCalibrationMarks(0, 0, 0, 0, ST77XX_WHITE, 1);
     
     // Draw device info LAST (on top of everything)
     drawDeviceInfo();
 }
 
-void DisplayInstance::clear() {
-    if (tft && initialized) {
-        tft->fillScreen(ST77XX_BLACK);
+void DisplayInstance::clear(uint16_t color) {
+    finishPendingPush();
+    if (!tft || !initialized) {
+        return;
+    }
+    tft->fillScreen(color);
+    calibrationShown = false;
+    drawnFrameThickness = 0;
+    
+    // Known contents: the edge copy starts from here
+    size_t offset;
+    int16_t x, y, w, h;
+    frameSaveValid = frameSegment(0, x, y, w, h, offset);
+    if (frameSaveValid) {
+        uint16_t wireColor = (color << 8) | (color >> 8);
+        for (size_t i = 0; i < frameBufferPixels; i++) {
+            frameBuffer[i] = wireColor;
+        }
     }
 }
 
@@ -81,43 +236,128 @@ void DisplayInstance::setBacklight(bool on) {
 void DisplayInstance::drawCalibrationFrame(int8_t adjustTop, int8_t adjustBottom,
                                           int8_t adjustLeft, int8_t adjustRight,
                                           uint16_t frameColor, uint8_t frameThickness) {
+    finishPendingPush();
+    
     // Clear screen first to remove old frame
     tft->fillScreen(ST77XX_BLACK);
+    frameSaveValid = false;
+    drawnFrameThickness = 0;
+    drawCalibrationMarks(adjustTop, adjustBottom, adjustLeft, adjustRight, frameColor, frameThickness);
+    calibrationShown = true;
+}
+
+void DisplayInstance::updateCalibrationFrame(int8_t adjustTop, int8_t adjustBottom,
+                                            int8_t adjustLeft, int8_t adjustRight,
+                                            uint16_t frameColor, uint8_t frameThickness) {
+    if (!tft || !initialized) {
+        return;
+    }
+    if (!calibrationShown) {
+        drawCalibrationFrame(adjustTop, adjustBottom, adjustLeft, adjustRight, frameColor, frameThickness);
+        return;
+    }
+    finishPendingPush();
+    
+    int16_t x, y, w, h;
+    if (!frameRect(adjustTop, adjustBottom, adjustLeft, adjustRight, x, y, w, h)) {
+        w = h = 0;
+        frameThickness = 0;
+    }
+    
+    // Old strips minus their replacements go back to black first; strips of
+    // one band never overlap, so unchanged strips are left alone
+    bool recolour = frameColor != drawnFrameColor;
+    bool changed[4];
+    bool hasNew[4];
+    int16_t nx[4], ny[4], nw[4], nh[4];
+    bool anyChanged = false;
+    for (uint8_t s = 0; s < 4; s++) {
+        int16_t ox = 0, oy = 0, ow = 0, oh = 0;
+        bool hadOld = drawnFrameThickness &&
+                      frameStrip(s, drawnFrameX, drawnFrameY, drawnFrameW, drawnFrameH, drawnFrameThickness,
+                                 ox, oy, ow, oh);
+        hasNew[s] = frameThickness && frameStrip(s, x, y, w, h, frameThickness, nx[s], ny[s], nw[s], nh[s]);
+        changed[s] = recolour || hadOld != hasNew[s] ||
+                     (hasNew[s] && (ox != nx[s] || oy != ny[s] || ow != nw[s] || oh != nh[s]));
+        anyChanged |= changed[s];
+        if (!hadOld || !changed[s]) {
+            continue;
+        }
+        
+        // Parts of the old strip outside the new one: above, below, left, right
+        int left = hasNew[s] ? max(ox, nx[s]) : ox;
+        int right = hasNew[s] ? min(ox + ow, nx[s] + nw[s]) : ox;
+        int top = hasNew[s] ? max(oy, ny[s]) : oy;
+        int bottom = hasNew[s] ? min(oy + oh, ny[s] + nh[s]) : oy;
+        if (left >= right || top >= bottom) {
+            tft->fillRect(ox, oy, ow, oh, ST77XX_BLACK);
+            continue;
+        }
+        if (top > oy) tft->fillRect(ox, oy, ow, top - oy, ST77XX_BLACK);
+        if (bottom < oy + oh) tft->fillRect(ox, bottom, ow, oy + oh - bottom, ST77XX_BLACK);
+        if (left > ox) tft->fillRect(ox, top, left - ox, bottom - top, ST77XX_BLACK);
+        if (right < ox + ow) tft->fillRect(right, top, ox + ow - right, bottom - top, ST77XX_BLACK);
+    }
+    if (!anyChanged) {
+        return;
+    }
+    for (uint8_t s = 0; s < 4; s++) {
+        if (hasNew[s] && changed[s]) {
+            tft->fillRect(nx[s], ny[s], nw[s], nh[s], frameColor);
+        }
+    }
+    drawnFrameX = x;
+    drawnFrameY = y;
+    drawnFrameW = w;
+    drawnFrameH = h;
+    drawnFrameThickness = frameThickness;
+    drawnFrameColor = frameColor;
     
+    // Erased strips may have crossed the guides, and the guides sit on top
+    drawCalibrationGuides();
+}
+
+void DisplayInstance::drawCalibrationMarks(int8_t adjustTop, int8_t adjustBottom,
+                                          int8_t adjustLeft, int8_t adjustRight,
+                                          uint16_t frameColor, uint8_t frameThickness) {
     // Draw frame with specified color, thickness, and adjustments
     drawImageFrame(frameColor, frameThickness, 
                   adjustTop, adjustBottom, adjustLeft, adjustRight);
-    
+    drawCalibrationGuides();
+}
+
+void DisplayInstance::drawCalibrationGuides() {
     // Draw diagonal from origin to display center (identifies origin)
     int displayCenterX = config.width / 2;
     int displayCenterY = config.height / 2;
     tft->drawLine(0, 0, displayCenterX, displayCenterY, ST77XX_YELLOW);
     
     // Mark origin
-    tft->drawPixel(0, 0, ST77XX_WHITE);
-    tft->drawPixel(1, 0, ST77XX_WHITE);
+    tft->drawFastHLine(0, 0, 2, ST77XX_WHITE);
     tft->drawPixel(0, 1, ST77XX_WHITE);
     
-    // Mark calibrated center with red cross
-    tft->drawPixel(config.centerX, config.centerY, ST77XX_RED);
-    tft->drawPixel(config.centerX-1, config.centerY, ST77XX_RED);
-    tft->drawPixel(config.centerX+1, config.centerY, ST77XX_RED);
-    tft->drawPixel(config.centerX, config.centerY-1, ST77XX_RED);
-    tft->drawPixel(config.centerX, config.centerY+1, ST77XX_RED);
+    // Mark calibrated center with red cross (two windows, not five pixels)
+    tft->drawFastHLine(config.centerX - 1, config.centerY, 3, ST77XX_RED);
+    tft->drawFastVLine(config.centerX, config.centerY - 1, 3, ST77XX_RED);
 }
 
 void DisplayInstance::drawColorBars() {
     // Draw gradient background across entire usable area
     // Horizontal gradient: blue -> cyan -> green -> yellow -> red
+    if (!tft || !initialized) {
+        return;
+    }
     
-    const int startX = config.usableX;
-    const int endX = config.usableX + config.usableWidth;
-    const float widthInv = 1.0f / config.usableWidth;  // Precompute division
+    // Every row is the same: compute it once, then stream it into a single
+    // address window row after row (instead of one window per column)
+    uint16_t row[ST7735_TFTHEIGHT_160];
+    const int width = min((int)config.usableWidth, ST7735_TFTHEIGHT_160);
+    const float widthInv = 1.0f / width;  // Precompute division
     const float pi = 3.14159f;
     
-    for (int x = startX; x < endX; x++) {
+    for (int x = 0; x < width; x++) {
         // Calculate normalized position [0.0 to 1.0]
-        const float ratio = (x - startX) * widthInv;
+        const float ratio = x * widthInv;
         
         // Generate smooth color transition
         const uint8_t r = (uint8_t)(ratio * 255.0f);
@@ -125,11 +365,15 @@ void DisplayInstance::drawColorBars() {
         const uint8_t b = (uint8_t)((1.0f - ratio) * 255.0f);
         
         // Convert RGB888 to RGB565 format
-        const uint16_t color = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
-        
-        // Draw vertical line for this color
-        tft->drawFastVLine(x, config.usableY, config.usableHeight, color);
+        row[x] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
     }
+    
+    finishPendingPush();
+    beginWindow(config.usableX, config.usableY, width, config.usableHeight);
+    for (int y = 0; y < config.usableHeight; y++) {
+        tft->writePixels(row, width);
+    }
+    endWindow();
 }
 
 void DisplayInstance::drawDeviceInfo() {
@@ -158,25 +402,391 @@ bool DisplayInstance::isWithinBounds(int x, int y) const {
 bool DisplayInstance::isWithinFrameBounds(int x, int y,
                                          int8_t adjustTop, int8_t adjustBottom,
                                          int8_t adjustLeft, int8_t adjustRight) const {
-    // Calculate frame boundaries with adjustments
-    // Remember: top and left use inverted calculations
-    int16_t frameTop = config.usableY - adjustTop;
-    int16_t frameLeft = config.usableX - adjustLeft;
-    int16_t frameBottom = (config.usableY + config.usableHeight - 1) + adjustBottom;
-    int16_t frameRight = (config.usableX + config.usableWidth - 1) + adjustRight;
+    int16_t frameLeft, frameTop, frameRight, frameBottom;
+    getFrameBounds(frameLeft, frameTop, frameRight, frameBottom,
+                   adjustTop, adjustBottom, adjustLeft, adjustRight);
     
     // Check if pixel is within the frame boundaries
     return (x >= frameLeft && x <= frameRight &&
             y >= frameTop && y <= frameBottom);
 }
 
-void DisplayInstance::drawImageFrame(uint16_t color, uint8_t thickness,
-                                    int8_t adjustTop, int8_t adjustBottom,
-                                    int8_t adjustLeft, int8_t adjustRight) {
+void DisplayInstance::getFrameBounds(int16_t& left, int16_t& top, int16_t& right, int16_t& bottom,
+                                     int8_t adjustTop, int8_t adjustBottom,
+                                     int8_t adjustLeft, int8_t adjustRight) const {
+    // Calculate frame boundaries with adjustments (inclusive)
+    // Remember: top and left use inverted calculations
+    top = config.usableY - adjustTop;
+    left = config.usableX - adjustLeft;
+    bottom = (config.usableY + config.usableHeight - 1) + adjustBottom;
+    right = (config.usableX + config.usableWidth - 1) + adjustRight;
+}
+
+void DisplayInstance::centerTarget(DisplayTarget& target, int bmpWidth, int bmpHeight, bool fit) const {
+    target.rotate = false;
+    target.scaleUp = 1;
+    target.scaleDown = 1;
+    
+    if (fit && bmpWidth > 0 && bmpHeight > 0) {
+        // Try both orientations; the larger scale wins, ties stay upright
+        for (uint8_t turn = 0; turn < 2; turn++) {
+            int width = turn ? bmpHeight : bmpWidth;
+            int height = turn ? bmpWidth : bmpHeight;
+            int up = 1;
+            int down = 1;
+            if (width <= config.usableWidth && height <= config.usableHeight) {
+                up = min(min(config.usableWidth / width, config.usableHeight / height), (int)MAX_FIT_SCALE);
+            } else {
+                down = max((width + config.usableWidth - 1) / config.usableWidth,
+                           (height + config.usableHeight - 1) / config.usableHeight);
+                down = min(down, 255);
+            }
+            if (turn == 0 || up * target.scaleDown > target.scaleUp * down) {
+                target.rotate = turn != 0;
+                target.scaleUp = up;
+                target.scaleDown = down;
+            }
+        }
+    }
+    
+    int width = ((target.rotate ? bmpHeight : bmpWidth) * target.scaleUp + target.scaleDown - 1) / target.scaleDown;
+    int height = ((target.rotate ? bmpWidth : bmpHeight) * target.scaleUp + target.scaleDown - 1) / target.scaleDown;
+    target.originX = config.usableX + config.usableWidth / 2 - width / 2;
+    target.originY = config.usableY + config.usableHeight / 2 - height / 2;
+}
+
+void DisplayInstance::clipTarget(DisplayTarget& target, int bmpWidth, int bmpHeight,
+                                 int8_t adjustTop, int8_t adjustBottom,
+                                 int8_t adjustLeft, int8_t adjustRight) const {
+    TELEMETRY_SCOPE(TELEMETRY_CLIP);
+    
+    // Intersect frame bounds with the physical display, then translate into
+    // bitmap coordinates so rows need no per-pixel bounds checks
+    int16_t frameLeft, frameTop, frameRight, frameBottom;
+    getFrameBounds(frameLeft, frameTop, frameRight, frameBottom,
+                   adjustTop, adjustBottom, adjustLeft, adjustRight);
+    
+    int left = max((int)frameLeft, 0);
+    int top = max((int)frameTop, 0);
+    int right = min((int)frameRight, config.width - 1);
+    int bottom = min((int)frameBottom, config.height - 1);
+    
+    if (target.isTransformed()) {
+        // Clip in panel coordinates instead; pushBand resamples per pixel, so
+        // only the range of bitmap rows landing inside is needed here
+        int up = target.scaleUp;
+        int down = target.scaleDown;
+        target.scaledWidth = (bmpWidth * up + down - 1) / down;
+        target.scaledHeight = (bmpHeight * up + down - 1) / down;
+        int panelWidth = target.rotate ? target.scaledHeight : target.scaledWidth;
+        int panelHeight = target.rotate ? target.scaledWidth : target.scaledHeight;
+        target.clipLeft = max(left, (int)target.originX);
+        target.clipTop = max(top, (int)target.originY);
+        target.clipRight = max(min(right + 1, target.originX + panelWidth), (int)target.clipLeft);
+        target.clipBottom = max(min(bottom + 1, target.originY + panelHeight), (int)target.clipTop);
+        
+        // Visible scaled rows: panel columns when turned (last row leftmost)
+        int first = target.clipTop - target.originY;
+        int last = target.clipBottom - 1 - target.originY;
+        if (target.rotate) {
+            first = target.scaledHeight - (target.clipRight - target.originX);
+            last = target.scaledHeight - 1 - (target.clipLeft - target.originX);
+        }
+        bool visible = target.clipLeft < target.clipRight && target.clipTop < target.clipBottom;
+        target.colStart = 0;
+        target.colEnd = visible ? bmpWidth : 0;
+        target.rowStart = visible ? first * down / up : 0;
+        target.rowEnd = visible ? last * down / up + 1 : 0;
+        return;
+    }
+    
+    target.colStart = constrain(left - target.originX, 0, bmpWidth);
+    target.colEnd = constrain(right - target.originX + 1, (int)target.colStart, bmpWidth);
+    target.rowStart = constrain(top - target.originY, 0, bmpHeight);
+    target.rowEnd = constrain(bottom - target.originY + 1, (int)target.rowStart, bmpHeight);
+    TELEMETRY_COUNT(TELEMETRY_PIXELS_CLIPPED, (uint32_t)bmpWidth * bmpHeight -
+                    (uint32_t)(target.colEnd - target.colStart) * (target.rowEnd - target.rowStart));
+}
+
+void DisplayInstance::pushPixels(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t* pixels) {
+    if (!tft || !initialized || w <= 0 || h <= 0) {
+        return;
+    }
+    
+    TELEMETRY_SCOPE(TELEMETRY_SPI);
+    TELEMETRY_COUNT(TELEMETRY_PIXELS_WRITTEN, (uint32_t)w * h);
+    
+    // Single CASET/RASET/RAMWR sequence followed by one bulk write
+    finishPendingPush();
+    beginWindow(x, y, w, h);
+    tft->writePixels(pixels, (uint32_t)w * h);
+    endWindow();
+    saveFrameEdge(x, y, w, h, pixels, true);
+}
+
+void DisplayInstance::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!tft || !initialized || w <= 0 || h <= 0) {
+        return;
+    }
+    finishPendingPush();
+    tft->fillRect(x, y, w, h, color);
+    saveFrameEdge(x, y, w, h, nullptr, false, (color << 8) | (color >> 8));
+}
+
+void DisplayInstance::pushPixelsAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels) {
+    if (!tft || !initialized || w <= 0 || h <= 0) {
+        return;
+    }
+    
+    TELEMETRY_SCOPE(TELEMETRY_SPI);
+    TELEMETRY_COUNT(TELEMETRY_PIXELS_WRITTEN, (uint32_t)w * h);
+    
+    // One transfer in flight on the shared bus: the previous band (possibly on
+    // another display) completes here while the caller already refilled the other buffer
+    finishPendingPush();
+    
+    // Copied while the pixels are still known to be intact (before the DMA reads them)
+    saveFrameEdge(x, y, w, h, pixels, false);
+    
+    beginWindow(x, y, w, h);
+    
+    if (!SpiDma::isAvailable()) {
+        tft->writePixels(const_cast<uint16_t*>(pixels), (uint32_t)w * h, true, true);
+        endWindow();
+        return;
+    }
+    
+    // Leading blocks synchronously, final block left running
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(pixels);
+    size_t remaining = (size_t)w * h * 2;
+    while (remaining > SpiDma::MAX_BLOCK_BYTES) {
+        SpiDma::start(bytes, SpiDma::MAX_BLOCK_BYTES);
+        bytes += SpiDma::MAX_BLOCK_BYTES;
+        remaining -= SpiDma::MAX_BLOCK_BYTES;
+    }
+    SpiDma::start(bytes, remaining);
+    pendingPush = this;
+}
+
+void DisplayInstance::finishPendingPush() {
+    if (!pendingPush) {
+        return;
+    }
+    
+    TELEMETRY_SCOPE(TELEMETRY_SPI_WAIT);
+    DisplayInstance* owner = pendingPush;
+    pendingPush = nullptr;
+    SpiDma::wait();
+    owner->endWindow();
+}
+
+bool DisplayInstance::waitForVsync() {
+    if (!hasVsync()) {
+        return false;
+    }
+    // TE high: already in vertical blanking, the write can start now
+    return digitalRead(config.te) == HIGH || waitForVsyncEdge();
+}
+
+bool DisplayInstance::measureVsync() {
+    if (!hasVsync()) {
+        return false;
+    }
+    for (uint8_t attempt = 0; attempt < 2 && vsyncPeriodMicros == 0; attempt++) {
+        if (!waitForVsyncEdge()) {
+            return false;
+        }
+    }
+    return vsyncPeriodMicros != 0;
+}
+
+bool DisplayInstance::waitForVsyncEdge() {
+    // Rising edge: let a pulse already in progress end, then wait for the next
+    unsigned long start = micros();
+    while (digitalRead(config.te) == HIGH) {
+        if (micros() - start > VSYNC_TIMEOUT_US) {
+            vsyncTimeouts++;
+            return false;
+        }
+    }
+    while (digitalRead(config.te) == LOW) {
+        if (micros() - start > VSYNC_TIMEOUT_US) {
+            vsyncTimeouts++;
+            return false;
+        }
+    }
+    unsigned long edge = micros();
+    
+    // Edges may be several refreshes apart: divide by the whole periods elapsed
+    uint32_t elapsed = edge - lastVsyncMicros;
+    if (vsyncSeen && elapsed > 0) {
+        if (vsyncPeriodMicros == 0) {
+            if (elapsed <= VSYNC_TIMEOUT_US) {
+                vsyncPeriodMicros = elapsed;
+            }
+        } else {
+            uint32_t periods = (elapsed + vsyncPeriodMicros / 2) / vsyncPeriodMicros;
+            if (periods > 0 && periods <= 16) {
+                vsyncPeriodMicros = (vsyncPeriodMicros * 3 + elapsed / periods) / 4;
+            }
+        }
+    }
+    lastVsyncMicros = edge;
+    vsyncSeen = true;
+    return true;
+}
+
+uint32_t DisplayInstance::microsUntilVsync(unsigned long at) const {
+    // A time already past counts from now
+    unsigned long now = micros();
+    if ((long)(at - now) < 0) {
+        at = now;
+    }
+    uint32_t lead = at - now;
+    if (!vsyncSeen || vsyncPeriodMicros == 0) {
+        return lead;
+    }
+    
+    // Next edge at or after at, projected from the last one seen
+    uint32_t sinceEdge = (uint32_t)(at - lastVsyncMicros) % vsyncPeriodMicros;
+    return lead + (sinceEdge ? vsyncPeriodMicros - sinceEdge : 0);
+}
+
+void DisplayInstance::beginWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+#if DISPLAY_FAST_PINIO
+    // Adafruit's setAddrWindow sequence, with CS/DC flipped through the PIO
+    // set/clear registers instead of one digitalWrite per edge
+    uint16_t x0 = x + tft->getXStart();
+    uint16_t y0 = y + tft->getYStart();
+    SPI.beginTransaction(spiSettings);
+    csPort->PIO_CODR = csMask;
+    writeCommand(ST77XX_CASET);
+    writeWord(x0);
+    writeWord(x0 + w - 1);
+    writeCommand(ST77XX_RASET);
+    writeWord(y0);
+    writeWord(y0 + h - 1);
+    writeCommand(ST77XX_RAMWR);
+#else
+    tft->startWrite();
+    tft->setAddrWindow(x, y, w, h);
+#endif
+}
+
+void DisplayInstance::endWindow() {
+#if DISPLAY_FAST_PINIO
+    csPort->PIO_SODR = csMask;
+    SPI.endTransaction();
+#else
+    tft->endWrite();
+#endif
+}
+
+#if DISPLAY_FAST_PINIO
+void DisplayInstance::writeCommand(uint8_t command) {
+    // transfer() returns once the byte has been clocked out, so DC can flip
+    dcPort->PIO_CODR = dcMask;
+    SPI.transfer(command);
+    dcPort->PIO_SODR = dcMask;
+}
+
+void DisplayInstance::writeWord(uint16_t value) {
+    SPI.transfer(value >> 8);
+    SPI.transfer(value & 0xFF);
+}
+#endif
+
+bool DisplayInstance::isScrollVertical() const {
+    // Rotations 1/3 set MADCTL_MV, so memory lines run across the screen
+    return tft && (tft->getRotation() & 1) == 0;
+}
+
+bool DisplayInstance::isScrollFlipped() const {
+    // Rotations 0/1 set MADCTL_MY: logical line 0 is the last memory line
+    return tft && tft->getRotation() <= 1;
+}
+
+int16_t DisplayInstance::scrollMemoryTop() const {
+    // First memory line of the scroll area (VSCRDEF top fixed area)
+    return isScrollFlipped() ? SCROLL_LINES - scrollStart - scrollLength : scrollStart;
+}
+
+bool DisplayInstance::setScrollArea(int16_t start, int16_t length) {
+    if (!tft || !initialized || start < 0 || length < 2 || start + length > SCROLL_LINES) {
+        return false;
+    }
+    scrollStart = start;
+    scrollLength = length;
+    scrollOffset = 0;
+    frameSaveValid = false;   // Edge pixels move with the memory lines
+    calibrationShown = false;
+    
+    uint16_t top = scrollMemoryTop();
+    uint16_t bottom = SCROLL_LINES - top - length;
+    uint8_t definition[6] = {
+        (uint8_t)(top >> 8), (uint8_t)top,
+        (uint8_t)(length >> 8), (uint8_t)length,
+        (uint8_t)(bottom >> 8), (uint8_t)bottom
+    };
+    getTFT()->sendCommand(ST7735_VSCRDEF, definition, sizeof(definition));
+    writeScrollStart();
+    return true;
+}
+
+void DisplayInstance::scrollBy(int16_t lines) {
+    if (!isScrolling()) {
+        return;
+    }
+    
+    // Screen order runs against memory order when flipped
+    int16_t step = lines % scrollLength;
+    if (isScrollFlipped()) {
+        step = -step;
+    }
+    scrollOffset = (scrollOffset + step + scrollLength) % scrollLength;
+    frameSaveValid = false;
+    calibrationShown = false;
+    writeScrollStart();
+}
+
+void DisplayInstance::resetScroll() {
     if (!tft || !initialized) {
         return;
     }
+    scrollStart = 0;
+    scrollLength = 0;
+    scrollOffset = 0;
+    frameSaveValid = false;
+    calibrationShown = false;
     
+    uint8_t definition[6] = { 0, 0, (uint8_t)(SCROLL_LINES >> 8), (uint8_t)SCROLL_LINES, 0, 0 };
+    getTFT()->sendCommand(ST7735_VSCRDEF, definition, sizeof(definition));
+    writeScrollStart();
+    tft->sendCommand(ST77XX_NORON);   // Leave scroll mode
+}
+
+int16_t DisplayInstance::scrollLineToLogical(int16_t line) const {
+    if (!isScrolling()) {
+        return line;
+    }
+    
+    // Screen line -> panel line -> memory line shown there -> logical line addressing it
+    bool flipped = isScrollFlipped();
+    int16_t top = scrollMemoryTop();
+    int16_t panelLine = flipped ? SCROLL_LINES - 1 - line : line;
+    int16_t memoryLine = top + (panelLine - top + scrollOffset) % scrollLength;
+    return flipped ? SCROLL_LINES - 1 - memoryLine : memoryLine;
+}
+
+void DisplayInstance::writeScrollStart() {
+    uint16_t address = isScrolling() ? scrollMemoryTop() + scrollOffset : 0;
+    uint8_t data[2] = { (uint8_t)(address >> 8), (uint8_t)address };
+    getTFT()->sendCommand(ST7735_VSCRSADD, data, sizeof(data));
+}
+
+bool DisplayInstance::frameRect(int8_t adjustTop, int8_t adjustBottom,
+                                int8_t adjustLeft, int8_t adjustRight,
+                                int16_t& x, int16_t& y, int16_t& w, int16_t& h) const {
     // Apply adjustments to usable area boundaries (relative to config values)
     // Adjustments move edges: positive = outward (expand), negative = inward (shrink)
     // Top/Left: positive decreases coordinate (moves up/left), negative increases (moves down/right)
@@ -187,46 +797,165 @@ void DisplayInstance::drawImageFrame(uint16_t color, uint8_t thickness,
     int16_t right = (config.usableX + config.usableWidth - 1) + adjustRight;
     
     // Calculate dimensions from adjusted edges
-    int16_t x = left;
-    int16_t y = top;
-    int16_t w = right - left + 1;
-    int16_t h = bottom - top + 1;
+    x = left;
+    y = top;
+    w = right - left + 1;
+    h = bottom - top + 1;
     
     // Bounds checking to prevent crashes
     if (x < -10) x = -10;  // Allow 10 pixels beyond display
     if (y < -10) y = -10;
-    if (w <= 0 || h <= 0) return;  // Nothing to draw
+    return w > 0 && h > 0;
+}
+
+void DisplayInstance::drawImageFrame(uint16_t color, uint8_t thickness,
+                                    int8_t adjustTop, int8_t adjustBottom,
+                                    int8_t adjustLeft, int8_t adjustRight) {
+    if (!tft || !initialized) {
+        return;
+    }
+    finishPendingPush();
+    
+    int16_t x, y, w, h;
+    if (!frameRect(adjustTop, adjustBottom, adjustLeft, adjustRight, x, y, w, h)) {
+        return;  // Nothing to draw
+    }
+    
+    // A recolour just draws over the old frame; a moved or thinner one would
+    // leave the old edge behind
+    if (drawnFrameThickness && (x != drawnFrameX || y != drawnFrameY || w != drawnFrameW ||
+                                h != drawnFrameH || thickness < drawnFrameThickness)) {
+        clearImageFrame();
+    }
     
     // Draw frame with specified thickness
     // Draw inward from the boundary (like cal_lcd.cpp reference implementation)
-    for (uint8_t i = 0; i < thickness; i++) {
-        // Calculate rectangle for this thickness layer
-        int16_t fx = x + i;
-        int16_t fy = y + i;
-        int16_t fw = w - (2 * i);
-        int16_t fh = h - (2 * i);
-        
-        // Stop if no space left for this layer
-        if (fw <= 0 || fh <= 0) break;
-        
-        // Draw rectangle (allow slightly beyond display bounds for calibration)
-        tft->drawRect(fx, fy, fw, fh, color);
+    fillFrameBand(x, y, w, h, thickness, color);
+    drawnFrameX = x;
+    drawnFrameY = y;
+    drawnFrameW = w;
+    drawnFrameH = h;
+    drawnFrameThickness = thickness;
+    drawnFrameColor = color;
+}
+
+bool DisplayInstance::frameStrip(uint8_t index, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t thickness,
+                                 int16_t& sx, int16_t& sy, int16_t& sw, int16_t& sh) {
+    // Top and bottom take the full width, left and right the rows between
+    int16_t t = min((int)thickness, (int)min((w + 1) / 2, (h + 1) / 2));
+    bool horizontal = index < 2;
+    sx = (index == 3) ? x + w - t : x;
+    sy = (index == 1) ? y + h - t : y + (horizontal ? 0 : t);
+    sw = horizontal ? w : t;
+    sh = horizontal ? t : h - 2 * t;
+    return t > 0 && sw > 0 && sh > 0;
+}
+
+void DisplayInstance::fillFrameBand(int16_t x, int16_t y, int16_t w, int16_t h,
+                                    uint8_t thickness, uint16_t color) {
+    // All layers at once as four bands, one fillRect window each (Adafruit
+    // clips the parts slightly beyond the display used for calibration)
+    int16_t sx, sy, sw, sh;
+    for (uint8_t s = 0; s < 4; s++) {
+        if (frameStrip(s, x, y, w, h, thickness, sx, sy, sw, sh)) {
+            tft->fillRect(sx, sy, sw, sh, color);
+        }
     }
 }
 
 void DisplayInstance::clearImageFrame() {
-    if (!tft || !initialized) {
+    if (!tft || !initialized || !drawnFrameThickness) {
         return;
     }
+    finishPendingPush();
+    
+    // Saved layers go back as they were under the frame, one window per segment
+    uint8_t restored = 0;
+    if (frameSaveValid && drawnFrameX == config.usableX && drawnFrameY == config.usableY &&
+        drawnFrameW == config.usableWidth && drawnFrameH == config.usableHeight) {
+        int16_t x, y, w, h;
+        size_t offset;
+        for (uint8_t s = 0; frameSegment(s, x, y, w, h, offset); s++) {
+            if (w > 0 && h > 0) {
+                beginWindow(x, y, w, h);
+                tft->writePixels(frameBuffer + offset, (uint32_t)w * h, true, true);
+                endWindow();
+            }
+        }
+        restored = frameSaveThickness();
+    }
+    
+    // Layers beyond the copy (or the whole frame without one) are cleared to black
+    if (drawnFrameThickness > restored) {
+        fillFrameBand(drawnFrameX + restored, drawnFrameY + restored,
+                      drawnFrameW - 2 * restored, drawnFrameH - 2 * restored,
+                      drawnFrameThickness - restored, ST77XX_BLACK);
+    }
+    drawnFrameThickness = 0;
+}
+
+uint8_t DisplayInstance::frameSaveThickness() const {
+    return min((int)DISPLAY_FRAME_SAVE_THICKNESS, (int)min(config.usableWidth, config.usableHeight) / 2);
+}
+
+bool DisplayInstance::frameSegment(uint8_t index, int16_t& x, int16_t& y, int16_t& w, int16_t& h,
+                                   size_t& offset) const {
+    int16_t t = frameSaveThickness();
+    int16_t uw = config.usableWidth;
+    int16_t uh = config.usableHeight;
+    size_t band = (size_t)t * uw;
+    size_t side = (size_t)t * (uh - 2 * t);
+    if (index >= 4 || t == 0 || 2 * (band + side) > frameBufferPixels) {
+        return false;
+    }
     
-    // Clear frame by drawing in black
-    int16_t x = config.usableX;
-    int16_t y = config.usableY;
-    int16_t w = config.usableWidth;
-    int16_t h = config.usableHeight;
+    // Top and bottom take the full width, left and right the rows between
+    bool horizontal = index < 2;
+    x = (index == 3) ? config.usableX + uw - t : config.usableX;
+    y = (index == 1) ? config.usableY + uh - t : config.usableY + (horizontal ? 0 : t);
+    w = horizontal ? uw : t;
+    h = horizontal ? t : uh - 2 * t;
+    offset = horizontal ? index * band : 2 * band + (index - 2) * side;
+    return true;
+}
+
+void DisplayInstance::saveFrameEdge(int16_t x, int16_t y, int16_t w, int16_t h,
+                                    const uint16_t* pixels, bool nativeOrder, uint16_t wireColor) {
+    // Any pixel write replaces the calibration screen too
+    calibrationShown = false;
+    if (!frameSaveValid) {
+        return;
+    }
     
-    for (uint8_t i = 0; i < imageFrameThickness; i++) {
-        tft->drawRect(x - i, y - i, w + 2*i, h + 2*i, ST77XX_BLACK);
+    // Copy the part of the written rectangle that overlaps each segment
+    int16_t sx, sy, sw, sh;
+    size_t offset;
+    for (uint8_t s = 0; frameSegment(s, sx, sy, sw, sh, offset); s++) {
+        int left = max((int)x, (int)sx);
+        int right = min(x + w, sx + sw);
+        int top = max((int)y, (int)sy);
+        int bottom = min(y + h, sy + sh);
+        if (left >= right || top >= bottom) {
+            continue;
+        }
+        for (int row = top; row < bottom; row++) {
+            uint16_t* out = frameBuffer + offset + (size_t)(row - sy) * sw + (left - sx);
+            int count = right - left;
+            if (!pixels) {
+                for (int i = 0; i < count; i++) {
+                    out[i] = wireColor;
+                }
+                continue;
+            }
+            const uint16_t* in = pixels + (size_t)(row - y) * w + (left - x);
+            if (nativeOrder) {
+                for (int i = 0; i < count; i++) {
+                    out[i] = (in[i] << 8) | (in[i] >> 8);
+                }
+            } else {
+                memcpy(out, in, count * sizeof(uint16_t));
+            }
+        }
     }
 }
 
@@ -247,7 +976,7 @@ void DisplayInstance::enableImageFrame(bool enable, uint16_t color, uint8_t thic
 // DisplayManager implementation
 
 // DisplayManager implementation
-DisplayManager::DisplayManager() : displayCount(0) {
+DisplayManager::DisplayManager() : displayCount(0), transformBufferIndex(0) {
     for (uint8_t i = 0; i < MAX_DISPLAYS; i++) {
         displays[i] = nullptr;
     }
@@ -292,11 +1021,46 @@ bool DisplayManager::addDisplay(const DisplayConfig& config) {
 bool DisplayManager::initializeAll() {
     bool allSuccess = true;
     
+    // Each phase reaches every panel before its wait, so the reset, sleep-out
+    // and display-on delays are paid once instead of once per panel
+    uint8_t pending = 0;   // Bit i = display i being initialized
     for (uint8_t i = 0; i < displayCount; i++) {
-        if (displays[i] && !displays[i]->initialize()) {
+        if (!displays[i] || displays[i]->isInitialized()) {
+            continue;
+        }
+        if (displays[i]->beginInitialize()) {
+            pending |= 1u << i;
+        } else {
             allSuccess = false;
         }
     }
+    if (!pending) {
+        return allSuccess;
+    }
+    
+    delay(ST7735Panel::RESET_PULSE_MS);
+    for (uint8_t i = 0; i < displayCount; i++) {
+        if (pending & (1u << i)) {
+            displays[i]->releaseReset();
+        }
+    }
+    delay(ST7735Panel::RESET_RECOVERY_MS);
+    
+    for (uint8_t step = 0; step < ST7735Panel::INIT_STEP_COUNT; step++) {
+        uint16_t wait = 0;
+        for (uint8_t i = 0; i < displayCount; i++) {
+            if (pending & (1u << i)) {
+                wait = max(wait, displays[i]->sendInitStep(step));
+            }
+        }
+        delay(wait);
+    }
+    
+    for (uint8_t i = 0; i < displayCount; i++) {
+        if (pending & (1u << i)) {
+            displays[i]->finishInitialize();
+        }
+    }
     
     return allSuccess;
 }
@@ -309,6 +1073,14 @@ void DisplayManager::showAllTestPatterns() {
     }
 }
 
+void DisplayManager::clearAll() {
+    for (uint8_t i = 0; i < displayCount; i++) {
+        if (displays[i]) {
+            displays[i]->clear();
+        }
+    }
+}
+
 DisplayInstance* DisplayManager::getDisplay(const char* name) {
     for (uint8_t i = 0; i < displayCount; i++) {
         if (displays[i] && strcmp(displays[i]->getName(), name) == 0) {
@@ -325,6 +1097,245 @@ DisplayInstance* DisplayManager::getDisplay(uint8_t index) {
     return nullptr;
 }
 
+int8_t DisplayManager::getDisplayIndex(const DisplayInstance* display) const {
+    for (uint8_t i = 0; i < displayCount; i++) {
+        if (displays[i] == display) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint8_t DisplayManager::resolveDisplayMask(const char* names) const {
+    if (!names) {
+        return 0;
+    }
+    if (strcmp(names, "ALL") == 0) {
+        return getAllDisplaysMask();
+    }
+    
+    uint8_t mask = 0;
+    const char* token = names;
+    while (*token) {
+        // Token bounds with surrounding spaces trimmed
+        const char* end = strchr(token, ',');
+        if (!end) {
+            end = token + strlen(token);
+        }
+        const char* next = *end ? end + 1 : end;
+        while (token < end && *token == ' ') token++;
+        while (end > token && end[-1] == ' ') end--;
+        
+        size_t length = end - token;
+        bool found = false;
+        for (uint8_t i = 0; i < displayCount && length > 0; i++) {
+            const char* name = displays[i]->getName();
+            if (strlen(name) == length && strncmp(name, token, length) == 0) {
+                mask |= (1u << i);
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return 0;
+        }
+        token = next;
+    }
+    return mask;
+}
+
+void DisplayManager::pushBand(const DisplayTarget* targets, uint8_t targetCount,
+                              const uint16_t* band, int bandWidth, int firstRow, int rowCount) {
+    for (uint8_t i = 0; i < targetCount; i++) {
+        const DisplayTarget& target = targets[i];
+        if (target.isTransformed()) {
+            pushTransformedBand(target, band, bandWidth, firstRow, rowCount);
+            continue;
+        }
+        int rowStart = max(firstRow, (int)target.rowStart);
+        int rowEnd = min(firstRow + rowCount, (int)target.rowEnd);
+        int width = target.colEnd - target.colStart;
+        if (rowStart >= rowEnd || width <= 0) {
+            continue;
+        }
+        
+        const uint16_t* src = band + (rowStart - firstRow) * bandWidth + target.colStart;
+        if (width == bandWidth) {
+            // Whole rows visible: the band is contiguous, one window
+            target.display->pushPixelsAsync(target.originX + target.colStart, target.originY + rowStart,
+                                            width, rowEnd - rowStart, src);
+        } else {
+            // Columns clipped: one window per row span
+            for (int row = rowStart; row < rowEnd; row++, src += bandWidth) {
+                target.display->pushPixelsAsync(target.originX + target.colStart, target.originY + row,
+                                                width, 1, src);
+            }
+        }
+    }
+}
+
+void DisplayManager::fillRows(const DisplayTarget* targets, uint8_t targetCount,
+                              uint16_t color, int firstRow, int rowCount) {
+    TELEMETRY_SCOPE(TELEMETRY_FILL);
+    
+    for (uint8_t i = 0; i < targetCount; i++) {
+        const DisplayTarget& target = targets[i];
+        Adafruit_ST7735* tft = target.display->getTFT();
+        if (target.isTransformed()) {
+            int left, top, right, bottom;
+            if (tft && transformedRect(target, firstRow, rowCount, left, top, right, bottom)) {
+                target.display->fillRect(left, top, right - left, bottom - top, color);
+                TELEMETRY_COUNT(TELEMETRY_PIXELS_FILLED, (uint32_t)(right - left) * (bottom - top));
+            }
+            continue;
+        }
+        int rowStart = max(firstRow, (int)target.rowStart);
+        int rowEnd = min(firstRow + rowCount, (int)target.rowEnd);
+        int width = target.colEnd - target.colStart;
+        if (rowStart >= rowEnd || width <= 0 || !tft) {
+            continue;
+        }
+        target.display->fillRect(target.originX + target.colStart, target.originY + rowStart,
+                                 width, rowEnd - rowStart, color);
+        TELEMETRY_COUNT(TELEMETRY_PIXELS_FILLED, (uint32_t)width * (rowEnd - rowStart));
+    }
+}
+
+bool DisplayManager::transformedRect(const DisplayTarget& target, int firstRow, int rowCount,
+                                     int& left, int& top, int& right, int& bottom) {
+    // Scaled rows whose source row lies in the band (rounded up at both ends)
+    int up = target.scaleUp;
+    int down = target.scaleDown;
+    int first = (firstRow * up + down - 1) / down;
+    int last = ((firstRow + rowCount) * up + down - 1) / down;
+    
+    if (target.rotate) {
+        left = target.originX + target.scaledHeight - last;
+        right = target.originX + target.scaledHeight - first;
+        top = target.originY;
+        bottom = target.originY + target.scaledWidth;
+    } else {
+        left = target.originX;
+        right = target.originX + target.scaledWidth;
+        top = target.originY + first;
+        bottom = target.originY + last;
+    }
+    left = max(left, (int)target.clipLeft);
+    right = min(right, (int)target.clipRight);
+    top = max(top, (int)target.clipTop);
+    bottom = min(bottom, (int)target.clipBottom);
+    return left < right && top < bottom;
+}
+
+void DisplayManager::pushTransformedBand(const DisplayTarget& target, const uint16_t* band,
+                                         int bandWidth, int firstRow, int rowCount) {
+    int left, top, right, bottom;
+    if (!transformedRect(target, firstRow, rowCount, left, top, right, bottom)) {
+        return;
+    }
+    
+    // Nearest-neighbour resampling: each panel pixel maps back to one bitmap
+    // pixel of the band. Output goes out in blocks of whole window rows
+    int up = target.scaleUp;
+    int down = target.scaleDown;
+    int width = right - left;
+    int blockRows = max(1, TRANSFORM_BUFFER_PIXELS / width);
+    for (int y = top; y < bottom; y += blockRows) {
+        int rows = min(blockRows, bottom - y);
+        // The other buffer may still be in flight; this one finished when it was queued
+        uint16_t* out = transformBuffers[transformBufferIndex];
+        transformBufferIndex ^= 1;
+        
+        for (int py = y; py < y + rows; py++) {
+            if (target.rotate) {
+                // Panel row = bitmap column; columns run from the last bitmap row
+                int col = (py - target.originY) * down / up;
+                for (int px = left; px < right; px++) {
+                    int row = (target.scaledHeight - 1 - (px - target.originX)) * down / up;
+                    *out++ = band[(row - firstRow) * bandWidth + col];
+                }
+            } else {
+                const uint16_t* src = band + ((py - target.originY) * down / up - firstRow) * bandWidth;
+                for (int px = left; px < right; px++) {
+                    *out++ = src[(px - target.originX) * down / up];
+                }
+            }
+        }
+        target.display->pushPixelsAsync(left, y, width, rows, out - width * rows);
+    }
+}
+
+uint16_t DisplayManager::composeTiles(const DisplayTarget* targets, uint8_t targetCount,
+                                     const TileDraw* tiles, uint8_t tileCount,
+                                     int8_t adjustTop, int8_t adjustBottom, int8_t adjustLeft, int8_t adjustRight) {
+    uint16_t strips = 0;
+    uint8_t first = 0;
+    while (first < tileCount) {
+        // Extend the strip while the next tile continues it edge to edge
+        const TileDraw& head = tiles[first];
+        uint8_t end = first + 1;
+        int stripWidth = head.width;
+        while (end < tileCount && tiles[end].y == head.y && tiles[end].height == head.height &&
+               tiles[end].x == head.x + stripWidth) {
+            stripWidth += tiles[end].width;
+            end++;
+        }
+        
+        for (uint8_t i = 0; i < targetCount; i++) {
+            DisplayTarget strip;
+            strip.display = targets[i].display;
+            strip.originX = targets[i].originX + head.x;
+            strip.originY = targets[i].originY + head.y;
+            strip.display->clipTarget(strip, stripWidth, head.height,
+                                      adjustTop, adjustBottom, adjustLeft, adjustRight);
+            pushTileStrip(strip, tiles + first, end - first);
+        }
+        strips++;
+        first = end;
+    }
+    return strips;
+}
+
+void DisplayManager::pushTileStrip(const DisplayTarget& strip, const TileDraw* tiles, uint8_t tileCount) {
+    int width = min(strip.colEnd - strip.colStart, TRANSFORM_BUFFER_PIXELS);
+    if (width <= 0 || strip.rowStart >= strip.rowEnd) {
+        return;
+    }
+    
+    if (tileCount == 1 && width == tiles[0].width) {
+        // One tile with whole rows visible: its rows are contiguous, push them in place
+        strip.display->pushPixelsAsync(strip.originX, strip.originY + strip.rowStart, width,
+                                       strip.rowEnd - strip.rowStart,
+                                       tiles[0].pixels + strip.rowStart * tiles[0].width);
+        return;
+    }
+    
+    // Join the visible span of every tile row into blocks of whole window rows
+    int colEnd = strip.colStart + width;
+    int blockRows = TRANSFORM_BUFFER_PIXELS / width;
+    for (int y = strip.rowStart; y < strip.rowEnd; y += blockRows) {
+        int rows = min(blockRows, strip.rowEnd - y);
+        uint16_t* out = transformBuffers[transformBufferIndex];
+        transformBufferIndex ^= 1;
+        
+        for (int row = y; row < y + rows; row++) {
+            int col = 0;
+            for (uint8_t t = 0; t < tileCount && col < colEnd; t++) {
+                int left = max((int)strip.colStart, col);
+                int right = min(colEnd, col + tiles[t].width);
+                if (left < right) {
+                    memcpy(out, tiles[t].pixels + row * tiles[t].width + (left - col),
+                           (right - left) * sizeof(uint16_t));
+                    out += right - left;
+                }
+                col += tiles[t].width;
+            }
+        }
+        strip.display->pushPixelsAsync(strip.originX + strip.colStart, strip.originY + y,
+                                       width, rows, out - width * rows);
+    }
+}
+
 void DisplayManager::listDisplays(Stream& serial) {
     serial.println("Registered displays:");
     for (uint8_t i = 0; i < displayCount; i++) {
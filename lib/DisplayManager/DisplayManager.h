@@ -16,6 +16,10 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_ST7735.h>
 #include <SPI.h>
+#include "SpiDma.h"
+
+// Pin number of an unconnected optional line (DisplayConfig::te)
+#define DISPLAY_PIN_NONE 0xFF
 
 // Display configuration structure
 struct DisplayConfig {
@@ -28,6 +32,7 @@ struct DisplayConfig {
     uint8_t dc;
     uint8_t rst;
     uint8_t bl;
+    uint8_t te;     // Tearing-effect output (vsync), DISPLAY_PIN_NONE if not wired
     
     // Display dimensions
     uint16_t width;
@@ -43,6 +48,117 @@ struct DisplayConfig {
     // Center point
     uint16_t centerX;
     uint16_t centerY;
+    
+    // Highest SCK the panel tolerates (Hz); the Due divides 84 MHz by an integer
+    uint32_t spiFrequency;
+};
+
+// Compile-time checks for the generated descriptors (DisplayConfig.h
+// static_asserts these, so a bad calibration fails the build, not the boot)
+constexpr bool isValidDisplayConfig(const DisplayConfig& cfg) {
+    return cfg.name != nullptr && cfg.width > 0 && cfg.height > 0 && cfg.rotation < 4 &&
+           cfg.cs != cfg.dc && cfg.spiFrequency > 0 && cfg.te != cfg.cs && cfg.te != cfg.dc &&
+           cfg.usableWidth > 0 && cfg.usableHeight > 0 &&
+           cfg.usableX + cfg.usableWidth <= cfg.width &&
+           cfg.usableY + cfg.usableHeight <= cfg.height &&
+           cfg.centerX >= cfg.usableX && cfg.centerX < cfg.usableX + cfg.usableWidth &&
+           cfg.centerY >= cfg.usableY && cfg.centerY < cfg.usableY + cfg.usableHeight;
+}
+
+// True if no two of count descriptors share a chip select (pairs i < j)
+constexpr bool hasUniqueChipSelects(const DisplayConfig* cfgs, int count, int i = 0, int j = 1) {
+    return i >= count - 1 ? true :
+           j >= count ? hasUniqueChipSelects(cfgs, count, i + 1, i + 2) :
+           cfgs[i].cs != cfgs[j].cs && hasUniqueChipSelects(cfgs, count, i, j + 1);
+}
+
+// True if one of count descriptors wires pin as its CS, DC, RST, BL or TE line
+constexpr bool usesDisplayPin(const DisplayConfig* cfgs, int count, int pin, int i = 0) {
+    return i < count &&
+           (cfgs[i].cs == pin || cfgs[i].dc == pin || cfgs[i].rst == pin || cfgs[i].bl == pin ||
+            cfgs[i].te == pin ||
+            usesDisplayPin(cfgs, count, pin, i + 1));
+}
+
+// CS/DC are driven through the PIO set/clear registers on the Due; elsewhere
+// (and in the Adafruit drawing calls) the library's digitalWrite path is used
+#if defined(ARDUINO_ARCH_SAM)
+#define DISPLAY_FAST_PINIO 1
+#else
+#define DISPLAY_FAST_PINIO 0
+#endif
+
+// Layers of the usable-area edge each display keeps a copy of, so an image
+// frame drawn there can be removed without resending the image (2 bytes per
+// pixel: about 1.1KB per layer for a 128x160 panel)
+#ifndef DISPLAY_FRAME_SAVE_THICKNESS
+#define DISPLAY_FRAME_SAVE_THICKNESS 1
+#endif
+
+// Adafruit_ST7735 with the controller window offsets exposed, so bulk pushes
+// can send CASET/RASET themselves, and with initR(INITR_BLACKTAB) split into
+// steps: DisplayManager::initializeAll() sends each step to every panel and
+// then waits once, so the controllers' reset and sleep-out delays overlap
+class ST7735Panel : public Adafruit_ST7735 {
+public:
+    using Adafruit_ST7735::Adafruit_ST7735;
+    uint8_t getXStart() const { return _xstart; }
+    uint8_t getYStart() const { return _ystart; }
+    
+    // Hardware reset timing (the panel is built without its reset pin, which
+    // DisplayInstance drives for all panels at once)
+    static const uint16_t RESET_PULSE_MS = 100;
+    static const uint16_t RESET_RECOVERY_MS = 200;
+    
+    // Power-on command sequence; sendInitStep() returns the wait (ms) the
+    // controller needs before the next step
+    static const uint8_t INIT_STEP_COUNT;
+    void beginInit() { begin(); }   // CS/DC pins and SPI at the library clock
+    uint16_t sendInitStep(uint8_t step);
+    
+    // initR() records the tab for setRotation(); the stepped init sets up the
+    // black tab geometry here instead (RGB order, 128x160, no window offsets)
+    void setRotation(uint8_t rotation) override;
+};
+
+class DisplayInstance;
+
+// One display receiving a (possibly shared) bitmap transfer
+// Visible region is in bitmap coordinates, end exclusive
+struct DisplayTarget {
+    DisplayInstance* display;
+    int16_t originX;      // Display position of bitmap pixel (0, 0)
+    int16_t originY;      // (top-left corner of the transformed image)
+    int16_t colStart;
+    int16_t colEnd;
+    int16_t rowStart;
+    int16_t rowEnd;
+    
+    // Per-panel transform (identity unless set by DisplayInstance::centerTarget)
+    bool rotate = false;    // Turned 90 degrees clockwise
+    uint8_t scaleUp = 1;    // Each bitmap pixel covers scaleUp x scaleUp panel pixels
+    uint8_t scaleDown = 1;  // Only every scaleDown-th bitmap row and column is shown
+    
+    // Filled by clipTarget() for transformed targets: scaled bitmap size and
+    // the visible panel rectangle (display coordinates, end exclusive)
+    int16_t scaledWidth;
+    int16_t scaledHeight;
+    int16_t clipLeft;
+    int16_t clipTop;
+    int16_t clipRight;
+    int16_t clipBottom;
+    
+    bool isTransformed() const { return rotate || scaleUp != 1 || scaleDown != 1; }
+};
+
+// One placement for DisplayManager::composeTiles: an opaque raw RGB565 tile
+// (row-major, wire byte order, typically an ImageCache entry read in place)
+struct TileDraw {
+    const uint16_t* pixels;
+    int16_t x;            // Position relative to the target origin
+    int16_t y;
+    uint16_t width;
+    uint16_t height;
 };
 
 // Display instance wrapper
@@ -52,30 +168,120 @@ public:
     ~DisplayInstance();
     
     bool initialize();
+    bool isInitialized() const { return initialized; }
+    
+    // initialize() in phases, for DisplayManager::initializeAll(): create the
+    // panel and hold it in reset, release the reset, then the ST7735Panel init
+    // steps (each followed by its wait), then finishInitialize()
+    bool beginInitialize();
+    void releaseReset();
+    uint16_t sendInitStep(uint8_t step) { return tft->sendInitStep(step); }
+    void finishInitialize();
+    
     void showTestPattern();
-    void clear();
+    // Fill the screen; also the known state the frame-edge copy starts from
+    void clear(uint16_t color = ST77XX_BLACK);
     void setBacklight(bool on);
     
     // Getters
     const char* getName() const { return config.name; }
     const DisplayConfig& getConfig() const { return config; }
-    Adafruit_ST7735* getTFT() { return tft; }
+    // Waits for any in-flight bulk push so callers can draw immediately
+    Adafruit_ST7735* getTFT() { finishPendingPush(); return tft; }
     
     // Drawing helpers
     void drawCalibrationFrame(int8_t adjustTop = 0, int8_t adjustBottom = 0,
                              int8_t adjustLeft = 0, int8_t adjustRight = 0,
                              uint16_t frameColor = ST77XX_WHITE, uint8_t frameThickness = 1);
+    // Move, resize or recolour the frame of the calibration screen in place:
+    // only the frame strips that changed are repainted (the whole screen is
+    // drawn instead when something else has been drawn since)
+    void updateCalibrationFrame(int8_t adjustTop, int8_t adjustBottom,
+                                int8_t adjustLeft, int8_t adjustRight,
+                                uint16_t frameColor, uint8_t frameThickness);
     void drawColorBars();
     void drawDeviceInfo();
     bool isWithinBounds(int x, int y) const;
     bool isWithinFrameBounds(int x, int y, 
                             int8_t adjustTop = 0, int8_t adjustBottom = 0,
                             int8_t adjustLeft = 0, int8_t adjustRight = 0) const;
+    void getFrameBounds(int16_t& left, int16_t& top, int16_t& right, int16_t& bottom,
+                        int8_t adjustTop = 0, int8_t adjustBottom = 0,
+                        int8_t adjustLeft = 0, int8_t adjustRight = 0) const;
+    
+    // Centre a bmpWidth x bmpHeight image in the usable area. With fit, the
+    // image is also turned (when the panel's shape suits it better) and
+    // scaled by the largest whole step that still fits: pixel replication up
+    // to MAX_FIT_SCALE, or keeping every n-th row and column when too large
+    static const uint8_t MAX_FIT_SCALE = 8;
+    void centerTarget(DisplayTarget& target, int bmpWidth, int bmpHeight, bool fit = false) const;
+    
+    // Clip a bmpWidth x bmpHeight transfer at target.originX/Y against the
+    // adjusted frame bounds and the panel, filling target's visible region
+    void clipTarget(DisplayTarget& target, int bmpWidth, int bmpHeight,
+                    int8_t adjustTop = 0, int8_t adjustBottom = 0,
+                    int8_t adjustLeft = 0, int8_t adjustRight = 0) const;
+    
+    // Bulk pixel output: one address window and one SPI burst for a w x h block
+    // Caller is responsible for clipping the window to the display
+    void pushPixels(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t* pixels);
+    
+    // Solid rectangle (clipped by the library), kept in the frame-edge copy
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    
+    // Non-blocking bulk output (DMA on the Due). pixels are RGB565 in wire
+    // (big-endian) byte order and must stay untouched until the push finishes:
+    // the next push on any display, finishPendingPush() or getTFT() waits for it.
+    void pushPixelsAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels);
+    
+    // Complete the in-flight async push (if any) on the shared SPI bus
+    static void finishPendingPush();
+    static bool isPushPending() { return pendingPush != nullptr; }
+    
+    // SCK used for this panel's transactions (config.spiFrequency or the default)
+    static const uint32_t DEFAULT_SPI_FREQUENCY = 32000000UL;
+    uint32_t getSpiFrequency() const { return spiFrequency; }
+    
+    // Tearing-effect sync (config.te wired): the controller raises TE at the
+    // start of vertical blanking, so a frame written from that edge on stays
+    // ahead of the refresh scan as long as the push outpaces it (a full
+    // 160x128 frame takes about 10ms at 32 MHz, a 60-80 Hz refresh 12-16ms).
+    // waitForVsync() returns at once during blanking (TE high), otherwise
+    // polls for the next rising edge, giving up after VSYNC_TIMEOUT_US so a
+    // missing line cannot stall drawing; the edges it sees keep a running
+    // estimate of the refresh period.
+    static const uint32_t VSYNC_TIMEOUT_US = 40000;
+    bool hasVsync() const { return initialized && config.te != DISPLAY_PIN_NONE; }
+    bool waitForVsync();
+    // Wait for edges until the refresh period is known (false on timeout)
+    bool measureVsync();
+    uint32_t getVsyncPeriod() const { return vsyncPeriodMicros; }    // 0 = not measured
+    uint32_t getVsyncTimeouts() const { return vsyncTimeouts; }
+    // Microseconds from now until the first estimated edge at or after micros() value at
+    uint32_t microsUntilVsync(unsigned long at) const;
+    
+    // Hardware scrolling (ST7735 VSCRDEF / VSCRSADD). The controller scrolls
+    // its SCROLL_LINES memory lines, which are screen rows in rotations 0/2
+    // and screen columns in rotations 1/3. Lines are display coordinates along
+    // that axis; drawing keeps using logical coordinates, so callers map the
+    // on-screen line they want to update with scrollLineToLogical().
+    static const int16_t SCROLL_LINES = ST7735_TFTHEIGHT_160;
+    bool isScrollVertical() const;
+    bool setScrollArea(int16_t start, int16_t length);
+    void scrollBy(int16_t lines);   // Content moves towards the area start, wrapping round
+    void resetScroll();             // Whole screen fixed again, scroll offset 0
+    bool isScrolling() const { return scrollLength > 0; }
+    int16_t getScrollStart() const { return scrollStart; }
+    int16_t getScrollLength() const { return scrollLength; }
+    // Logical line currently shown at on-screen line (which must lie in the area)
+    int16_t scrollLineToLogical(int16_t line) const;
     
     // Image frame support
     void drawImageFrame(uint16_t color = ST77XX_WHITE, uint8_t thickness = 1, 
                        int8_t adjustTop = 0, int8_t adjustBottom = 0, 
                        int8_t adjustLeft = 0, int8_t adjustRight = 0);
+    // Remove the drawn frame: the saved edge pixels are written back when the
+    // frame sat on the unadjusted usable area, other layers are cleared to black
     void clearImageFrame();
     void enableImageFrame(bool enable, uint16_t color = ST77XX_WHITE, uint8_t thickness = 1,
                          int8_t adjustTop = 0, int8_t adjustBottom = 0,
@@ -87,11 +293,76 @@ private:
     bool imageFrameEnabled;
     uint16_t imageFrameColor;
     uint8_t imageFrameThickness;
-    uint16_t* frameBuffer;  // Stores pixels under frame for restoration
-    bool frameBufferAllocated;
     DisplayConfig config;
-    Adafruit_ST7735* tft;
+    ST7735Panel* tft;
     bool initialized;
+    
+    // Bulk push bus access: one transaction at the panel's clock, CS held low
+    // from beginWindow() (CASET/RASET/RAMWR sent) until endWindow()
+    uint32_t spiFrequency;
+#if DISPLAY_FAST_PINIO
+    SPISettings spiSettings;
+    Pio* csPort;
+    uint32_t csMask;
+    Pio* dcPort;
+    uint32_t dcMask;
+    void writeCommand(uint8_t command);
+    void writeWord(uint16_t value);
+#endif
+    void beginWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+    void endWindow();
+    
+    // Tearing-effect edges seen by waitForVsync() / measureVsync()
+    bool waitForVsyncEdge();
+    unsigned long lastVsyncMicros;
+    uint32_t vsyncPeriodMicros;
+    uint32_t vsyncTimeouts;
+    bool vsyncSeen;
+    
+    // drawCalibrationFrame() without clearing the screen first
+    void drawCalibrationMarks(int8_t adjustTop, int8_t adjustBottom, int8_t adjustLeft, int8_t adjustRight,
+                              uint16_t frameColor, uint8_t frameThickness);
+    // Origin diagonal and marks and the centre cross (drawn over the frame)
+    void drawCalibrationGuides();
+    bool calibrationShown;  // Screen is exactly drawCalibrationFrame()'s output
+    
+    // Frame-edge copy: the outer layers of the usable area as they are on the
+    // panel (wire byte order), stored as top, bottom, left and right segments.
+    // Kept up to date by the pixel writes above; drawing that bypasses them
+    // (test patterns, scrolling, the frame itself) leaves it invalid until clear()
+    uint16_t* frameBuffer;
+    size_t frameBufferPixels;       // Allocated capacity
+    bool frameSaveValid;
+    uint8_t frameSaveThickness() const;
+    bool frameSegment(uint8_t index, int16_t& x, int16_t& y, int16_t& w, int16_t& h, size_t& offset) const;
+    void saveFrameEdge(int16_t x, int16_t y, int16_t w, int16_t h,
+                       const uint16_t* pixels, bool nativeOrder, uint16_t wireColor = 0);
+    
+    // Frame as last drawn (thickness 0 = none on screen)
+    int16_t drawnFrameX;
+    int16_t drawnFrameY;
+    int16_t drawnFrameW;
+    int16_t drawnFrameH;
+    uint8_t drawnFrameThickness;
+    uint16_t drawnFrameColor;
+    // Frame rectangle for the given adjustments (false when empty)
+    bool frameRect(int8_t adjustTop, int8_t adjustBottom, int8_t adjustLeft, int8_t adjustRight,
+                   int16_t& x, int16_t& y, int16_t& w, int16_t& h) const;
+    // Strip 0-3 (top, bottom, left, right) of a frame band (false when empty)
+    static bool frameStrip(uint8_t index, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t thickness,
+                           int16_t& sx, int16_t& sy, int16_t& sw, int16_t& sh);
+    void fillFrameBand(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t thickness, uint16_t color);
+    
+    // Scroll area (display coordinates along the scroll axis); length 0 = off
+    int16_t scrollStart;
+    int16_t scrollLength;
+    int16_t scrollOffset;   // Lines the memory is rotated by within the area
+    bool isScrollFlipped() const;
+    int16_t scrollMemoryTop() const;
+    void writeScrollStart();
+    
+    // Display whose async push currently owns the SPI bus (CS held low)
+    static DisplayInstance* pendingPush;
 };
 
 // Main display manager class
@@ -100,23 +371,71 @@ public:
     DisplayManager();
     ~DisplayManager();
     
-    // Setup
+    // Setup. initializeAll() runs the panels' power-on sequences side by side,
+    // so boot takes about one panel's init delays however many are registered
     bool addDisplay(const DisplayConfig& config);
     bool initializeAll();
     void showAllTestPatterns();
+    void clearAll();
     
     // Display selection
     DisplayInstance* getDisplay(const char* name);
     DisplayInstance* getDisplay(uint8_t index);
     uint8_t getDisplayCount() const { return displayCount; }
+    int8_t getDisplayIndex(const DisplayInstance* display) const;
+    
+    // Multi-display selection (bit i = display index i)
+    // names is "ALL" or a comma-separated list; returns 0 if any name is unknown
+    uint8_t resolveDisplayMask(const char* names) const;
+    uint8_t getAllDisplaysMask() const { return (uint8_t)((1u << displayCount) - 1); }
+    
+    // Fan one row band out to every target, interleaving the SPI work for each
+    // chip select on the shared bus. band holds rowCount full rows (bandWidth
+    // pixels each, wire byte order) starting at bitmap row firstRow.
+    void pushBand(const DisplayTarget* targets, uint8_t targetCount,
+                  const uint16_t* band, int bandWidth, int firstRow, int rowCount);
+    
+    // Fill bitmap rows firstRow..firstRow+rowCount-1 with one native RGB565
+    // colour on every target (fillRect, clipped like pushBand)
+    void fillRows(const DisplayTarget* targets, uint8_t targetCount,
+                  uint16_t color, int firstRow, int rowCount);
+    
+    // Composite tiles onto every target in list order (later tiles overdraw
+    // earlier ones). Consecutive tiles continuing a strip - same y and height,
+    // starting where the previous one ended - share one address window per
+    // target; strips are clipped to the frame bounds given by the usable
+    // area adjustments. Tile pixels must stay put until the last push has
+    // finished (DisplayInstance::finishPendingPush). Returns strips drawn
+    uint16_t composeTiles(const DisplayTarget* targets, uint8_t targetCount,
+                          const TileDraw* tiles, uint8_t tileCount,
+                          int8_t adjustTop, int8_t adjustBottom, int8_t adjustLeft, int8_t adjustRight);
+    
+    // Scratch for transformed targets and tile strips: pushBand resamples
+    // each band into these, composeTiles joins strip rows (alternately, so
+    // one fills while the other is DMA'd)
+    static const int TRANSFORM_BUFFER_PIXELS = 640;
     
     // Utility
     void listDisplays(Stream& serial);
     
-private:
     static const uint8_t MAX_DISPLAYS = 8;
+    
+private:
     DisplayInstance* displays[MAX_DISPLAYS];
     uint8_t displayCount;
+    
+    uint16_t transformBuffers[2][TRANSFORM_BUFFER_PIXELS];
+    uint8_t transformBufferIndex;
+    
+    // Panel rectangle covered by bitmap rows firstRow..+rowCount of a
+    // transformed target, clipped; false if none of it is visible
+    static bool transformedRect(const DisplayTarget& target, int firstRow, int rowCount,
+                                int& left, int& top, int& right, int& bottom);
+    void pushTransformedBand(const DisplayTarget& target, const uint16_t* band,
+                             int bandWidth, int firstRow, int rowCount);
+    
+    // Push the clipped part of one tile strip (strip = clipTarget() result)
+    void pushTileStrip(const DisplayTarget& strip, const TileDraw* tiles, uint8_t tileCount);
 };
 
 #endif // DISPLAY_MANAGER_H
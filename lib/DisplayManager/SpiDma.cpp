@@ -0,0 +1,113 @@
+/*
+ * SpiDma.cpp
+ * SAM3X8E DMAC channel driving SPI0 transmit
+ */
+
+#include "SpiDma.h"
+
+#if SPI_DMA_SUPPORTED
+
+// DMAC channel 3 (channels 3-5 have the larger 32-byte FIFO)
+static const uint32_t DMA_CHANNEL = 3;
+
+// DMAC hardware handshake interface number for SPI0 TX
+static const uint32_t SPI0_TX_HANDSHAKE = 1;
+
+static bool dmaInitialized = false;
+static bool transferActive = false;
+static uint32_t savedModeRegister = 0;
+
+// The Arduino SPI library runs SPI0 in variable peripheral select mode, where
+// 8-bit writes to TDR would select NPCS0. Switch to fixed mode on the channel
+// configured by SPI.beginTransaction() for the default SS pin while DMA runs.
+static uint32_t fixedModeRegister() {
+    uint32_t channel = BOARD_PIN_TO_SPI_CHANNEL(BOARD_SPI_DEFAULT_SS);
+    uint32_t pcs = (~(1u << channel)) & 0x0F;
+    return SPI_MR_MSTR | SPI_MR_MODFDIS | SPI_MR_PCS(pcs);
+}
+
+namespace SpiDma {
+
+void begin() {
+    if (dmaInitialized) {
+        return;
+    }
+    
+    pmc_enable_periph_clk(ID_DMAC);
+    DMAC->DMAC_EN = 0;
+    DMAC->DMAC_GCFG = DMAC_GCFG_ARB_CFG_FIXED;
+    DMAC->DMAC_EN = DMAC_EN_ENABLE;
+    DMAC->DMAC_CHDR = 1u << DMA_CHANNEL;
+    
+    dmaInitialized = true;
+}
+
+bool isAvailable() {
+    return dmaInitialized;
+}
+
+void start(const uint8_t* data, size_t length) {
+    wait();
+    if (length == 0) {
+        return;
+    }
+    
+    savedModeRegister = SPI0->SPI_MR;
+    uint32_t fixedMode = fixedModeRegister() | (savedModeRegister & ~(SPI_MR_PS | SPI_MR_PCS_Msk));
+    SPI0->SPI_MR = fixedMode;
+    
+    DMAC->DMAC_CHDR = 1u << DMA_CHANNEL;
+    DMAC->DMAC_CH_NUM[DMA_CHANNEL].DMAC_SADDR = (uint32_t)data;
+    DMAC->DMAC_CH_NUM[DMA_CHANNEL].DMAC_DADDR = (uint32_t)&SPI0->SPI_TDR;
+    DMAC->DMAC_CH_NUM[DMA_CHANNEL].DMAC_DSCR = 0;
+    DMAC->DMAC_CH_NUM[DMA_CHANNEL].DMAC_CTRLA = length |
+        DMAC_CTRLA_SRC_WIDTH_BYTE | DMAC_CTRLA_DST_WIDTH_BYTE;
+    DMAC->DMAC_CH_NUM[DMA_CHANNEL].DMAC_CTRLB = DMAC_CTRLB_SRC_DSCR | DMAC_CTRLB_DST_DSCR |
+        DMAC_CTRLB_FC_MEM2PER_DMA_FC | DMAC_CTRLB_SRC_INCR_INCREMENTING | DMAC_CTRLB_DST_INCR_FIXED;
+    DMAC->DMAC_CH_NUM[DMA_CHANNEL].DMAC_CFG = DMAC_CFG_DST_PER(SPI0_TX_HANDSHAKE) |
+        DMAC_CFG_DST_H2SEL | DMAC_CFG_SOD | DMAC_CFG_FIFOCFG_ALAP_CFG;
+    DMAC->DMAC_CHER = 1u << DMA_CHANNEL;
+    
+    transferActive = true;
+}
+
+bool isBusy() {
+    if (!transferActive) {
+        return false;
+    }
+    return (DMAC->DMAC_CHSR & (1u << DMA_CHANNEL)) || !(SPI0->SPI_SR & SPI_SR_TXEMPTY);
+}
+
+void wait() {
+    if (!transferActive) {
+        return;
+    }
+    
+    while (DMAC->DMAC_CHSR & (1u << DMA_CHANNEL)) {
+    }
+    while (!(SPI0->SPI_SR & SPI_SR_TXEMPTY)) {
+    }
+    
+    // Discard the received byte so the next blocking transfer waits for its own RDRF
+    (void)SPI0->SPI_RDR;
+    (void)SPI0->SPI_SR;
+    
+    SPI0->SPI_MR = savedModeRegister;
+    transferActive = false;
+}
+
+} // namespace SpiDma
+
+#else // !SPI_DMA_SUPPORTED
+
+namespace SpiDma {
+
+void begin() {}
+bool isAvailable() { return false; }
+void start(const uint8_t* data, size_t length) { (void)data; (void)length; }
+bool isBusy() { return false; }
+void wait() {}
+
+} // namespace SpiDma
+
+#endif // SPI_DMA_SUPPORTED
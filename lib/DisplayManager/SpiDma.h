@@ -0,0 +1,48 @@
+/*
+ * SpiDma.h
+ * DMA-driven SPI transmit for the Arduino Due (SAM3X8E)
+ * 
+ * Feeds SPI0_TDR from memory through a DMAC channel using the SPI0 TX
+ * hardware handshake, so a pixel band is clocked out without the CPU
+ * touching each byte. Only one transfer may be in flight at a time; the
+ * caller keeps CS/DC asserted until wait() returns.
+ * 
+ * On other architectures (or with -DST7735_DISABLE_DMA) isAvailable()
+ * returns false and callers fall back to blocking writes.
+ */
+
+#ifndef SPI_DMA_H
+#define SPI_DMA_H
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_SAM) && defined(__SAM3X8E__) && !defined(ST7735_DISABLE_DMA)
+#define SPI_DMA_SUPPORTED 1
+#else
+#define SPI_DMA_SUPPORTED 0
+#endif
+
+namespace SpiDma {
+
+// Largest single block the DMAC channel is asked to move
+static const size_t MAX_BLOCK_BYTES = 4095;
+
+// Enable the DMAC (call after SPI.begin()); safe to call repeatedly
+void begin();
+
+// True when DMA transfers are compiled in and initialised
+bool isAvailable();
+
+// Start a transmit of length bytes (<= MAX_BLOCK_BYTES); returns immediately.
+// data must remain valid until wait() returns.
+void start(const uint8_t* data, size_t length);
+
+// True while a started transfer has not been fully clocked out
+bool isBusy();
+
+// Block until the DMA and the SPI shift register are idle
+void wait();
+
+} // namespace SpiDma
+
+#endif // SPI_DMA_H
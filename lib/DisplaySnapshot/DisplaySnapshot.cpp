@@ -0,0 +1,115 @@
+#include "DisplaySnapshot.h"
+#include "ImageCache.h"
+#include <string.h>
+
+// The snapshot is one ImageCache entry containing SnapshotHeader followed by width*height
+// uint16_t pixels. It is looked up on every access because other cache stores may move it.
+static uint8_t *snapshotBlock() {
+  const CachedImage *entry = ImageCache::find(IMAGE_CACHE_SNAPSHOT_ID);
+  return entry ? (uint8_t*)ImageCache::getData(entry) : nullptr;
+}
+
+namespace DisplaySnapshot {
+
+bool hasSnapshot() {
+  return snapshotBlock() != nullptr;
+}
+
+const SnapshotHeader *getSnapshotHeader() {
+  return (const SnapshotHeader *)snapshotBlock();
+}
+
+const uint16_t *getSnapshotPixels() {
+  uint8_t *block = snapshotBlock();
+  return block ? (const uint16_t *)(block + sizeof(SnapshotHeader)) : nullptr;
+}
+
+uint16_t *beginCapture(uint16_t width, uint16_t height, int16_t offsetX, int16_t offsetY, uint16_t flags) {
+  if (width == 0 || height == 0) return nullptr;
+
+  // Beside the previous snapshot if free space allows, else in its place; never at the
+  // expense of host images
+  uint32_t bytes_needed = sizeof(SnapshotHeader) + (uint32_t)width * (uint32_t)height * sizeof(uint16_t);
+  uint8_t *block = ImageCache::begin(IMAGE_CACHE_CAPTURE_ID, width, height, 0, bytes_needed, false);
+  if (!block && ImageCache::remove(IMAGE_CACHE_SNAPSHOT_ID)) {
+    block = ImageCache::begin(IMAGE_CACHE_CAPTURE_ID, width, height, 0, bytes_needed, false);
+  }
+  if (!block) return nullptr;
+
+  // Fill header
+  SnapshotHeader *hdr = (SnapshotHeader*)block;
+  hdr->width = width;
+  hdr->height = height;
+  hdr->offsetX = offsetX;
+  hdr->offsetY = offsetY;
+  hdr->flags = flags;
+  return (uint16_t*)(block + sizeof(SnapshotHeader));
+}
+
+void commitCapture() {
+  ImageCache::commit(IMAGE_CACHE_CAPTURE_ID);
+  ImageCache::rename(IMAGE_CACHE_CAPTURE_ID, IMAGE_CACHE_SNAPSHOT_ID);
+}
+
+void abortCapture() {
+  ImageCache::remove(IMAGE_CACHE_CAPTURE_ID);
+}
+
+bool captureFromBuffer(const uint16_t *src, uint16_t width, uint16_t height, int16_t offsetX, int16_t offsetY) {
+  if (!src) return false;
+
+  uint16_t *pixelsPtr = beginCapture(width, height, offsetX, offsetY);
+  if (!pixelsPtr) return false;
+
+  // Copy pixel data, converting to wire byte order
+  size_t pixels = (size_t)width * (size_t)height;
+  for (size_t i = 0; i < pixels; ++i) {
+    pixelsPtr[i] = (uint16_t)((src[i] >> 8) | (src[i] << 8));
+  }
+
+  commitCapture();
+  return true;
+}
+
+bool captureFromDisplay(Adafruit_ST7735 &tft, uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+  // Many ST7735 drivers (including common Adafruit_ST7735) don't implement a readPixel API.
+  // Implementing a generic read-back is driver-dependent and can be slow. This function attempts
+  // to provide a hook but will return false to indicate unsupported on this platform.
+  (void)tft; (void)x; (void)y; (void)width; (void)height;
+  return false; // Not supported in this reference implementation.
+}
+
+bool restoreToDisplay(Adafruit_ST7735 &tft) {
+  const SnapshotHeader *hdr = getSnapshotHeader();
+  if (!hdr) return false;
+  uint16_t *pixelsPtr = (uint16_t*)((uint8_t*)hdr + sizeof(SnapshotHeader));
+
+  // Clip once against the display, then write each row's visible span with a single window
+  int colStart = max(0, -(int)hdr->offsetX);
+  int colEnd = min((int)hdr->width, (int)tft.width() - hdr->offsetX);
+  int rowStart = max(0, -(int)hdr->offsetY);
+  int rowEnd = min((int)hdr->height, (int)tft.height() - hdr->offsetY);
+  if (colStart >= colEnd || rowStart >= rowEnd) return true;  // Entirely off-screen
+
+  int spanWidth = colEnd - colStart;
+  tft.startWrite();
+  if (spanWidth == hdr->width) {
+    // Full rows visible: the block is contiguous, one window
+    tft.setAddrWindow(hdr->offsetX, hdr->offsetY + rowStart, spanWidth, rowEnd - rowStart);
+    tft.writePixels(pixelsPtr + rowStart * hdr->width, (uint32_t)spanWidth * (rowEnd - rowStart), true, true);
+  } else {
+    for (int r = rowStart; r < rowEnd; ++r) {
+      tft.setAddrWindow(hdr->offsetX + colStart, hdr->offsetY + r, spanWidth, 1);
+      tft.writePixels(pixelsPtr + r * hdr->width + colStart, spanWidth, true, true);
+    }
+  }
+  tft.endWrite();
+  return true;
+}
+
+void discardSnapshot() {
+  ImageCache::remove(IMAGE_CACHE_CAPTURE_ID);
+  ImageCache::remove(IMAGE_CACHE_SNAPSHOT_ID);
+}
+
+} // namespace DisplaySnapshot
@@ -0,0 +1,74 @@
+#ifndef DISPLAY_SNAPSHOT_H
+#define DISPLAY_SNAPSHOT_H
+
+#include <Arduino.h>
+#include <Adafruit_ST7735.h>
+#include <stdint.h>
+
+// Snapshot flags
+static const uint16_t SNAPSHOT_CENTERED = 0x0001;  // Image was centred in the usable area (re-centre on restore)
+static const uint16_t SNAPSHOT_FITTED = 0x0002;    // Also turned/scaled per display (re-fit on restore)
+
+// Snapshot header stored at the start of the snapshot block
+struct SnapshotHeader {
+  uint16_t width;   // captured width (pixels)
+  uint16_t height;  // captured height (pixels)
+  int16_t  offsetX; // x offset where the rectangle was drawn on the display
+  int16_t  offsetY; // y offset where the rectangle was drawn on the display
+  uint16_t flags;   // SNAPSHOT_* flags
+};
+
+// Lightweight API for capturing/restoring a rectangular snapshot of pixels.
+// Implementation stores one ImageCache entry (IMAGE_CACHE_SNAPSHOT_ID): [SnapshotHeader][uint16_t pixels...]
+// so the snapshot lives in the fixed cache arena instead of the heap. It only takes free arena
+// space: host images are never evicted for it, and a host store may evict the snapshot.
+// Pixels are kept in wire (big-endian) byte order so they can be pushed to a panel as-is.
+// - beginCapture()/commitCapture() let a receiver write pixels straight into a new snapshot,
+//   kept beside the current one (IMAGE_CACHE_CAPTURE_ID) and swapped in only when the frame
+//   is good; abortCapture() drops it again
+// - captureFromBuffer() copies pixels from an existing in-memory buffer
+// - captureFromDisplay() is provided but may be unsupported depending on your driver
+// - restoreToDisplay() draws pixels back with one clipped address window per row
+
+namespace DisplaySnapshot {
+
+// Returns true if a complete snapshot is currently stored in RAM
+bool hasSnapshot();
+
+// Start capturing a width x height image drawn at (offsetX, offsetY). Returns the pixel
+// storage (row-major, wire byte order) the caller fills in, or nullptr if it does not fit.
+// The previous snapshot stays until commitCapture(), unless free space only holds one of
+// them (a full-panel image is most of the arena): then the capture takes its place.
+// The storage stays valid until the next ImageCache::begin().
+uint16_t *beginCapture(uint16_t width, uint16_t height, int16_t offsetX, int16_t offsetY, uint16_t flags = 0);
+
+// Replace the snapshot with the capture started by beginCapture().
+void commitCapture();
+
+// Drop the capture started by beginCapture(), keeping the previous snapshot.
+void abortCapture();
+
+// Capture pixels from an existing buffer (row-major uint16_t RGB565, native byte order).
+// src points to width*height uint16_t elements. The function makes an internal copy.
+bool captureFromBuffer(const uint16_t *src, uint16_t width, uint16_t height, int16_t offsetX, int16_t offsetY);
+
+// Attempt to capture pixels directly from the display. Many ST7735 drivers do not support reading
+// pixels back; this function may fail and return false on those setups. If successful, a snapshot is stored.
+bool captureFromDisplay(Adafruit_ST7735 &tft, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+// Restore the stored snapshot to the provided display instance at its captured offset.
+// Returns true on success.
+bool restoreToDisplay(Adafruit_ST7735 &tft);
+
+// Discard any stored snapshot and release its cache space.
+void discardSnapshot();
+
+// Return a pointer to the snapshot header (read-only) or nullptr if no snapshot present.
+const SnapshotHeader *getSnapshotHeader();
+
+// Return the snapshot pixels (wire byte order) or nullptr if no snapshot present.
+const uint16_t *getSnapshotPixels();
+
+} // namespace DisplaySnapshot
+
+#endif // DISPLAY_SNAPSHOT_H
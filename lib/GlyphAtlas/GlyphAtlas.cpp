@@ -0,0 +1,174 @@
+#include "GlyphAtlas.h"
+#include <string.h>
+
+// Opaque text row blocks, in wire byte order. Two alternate so the next block
+// is rendered while the previous one is DMA'd (at most one push is in flight)
+static const int TEXT_BUFFER_PIXELS = 512;
+static uint16_t g_textBuffers[2][TEXT_BUFFER_PIXELS];
+static uint8_t g_textBufferIndex = 0;
+
+static inline uint32_t glyphBytes(uint8_t width, uint8_t height) {
+  return (uint32_t)((width + 7) / 8) * height;
+}
+
+static inline bool glyphPixel(const uint8_t *bits, int column) {
+  return bits[column >> 3] & (0x80 >> (column & 7));
+}
+
+bool GlyphAtlas::isValid(const uint8_t *data, uint32_t length) {
+  if (!data || length < sizeof(GlyphAtlasHeader)) return false;
+  const GlyphAtlasHeader *hdr = (const GlyphAtlasHeader *)data;
+  if (hdr->magic != GLYPH_ATLAS_MAGIC || hdr->glyphCount == 0 ||
+      hdr->height == 0 || hdr->height > GLYPH_ATLAS_MAX_HEIGHT || hdr->spacing > GLYPH_ATLAS_MAX_WIDTH ||
+      hdr->firstChar + hdr->glyphCount > 256) {
+    return false;
+  }
+  if (length < sizeof(GlyphAtlasHeader) + hdr->glyphCount) return false;
+
+  // Every glyph bitmap has to lie inside the entry
+  const uint8_t *widthTable = data + sizeof(GlyphAtlasHeader);
+  uint32_t bitmapBytes = 0;
+  for (uint8_t i = 0; i < hdr->glyphCount; ++i) {
+    if (widthTable[i] > GLYPH_ATLAS_MAX_WIDTH) return false;
+    bitmapBytes += glyphBytes(widthTable[i], hdr->height);
+  }
+  return bitmapBytes <= length - sizeof(GlyphAtlasHeader) - hdr->glyphCount;
+}
+
+bool GlyphAtlas::load(const uint8_t *data, uint32_t length) {
+  if (!isValid(data, length)) {
+    header = nullptr;
+    return false;
+  }
+  header = (const GlyphAtlasHeader *)data;
+  widths = data + sizeof(GlyphAtlasHeader);
+  bitmaps = widths + header->glyphCount;
+  return true;
+}
+
+GlyphAtlas GlyphAtlas::builtin() {
+  GlyphAtlas atlas;
+  atlas.load(GLYPH_ATLAS_BUILTIN_DATA, GLYPH_ATLAS_BUILTIN_LENGTH);
+  return atlas;
+}
+
+bool GlyphAtlas::findGlyph(uint8_t code, uint8_t &width, const uint8_t *&rows) const {
+  if (!header) return false;
+  int index = code - header->firstChar;
+  if (index < 0 || index >= header->glyphCount) {
+    index = header->fallback - header->firstChar;
+    if (index < 0 || index >= header->glyphCount) return false;
+  }
+
+  // Glyphs are variable width: skip the bitmaps before this one
+  const uint8_t *bits = bitmaps;
+  for (int i = 0; i < index; ++i) {
+    bits += glyphBytes(widths[i], header->height);
+  }
+  width = widths[index];
+  rows = bits;
+  return true;
+}
+
+bool GlyphText::layout(const GlyphAtlas &atlas, const char *text, size_t length, uint8_t textScale) {
+  count = 0;
+  width = 0;
+  height = 0;
+  if (!atlas.isLoaded() || length == 0 || length > MAX_LENGTH ||
+      textScale == 0 || textScale > MAX_SCALE) {
+    return false;
+  }
+
+  // Characters with no glyph (and no fallback) are skipped
+  scale = textScale;
+  for (size_t i = 0; i < length; ++i) {
+    PlacedGlyph &glyph = glyphs[count];
+    if (!atlas.findGlyph((uint8_t)text[i], glyph.width, glyph.rows)) continue;
+    glyph.advance = glyph.width + atlas.getSpacing();
+    width += glyph.advance;
+    count++;
+  }
+  if (count == 0) return false;
+
+  glyphs[count - 1].advance = glyphs[count - 1].width;
+  width = (width - atlas.getSpacing()) * scale;
+  height = atlas.getHeight() * scale;
+  return width > 0;
+}
+
+void GlyphText::renderRow(int row, int colStart, int colEnd, uint16_t on, uint16_t off, uint16_t *out) const {
+  int x = 0;
+  for (uint8_t i = 0; i < count && x < colEnd; ++i) {
+    const PlacedGlyph &glyph = glyphs[i];
+    int span = glyph.advance * scale;
+    if (x + span > colStart) {
+      const uint8_t *bits = glyph.rows + row * ((glyph.width + 7) / 8);
+      int last = min(colEnd, x + span);
+      for (int px = max(colStart, x); px < last; ++px) {
+        int column = (px - x) / scale;
+        *out++ = (column < glyph.width && glyphPixel(bits, column)) ? on : off;
+      }
+    }
+    x += span;
+  }
+}
+
+void GlyphText::draw(const DisplayTarget &target, uint16_t foreground, uint16_t background, bool opaque) const {
+  int spanWidth = min(target.colEnd - target.colStart, TEXT_BUFFER_PIXELS);
+  if (count == 0 || spanWidth <= 0 || target.rowStart >= target.rowEnd) return;
+
+  if (opaque) {
+    // Row blocks through one address window each; scaled rows repeat the row above
+    uint16_t on = (foreground >> 8) | (foreground << 8);
+    uint16_t off = (background >> 8) | (background << 8);
+    int blockRows = TEXT_BUFFER_PIXELS / spanWidth;
+    for (int y = target.rowStart; y < target.rowEnd; y += blockRows) {
+      int rows = min(blockRows, target.rowEnd - y);
+      uint16_t *block = g_textBuffers[g_textBufferIndex];
+      g_textBufferIndex ^= 1;
+      for (int r = 0; r < rows; ++r) {
+        uint16_t *line = block + r * spanWidth;
+        if (r > 0 && (y + r) / scale == (y + r - 1) / scale) {
+          memcpy(line, line - spanWidth, spanWidth * sizeof(uint16_t));
+        } else {
+          renderRow((y + r) / scale, target.colStart, target.colStart + spanWidth, on, off, line);
+        }
+      }
+      target.display->pushPixelsAsync(target.originX + target.colStart, target.originY + y,
+                                      spanWidth, rows, block);
+    }
+    return;
+  }
+
+  // Transparent: one fillRect per horizontal foreground run, scale rows tall
+  int colEnd = target.colStart + spanWidth;
+  for (int y = target.rowStart; y < target.rowEnd; ) {
+    int row = y / scale;
+    int rowEnd = min((row + 1) * scale, (int)target.rowEnd);
+    int runStart = -1;
+    int runEnd = -1;
+    int x = 0;
+    for (uint8_t i = 0; i < count && x < colEnd; ++i) {
+      const PlacedGlyph &glyph = glyphs[i];
+      const uint8_t *bits = glyph.rows + row * ((glyph.width + 7) / 8);
+      for (int column = 0; column < glyph.width; ++column) {
+        if (!glyphPixel(bits, column)) continue;
+        int left = max(x + column * scale, (int)target.colStart);
+        int right = min(x + (column + 1) * scale, colEnd);
+        if (left >= right) continue;
+        if (left != runEnd) {
+          if (runStart >= 0) {
+            target.display->fillRect(target.originX + runStart, target.originY + y, runEnd - runStart, rowEnd - y, foreground);
+          }
+          runStart = left;
+        }
+        runEnd = right;
+      }
+      x += glyph.advance * scale;
+    }
+    if (runStart >= 0) {
+      target.display->fillRect(target.originX + runStart, target.originY + y, runEnd - runStart, rowEnd - y, foreground);
+    }
+    y = rowEnd;
+  }
+}
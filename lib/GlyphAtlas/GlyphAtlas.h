@@ -0,0 +1,104 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "DisplayManager.h"
+
+// 1-bit glyph atlases and a text renderer for overlay labels.
+// Text is rasterised on the device straight into the panel, so a changing
+// label costs the command bytes instead of a re-encoded image upload.
+//
+// Atlas layout (produced by st7735_tools/glyph_atlas.py):
+//   [GlyphAtlasHeader][glyphCount width bytes][glyph bitmaps]
+//   Each glyph is `height` rows of (width + 7) / 8 bytes, most significant
+//   bit = leftmost pixel, glyphs stored in code order from firstChar.
+// A built-in 5x7 font lives in flash; uploaded atlases are ImageCache
+// entries (BIN_OP_CACHE_STORE with BIN_ENC_GLYPH_ATLAS) viewed in place.
+
+static const uint8_t GLYPH_ATLAS_MAGIC = 0x47;        // 'G'
+static const uint8_t GLYPH_ATLAS_MAX_WIDTH = 32;
+static const uint8_t GLYPH_ATLAS_MAX_HEIGHT = 32;
+static const uint8_t GLYPH_ATLAS_BUILTIN_ID = 0xFF;   // Atlas id selecting the built-in font
+
+struct GlyphAtlasHeader {
+  uint8_t magic;       // GLYPH_ATLAS_MAGIC
+  uint8_t firstChar;   // Character code of glyph 0
+  uint8_t glyphCount;
+  uint8_t height;      // Rows per glyph (1..GLYPH_ATLAS_MAX_HEIGHT)
+  uint8_t spacing;     // Blank columns between glyphs (0..GLYPH_ATLAS_MAX_WIDTH)
+  uint8_t fallback;    // Code drawn for characters outside the atlas
+  uint8_t reserved[2];
+};
+
+static_assert(sizeof(GlyphAtlasHeader) == 8, "GlyphAtlasHeader must be 8 bytes");
+
+// Built-in font bytes (GlyphAtlasFont.cpp, generated by glyph_atlas.py --c-array)
+extern const uint8_t GLYPH_ATLAS_BUILTIN_DATA[];
+extern const uint32_t GLYPH_ATLAS_BUILTIN_LENGTH;
+
+// Read-only view of atlas bytes (not copied: cache entries must not move
+// while it is used, i.e. no ImageCache::begin() in between)
+class GlyphAtlas {
+public:
+  GlyphAtlas() : header(nullptr), widths(nullptr), bitmaps(nullptr) {}
+
+  // Point at data; false (and unloaded) if it is not a well-formed atlas
+  bool load(const uint8_t *data, uint32_t length);
+  static bool isValid(const uint8_t *data, uint32_t length);
+
+  // The built-in 5x7 font (7 rows plus a blank row, 1 column spacing)
+  static GlyphAtlas builtin();
+
+  bool isLoaded() const { return header != nullptr; }
+  uint8_t getHeight() const { return header ? header->height : 0; }
+  uint8_t getSpacing() const { return header ? header->spacing : 0; }
+
+  // Glyph for code, or the fallback glyph outside the atlas; false if neither exists
+  bool findGlyph(uint8_t code, uint8_t &width, const uint8_t *&rows) const;
+
+private:
+  const GlyphAtlasHeader *header;
+  const uint8_t *widths;
+  const uint8_t *bitmaps;
+};
+
+// One line of text laid out with an atlas, drawn onto any number of displays
+class GlyphText {
+public:
+  static const size_t MAX_LENGTH = 128;     // Characters per line
+  static const uint8_t MAX_SCALE = 8;       // Integer magnification
+
+  GlyphText() : count(0), scale(1), width(0), height(0) {}
+
+  // Look up every glyph once; false if nothing can be drawn (empty, too long, bad scale)
+  bool layout(const GlyphAtlas &atlas, const char *text, size_t length, uint8_t scale);
+
+  // Text box in pixels (advance of every glyph minus the trailing spacing, times scale)
+  int getWidth() const { return width; }
+  int getHeight() const { return height; }
+
+  // Draw onto target (originX/originY = text box corner) after clipTarget() for
+  // getWidth() x getHeight(). Colours are native RGB565. Opaque text fills the
+  // box with background and goes out as DMA row blocks; transparent text only
+  // writes the foreground runs. The last block may still be in flight on return.
+  void draw(const DisplayTarget &target, uint16_t foreground, uint16_t background, bool opaque) const;
+
+private:
+  struct PlacedGlyph {
+    const uint8_t *rows;
+    uint8_t width;
+    uint8_t advance;   // width plus spacing (none after the last glyph)
+  };
+
+  PlacedGlyph glyphs[MAX_LENGTH];
+  uint8_t count;
+  uint8_t scale;
+  int width;
+  int height;
+
+  // Pixels [colStart, colEnd) of glyph row `row`, in wire byte order
+  void renderRow(int row, int colStart, int colEnd, uint16_t on, uint16_t off, uint16_t *out) const;
+};
+
+#endif // GLYPH_ATLAS_H
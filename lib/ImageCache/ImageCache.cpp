@@ -0,0 +1,186 @@
+#include "ImageCache.h"
+#include <string.h>
+
+// Arena storage (word aligned so entries can hold uint16_t pixels)
+static uint32_t g_arena[(ImageCache::ARENA_BYTES + 3) / 4];
+static CachedImage g_entries[ImageCache::MAX_ENTRIES];
+static uint8_t g_count = 0;
+static uint32_t g_clock = 0;
+
+static inline uint8_t *arenaBytes() {
+  return (uint8_t*)g_arena;
+}
+
+static inline uint32_t alignedLength(uint32_t length) {
+  return (length + 3) & ~3UL;
+}
+
+static int findIndex(uint16_t id) {
+  for (uint8_t i = 0; i < g_count; ++i) {
+    if (g_entries[i].id == id) return i;
+  }
+  return -1;
+}
+
+static void removeIndex(int index) {
+  g_entries[index] = g_entries[--g_count];
+}
+
+// End of the highest entry (allocation point when appending)
+static uint32_t arenaEnd() {
+  uint32_t end = 0;
+  for (uint8_t i = 0; i < g_count; ++i) {
+    uint32_t entryEnd = g_entries[i].offset + alignedLength(g_entries[i].length);
+    if (entryEnd > end) end = entryEnd;
+  }
+  return end;
+}
+
+// Slide every entry down so free space is one block at the end
+static void compact() {
+  // Insertion sort by offset (at most MAX_ENTRIES entries)
+  for (uint8_t i = 1; i < g_count; ++i) {
+    CachedImage entry = g_entries[i];
+    int j = i - 1;
+    while (j >= 0 && g_entries[j].offset > entry.offset) {
+      g_entries[j + 1] = g_entries[j];
+      --j;
+    }
+    g_entries[j + 1] = entry;
+  }
+
+  uint32_t next = 0;
+  for (uint8_t i = 0; i < g_count; ++i) {
+    CachedImage &entry = g_entries[i];
+    if (entry.offset != next) {
+      memmove(arenaBytes() + next, arenaBytes() + entry.offset, entry.length);
+      entry.offset = next;
+    }
+    next += alignedLength(entry.length);
+  }
+}
+
+// Evict the least recently used complete entry; false if none left
+static bool evictOldest() {
+  int oldest = -1;
+  for (uint8_t i = 0; i < g_count; ++i) {
+    if (g_entries[i].complete && (oldest < 0 || g_entries[i].lastUsed < g_entries[oldest].lastUsed)) {
+      oldest = i;
+    }
+  }
+  if (oldest < 0) return false;
+  removeIndex(oldest);
+  return true;
+}
+
+namespace ImageCache {
+
+uint8_t *begin(uint16_t id, uint16_t width, uint16_t height, uint8_t encoding, uint32_t length,
+               bool evict) {
+  // Drop the previous version of this id and any abandoned fill
+  for (int i = g_count - 1; i >= 0; --i) {
+    if (g_entries[i].id == id || !g_entries[i].complete) {
+      removeIndex(i);
+    }
+  }
+
+  uint32_t needed = alignedLength(length);
+  if (length == 0 || needed > ARENA_BYTES) return nullptr;
+
+  while (g_count >= MAX_ENTRIES || ARENA_BYTES - getUsedBytes() < needed) {
+    if (!evict || !evictOldest()) return nullptr;
+  }
+  if (ARENA_BYTES - arenaEnd() < needed) {
+    compact();
+  }
+
+  uint32_t offset = arenaEnd();
+  CachedImage &entry = g_entries[g_count++];
+  entry.id = id;
+  entry.encoding = encoding;
+  entry.width = width;
+  entry.height = height;
+  entry.complete = false;
+  entry.offset = offset;
+  entry.length = length;
+  entry.lastUsed = ++g_clock;
+  return arenaBytes() + entry.offset;
+}
+
+void commit(uint16_t id) {
+  int index = findIndex(id);
+  if (index >= 0) {
+    g_entries[index].complete = true;
+    g_entries[index].lastUsed = ++g_clock;
+  }
+}
+
+bool rename(uint16_t from, uint16_t to) {
+  int index = findIndex(from);
+  if (index < 0) return false;
+  int replaced = findIndex(to);
+  if (replaced >= 0) {
+    removeIndex(replaced);
+    // removeIndex() moved the last entry into the freed slot
+    if (index == g_count) index = replaced;
+  }
+  g_entries[index].id = to;
+  return true;
+}
+
+const CachedImage *find(uint16_t id) {
+  int index = findIndex(id);
+  if (index < 0 || !g_entries[index].complete) return nullptr;
+  g_entries[index].lastUsed = ++g_clock;
+  return &g_entries[index];
+}
+
+const uint8_t *getData(const CachedImage *image) {
+  return image ? arenaBytes() + image->offset : nullptr;
+}
+
+bool remove(uint16_t id) {
+  int index = findIndex(id);
+  if (index < 0) return false;
+  removeIndex(index);
+  return true;
+}
+
+void clear() {
+  g_count = 0;
+}
+
+uint8_t getCount() {
+  return g_count;
+}
+
+uint32_t getUsedBytes() {
+  uint32_t used = 0;
+  for (uint8_t i = 0; i < g_count; ++i) {
+    used += alignedLength(g_entries[i].length);
+  }
+  return used;
+}
+
+uint32_t getFreeBytes() {
+  return ARENA_BYTES - getUsedBytes();
+}
+
+void list(Stream &out) {
+  for (uint8_t i = 0; i < g_count; ++i) {
+    const CachedImage &entry = g_entries[i];
+    if (!entry.complete) continue;
+    out.print("id:");
+    out.print(entry.id);
+    out.print(" ");
+    out.print(entry.width);
+    out.print("x");
+    out.print(entry.height);
+    out.print(" enc:");
+    out.print(entry.encoding);
+    out.print(" bytes:");
+    out.println(entry.length);
+  }
+}
+
+} // namespace ImageCache
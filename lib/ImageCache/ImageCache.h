@@ -0,0 +1,79 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Fixed SRAM arena holding several encoded images keyed by host-assigned ids.
+// No heap allocation: entries are packed into one static block, the least
+// recently used entries are evicted when space runs out and the arena is
+// compacted (entries slid down) when free space is fragmented.
+//
+// Images are stored exactly as they arrive on the wire (raw RGB565
+// big-endian, RLE or QOI - see PixelDecoder.h) so a cached frame costs its
+// compressed size. Pointers returned by begin()/getData() stay valid until
+// the next begin() call, which may move entries.
+//
+// Host ids are 0-254. The firmware keeps its own entries (the CMD:SNAPSHOT
+// image) under ids above that range; those are filled with begin(..., false)
+// so they only take free space and never evict host images.
+
+#ifndef IMAGE_CACHE_ARENA_BYTES
+#define IMAGE_CACHE_ARENA_BYTES (48UL * 1024UL)
+#endif
+
+// Reserved id for the last received full image (DisplaySnapshot)
+static const uint16_t IMAGE_CACHE_SNAPSHOT_ID = 0xFF;
+// Snapshot being captured, renamed to IMAGE_CACHE_SNAPSHOT_ID once its frame is good
+static const uint16_t IMAGE_CACHE_CAPTURE_ID = 0x100;
+
+struct CachedImage {
+  uint16_t id;
+  uint8_t  encoding;   // BinaryEncoding of the stored bytes (or format owner's own)
+  uint16_t width;
+  uint16_t height;
+  bool     complete;   // false while being filled
+  uint32_t offset;     // Byte offset into the arena (4-byte aligned)
+  uint32_t length;     // Stored bytes
+  uint32_t lastUsed;   // LRU clock value
+};
+
+namespace ImageCache {
+
+static const uint8_t MAX_ENTRIES = 16;
+static const uint32_t ARENA_BYTES = IMAGE_CACHE_ARENA_BYTES;
+
+// Reserve length bytes for image id (replacing any existing entry with that id),
+// evicting least recently used entries as needed (none with evict = false).
+// Returns the storage to fill or nullptr if the image cannot fit. Any other
+// incomplete entry is dropped.
+uint8_t *begin(uint16_t id, uint16_t width, uint16_t height, uint8_t encoding, uint32_t length,
+               bool evict = true);
+
+// Mark the entry started by begin() as complete and usable.
+void commit(uint16_t id);
+
+// Give entry from the id to, replacing any entry already there; false if from is absent.
+bool rename(uint16_t from, uint16_t to);
+
+// Look up a complete entry (marks it most recently used); nullptr if absent.
+const CachedImage *find(uint16_t id);
+
+// Stored bytes of an entry returned by find().
+const uint8_t *getData(const CachedImage *image);
+
+// Drop one entry / everything.
+bool remove(uint16_t id);
+void clear();
+
+// Statistics
+uint8_t getCount();
+uint32_t getUsedBytes();
+uint32_t getFreeBytes();
+
+// Print one line per entry ("id:<n> <w>x<h> enc:<e> bytes:<len>")
+void list(Stream &out);
+
+} // namespace ImageCache
+
+#endif // IMAGE_CACHE_H
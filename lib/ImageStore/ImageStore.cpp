@@ -0,0 +1,498 @@
+#include "ImageStore.h"
+#include <SPI.h>
+#include <string.h>
+#include "DisplayManager.h"
+
+// SPI NOR commands (common to W25Qxx, AT25SF, MX25L, ...)
+static const uint8_t FLASH_READ = 0x03;
+static const uint8_t FLASH_PAGE_PROGRAM = 0x02;
+static const uint8_t FLASH_SECTOR_ERASE = 0x20;
+static const uint8_t FLASH_WRITE_ENABLE = 0x06;
+static const uint8_t FLASH_READ_STATUS = 0x05;
+static const uint8_t FLASH_JEDEC_ID = 0x9F;
+static const uint8_t FLASH_RELEASE_POWER_DOWN = 0xAB;
+static const uint8_t FLASH_STATUS_BUSY = 0x01;
+
+static const unsigned long FLASH_ERASE_TIMEOUT_MS = 500;
+static const unsigned long FLASH_PROGRAM_TIMEOUT_MS = 10;
+
+// Slot states: programmed once, then only cleared
+static const uint8_t SLOT_FREE = 0xFF;
+static const uint8_t SLOT_VALID = 0x5A;
+static const uint8_t SLOT_DELETED = 0x00;
+
+static const char STORE_MAGIC[8] = { 'S', 'T', '7', '7', '3', '5', 'I', 'S' };
+static const uint16_t STORE_VERSION = 1;
+
+struct StoreHeader {
+  char     magic[8];
+  uint16_t version;
+  uint8_t  reserved[22];
+};
+
+static_assert(sizeof(StoredImage) == 32, "StoredImage must fill one index slot");
+static_assert(sizeof(StoreHeader) == sizeof(StoredImage), "Header must fill one index slot");
+
+static bool g_present = false;     // Flash answered the JEDEC id
+static bool g_mounted = false;     // ...and holds a store index
+static uint32_t g_jedecId = 0;
+static uint32_t g_capacity = 0;
+static uint32_t g_dataEnd = ImageStore::SECTOR_BYTES;  // End of the last entry's data
+static uint8_t g_count = 0;        // Valid slots
+static uint8_t g_slotsUsed = 0;    // Valid and deleted slots (always the first ones)
+
+// Entry being written
+static bool g_writing = false;
+static StoredImage g_open;
+static uint32_t g_writeAddress = 0;
+
+#ifdef ST7735_IMAGE_STORE
+static uint8_t g_chunk[ImageStore::CHUNK_BYTES];
+static SPISettings g_settings(IMAGE_STORE_SPI_FREQUENCY, MSBFIRST, SPI_MODE0);
+#endif
+
+// --- Flash access --------------------------------------------------------
+
+#ifdef ST7735_IMAGE_STORE
+static void select() {
+  // The panels' last DMA push holds the bus (and its CS) until completed
+  DisplayInstance::finishPendingPush();
+  SPI.beginTransaction(g_settings);
+  digitalWrite(IMAGE_STORE_CS, LOW);
+}
+
+static void deselect() {
+  digitalWrite(IMAGE_STORE_CS, HIGH);
+  SPI.endTransaction();
+}
+
+static void sendCommand(uint8_t command, uint32_t address) {
+  SPI.transfer(command);
+  SPI.transfer((uint8_t)(address >> 16));
+  SPI.transfer((uint8_t)(address >> 8));
+  SPI.transfer((uint8_t)address);
+}
+
+static void flashRead(uint32_t address, void *buffer, size_t length) {
+  memset(buffer, 0xFF, length);
+  select();
+  sendCommand(FLASH_READ, address);
+  SPI.transfer(buffer, length);
+  deselect();
+}
+
+static bool waitReady(unsigned long timeoutMs) {
+  // Status register 1 repeats for as long as CS stays low
+  unsigned long start = millis();
+  select();
+  SPI.transfer(FLASH_READ_STATUS);
+  bool ready = true;
+  while (SPI.transfer(0xFF) & FLASH_STATUS_BUSY) {
+    if (millis() - start > timeoutMs) {
+      ready = false;
+      break;
+    }
+  }
+  deselect();
+  return ready;
+}
+
+static void writeEnable() {
+  select();
+  SPI.transfer(FLASH_WRITE_ENABLE);
+  deselect();
+}
+
+static bool eraseSector(uint32_t address) {
+  writeEnable();
+  select();
+  sendCommand(FLASH_SECTOR_ERASE, address);
+  deselect();
+  return waitReady(FLASH_ERASE_TIMEOUT_MS);
+}
+
+// Program bytes that may span pages (the chip wraps within a page otherwise)
+static bool flashProgram(uint32_t address, const void *data, uint32_t length) {
+  const uint8_t *bytes = (const uint8_t*)data;
+  while (length) {
+    uint32_t chunk = ImageStore::PAGE_BYTES - address % ImageStore::PAGE_BYTES;
+    if (chunk > length) chunk = length;
+    writeEnable();
+    select();
+    sendCommand(FLASH_PAGE_PROGRAM, address);
+    for (uint32_t i = 0; i < chunk; ++i) {
+      SPI.transfer(bytes[i]);
+    }
+    deselect();
+    if (!waitReady(FLASH_PROGRAM_TIMEOUT_MS)) return false;
+    address += chunk;
+    bytes += chunk;
+    length -= chunk;
+  }
+  return true;
+}
+#else
+static void flashRead(uint32_t, void *buffer, size_t length) { memset(buffer, 0xFF, length); }
+static bool eraseSector(uint32_t) { return false; }
+static bool flashProgram(uint32_t, const void *, uint32_t) { return false; }
+#endif
+
+// --- Index ---------------------------------------------------------------
+
+static inline uint32_t slotAddress(uint8_t index) {
+  return (uint32_t)(index + 1) * sizeof(StoredImage);
+}
+
+static void readSlot(uint8_t index, StoredImage &entry) {
+  flashRead(slotAddress(index), &entry, sizeof(entry));
+}
+
+static bool sameName(const StoredImage &entry, const char *name) {
+  return strncmp(entry.name, name, sizeof(entry.name)) == 0;
+}
+
+// Newest valid slot holding name (a replace interrupted before the old slot
+// was deleted leaves two), or -1
+static int findSlot(const char *name, StoredImage &entry) {
+  int found = -1;
+  StoredImage slot;
+  for (uint8_t i = 0; i < g_slotsUsed; ++i) {
+    readSlot(i, slot);
+    if (slot.state == SLOT_VALID && sameName(slot, name)) {
+      entry = slot;
+      found = i;
+    }
+  }
+  return found;
+}
+
+static void scan() {
+  g_count = 0;
+  g_slotsUsed = 0;
+  g_dataEnd = ImageStore::SECTOR_BYTES;
+  StoredImage slot;
+  for (uint8_t i = 0; i < ImageStore::MAX_ENTRIES; ++i) {
+    readSlot(i, slot);
+    if (slot.state == SLOT_FREE) break;
+    g_slotsUsed = i + 1;
+    if (slot.state != SLOT_VALID) continue;
+    g_count++;
+    if (slot.offset + slot.length > g_dataEnd) g_dataEnd = slot.offset + slot.length;
+  }
+}
+
+static bool markDeleted(uint8_t index) {
+  uint8_t state = SLOT_DELETED;
+  return flashProgram(slotAddress(index), &state, 1);
+}
+
+static bool validName(const char *name) {
+  size_t length = strlen(name);
+  if (length == 0 || length > ImageStore::MAX_NAME) return false;
+  for (size_t i = 0; i < length; ++i) {
+    char c = name[i];
+    if (!isalnum((unsigned char)c) && c != '_' && c != '-' && c != '.') return false;
+  }
+  return true;
+}
+
+// True when [address, end) reads back as erased flash
+static bool isErased(uint32_t address, uint32_t end) {
+  uint8_t buffer[64];
+  while (address < end) {
+    uint32_t chunk = end - address < sizeof(buffer) ? end - address : sizeof(buffer);
+    flashRead(address, buffer, chunk);
+    for (uint32_t i = 0; i < chunk; ++i) {
+      if (buffer[i] != 0xFF) return false;
+    }
+    address += chunk;
+  }
+  return true;
+}
+
+// Append to the open entry, erasing each sector as the write enters it
+static StoreStatus writeBytes(const void *data, uint32_t length) {
+  if (g_writeAddress + length > g_capacity) return STORE_FULL;
+  const uint8_t *bytes = (const uint8_t*)data;
+  while (length) {
+    if (g_writeAddress % ImageStore::SECTOR_BYTES == 0 && !eraseSector(g_writeAddress)) {
+      return STORE_IO_ERROR;
+    }
+    uint32_t chunk = ImageStore::SECTOR_BYTES - g_writeAddress % ImageStore::SECTOR_BYTES;
+    if (chunk > length) chunk = length;
+    if (!flashProgram(g_writeAddress, bytes, chunk)) return STORE_IO_ERROR;
+    g_writeAddress += chunk;
+    bytes += chunk;
+    length -= chunk;
+  }
+  return STORE_OK;
+}
+
+namespace ImageStore {
+
+bool begin() {
+#ifdef ST7735_IMAGE_STORE
+  abortEntry();
+  pinMode(IMAGE_STORE_CS, OUTPUT);
+  digitalWrite(IMAGE_STORE_CS, HIGH);
+  select();
+  SPI.transfer(FLASH_RELEASE_POWER_DOWN);
+  deselect();
+  delayMicroseconds(50);
+
+  uint8_t id[3];
+  select();
+  SPI.transfer(FLASH_JEDEC_ID);
+  for (uint8_t i = 0; i < 3; ++i) {
+    id[i] = SPI.transfer(0xFF);
+  }
+  deselect();
+  g_jedecId = ((uint32_t)id[0] << 16) | ((uint32_t)id[1] << 8) | id[2];
+
+  // Capacity byte is log2(bytes); 3-byte addressing reaches 16MB
+  g_present = id[0] != 0x00 && id[0] != 0xFF && id[2] >= 0x10 && id[2] <= 0x18;
+  g_mounted = false;
+  if (!g_present) return false;
+  g_capacity = 1UL << id[2];
+
+  StoreHeader header;
+  flashRead(0, &header, sizeof(header));
+  if (memcmp(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC)) == 0 && header.version == STORE_VERSION) {
+    g_mounted = true;
+    scan();
+    return true;
+  }
+
+  // A blank chip becomes a store; anything else waits for an explicit format()
+  const uint8_t *bytes = (const uint8_t*)&header;
+  for (size_t i = 0; i < sizeof(header); ++i) {
+    if (bytes[i] != 0xFF) return false;
+  }
+  return format() == STORE_OK;
+#else
+  return false;
+#endif
+}
+
+bool isMounted() {
+  return g_mounted;
+}
+
+bool find(const char *name, StoredImage &entry) {
+  return g_mounted && findSlot(name, entry) >= 0;
+}
+
+const uint8_t *readChunk(uint32_t address, size_t length) {
+#ifdef ST7735_IMAGE_STORE
+  if (!g_mounted || length > CHUNK_BYTES) return nullptr;
+  flashRead(address, g_chunk, length);
+  return g_chunk;
+#else
+  return nullptr;
+#endif
+}
+
+StoreStatus beginEntry(const char *name, uint8_t kind, uint16_t frameDelayMs) {
+  abortEntry();
+  if (!g_mounted) return STORE_NOT_MOUNTED;
+  if (!validName(name)) return STORE_BAD_NAME;
+  if (g_slotsUsed >= MAX_ENTRIES) return STORE_NO_SLOT;
+
+  // New entries start on a fresh sector: nothing past the committed data is
+  // assumed erased (an interrupted write may have left bytes there)
+  uint32_t offset = (g_dataEnd + SECTOR_BYTES - 1) / SECTOR_BYTES * SECTOR_BYTES;
+  if (offset >= g_capacity) return STORE_FULL;
+  memset(&g_open, 0, sizeof(g_open));
+  g_open.state = SLOT_VALID;
+  g_open.kind = kind;
+  g_open.frameDelayMs = frameDelayMs;
+  g_open.offset = offset;
+  strncpy(g_open.name, name, MAX_NAME);
+  g_writeAddress = offset;
+  g_writing = true;
+  return STORE_OK;
+}
+
+StoreStatus reopenEntry(const char *name) {
+  abortEntry();
+  if (!g_mounted) return STORE_NOT_MOUNTED;
+  StoredImage entry;
+  if (findSlot(name, entry) < 0) return STORE_NOT_FOUND;
+  // Only the last entry can grow: later entries start on the next sector, so
+  // the rest of its final sector is still erased (unless an earlier append
+  // was interrupted)
+  uint32_t end = entry.offset + entry.length;
+  uint32_t sectorEnd = (end + SECTOR_BYTES - 1) / SECTOR_BYTES * SECTOR_BYTES;
+  if (end != g_dataEnd || !isErased(end, sectorEnd)) return STORE_NOT_LAST;
+  if (g_slotsUsed >= MAX_ENTRIES) return STORE_NO_SLOT;
+  g_open = entry;
+  g_writeAddress = entry.offset + entry.length;
+  g_writing = true;
+  return STORE_OK;
+}
+
+StoreStatus addFrame(uint16_t width, uint16_t height, uint8_t encoding, const uint8_t *data, uint32_t length) {
+  if (!g_writing) return STORE_NOT_OPEN;
+  if (g_open.kind == STORE_KIND_PLAYLIST) return STORE_MISMATCH;
+  if (g_open.frameCount == 0) {
+    g_open.width = width;
+    g_open.height = height;
+    g_open.encoding = encoding;
+  } else if (width != g_open.width || height != g_open.height || encoding != g_open.encoding) {
+    return STORE_MISMATCH;
+  }
+  if (g_open.frameCount == 0xFFFF) return STORE_FULL;
+
+  uint8_t prefix[4] = {
+    (uint8_t)length, (uint8_t)(length >> 8), (uint8_t)(length >> 16), (uint8_t)(length >> 24)
+  };
+  StoreStatus status = writeBytes(prefix, sizeof(prefix));
+  if (status == STORE_OK) status = writeBytes(data, length);
+  if (status != STORE_OK) {
+    abortEntry();
+    return status;
+  }
+  g_open.frameCount++;
+  g_open.length += sizeof(prefix) + length;
+  return STORE_OK;
+}
+
+StoreStatus addName(const char *name) {
+  if (!g_writing) return STORE_NOT_OPEN;
+  if (g_open.kind != STORE_KIND_PLAYLIST) return STORE_MISMATCH;
+  if (!validName(name)) return STORE_BAD_NAME;
+  uint32_t length = strlen(name) + 1;
+  StoreStatus status = writeBytes(name, length);
+  if (status != STORE_OK) {
+    abortEntry();
+    return status;
+  }
+  g_open.frameCount++;
+  g_open.length += length;
+  return STORE_OK;
+}
+
+StoreStatus commit() {
+  if (!g_writing) return STORE_NOT_OPEN;
+  if (g_open.frameCount == 0) {
+    abortEntry();
+    return STORE_NOT_OPEN;
+  }
+  if (g_open.kind != STORE_KIND_PLAYLIST) {
+    g_open.kind = g_open.frameCount > 1 ? STORE_KIND_SEQUENCE : STORE_KIND_IMAGE;
+  }
+
+  // New slot first, then the replaced one is deleted
+  StoredImage previous;
+  int replaced = findSlot(g_open.name, previous);
+  g_writing = false;
+  if (!flashProgram(slotAddress(g_slotsUsed), &g_open, sizeof(g_open))) {
+    scan();
+    return STORE_IO_ERROR;
+  }
+  bool deleted = replaced < 0 || markDeleted(replaced);
+  scan();
+  return deleted ? STORE_OK : STORE_IO_ERROR;
+}
+
+void abortEntry() {
+  g_writing = false;
+}
+
+StoreStatus remove(const char *name) {
+  abortEntry();
+  if (!g_mounted) return STORE_NOT_MOUNTED;
+  StoredImage entry;
+  int slot = findSlot(name, entry);
+  if (slot < 0) return STORE_NOT_FOUND;
+  bool deleted = markDeleted(slot);
+  scan();
+  return deleted ? STORE_OK : STORE_IO_ERROR;
+}
+
+StoreStatus format() {
+  abortEntry();
+  if (!g_present) return STORE_NOT_MOUNTED;
+  StoreHeader header;
+  memset(&header, 0xFF, sizeof(header));
+  memcpy(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+  header.version = STORE_VERSION;
+  if (!eraseSector(0) || !flashProgram(0, &header, sizeof(header))) {
+    g_mounted = false;
+    return STORE_IO_ERROR;
+  }
+  g_mounted = true;
+  scan();
+  return STORE_OK;
+}
+
+uint32_t getCapacity() {
+  return g_capacity;
+}
+
+uint32_t getUsedBytes() {
+  return g_mounted ? g_dataEnd : 0;
+}
+
+uint8_t getCount() {
+  return g_mounted ? g_count : 0;
+}
+
+uint8_t getFreeSlots() {
+  return g_mounted ? MAX_ENTRIES - g_slotsUsed : 0;
+}
+
+uint32_t getJedecId() {
+  return g_jedecId;
+}
+
+void list(Stream &out) {
+  if (!g_mounted) return;
+  StoredImage entry;
+  for (uint8_t i = 0; i < g_slotsUsed; ++i) {
+    readSlot(i, entry);
+    if (entry.state != SLOT_VALID) continue;
+    out.print(entry.name);
+    out.print(" ");
+    out.print(kindName(entry.kind));
+    out.print(" ");
+    out.print(entry.width);
+    out.print("x");
+    out.print(entry.height);
+    out.print(" enc:");
+    out.print(entry.encoding);
+    out.print(" frames:");
+    out.print(entry.frameCount);
+    out.print(" delay:");
+    out.print(entry.frameDelayMs);
+    out.print(" bytes:");
+    out.println(entry.length);
+  }
+}
+
+const char *kindName(uint8_t kind) {
+  switch (kind) {
+    case STORE_KIND_IMAGE: return "IMAGE";
+    case STORE_KIND_SEQUENCE: return "SEQUENCE";
+    case STORE_KIND_PLAYLIST: return "PLAYLIST";
+    default: return "UNKNOWN";
+  }
+}
+
+const char *statusName(StoreStatus status) {
+  switch (status) {
+    case STORE_OK: return "OK";
+    case STORE_NOT_MOUNTED: return "No image store";
+    case STORE_BAD_NAME: return "Invalid name (1-11 of A-Z a-z 0-9 _ - .)";
+    case STORE_NOT_FOUND: return "Not stored";
+    case STORE_NO_SLOT: return "Index full (STORE_FORMAT reclaims deleted entries)";
+    case STORE_FULL: return "Store full";
+    case STORE_MISMATCH: return "Frame does not match the entry";
+    case STORE_NOT_LAST: return "Only the newest entry can be extended";
+    case STORE_NOT_OPEN: return "Nothing to write";
+    case STORE_IO_ERROR: return "Flash write failed";
+    default: return "Unknown error";
+  }
+}
+
+} // namespace ImageStore
@@ -0,0 +1,123 @@
+#ifndef IMAGE_STORE_H
+#define IMAGE_STORE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Named images, animation sequences and playlists kept on an SPI NOR flash
+// (W25Qxx / AT25 style: JEDEC id, 4KB sector erase, 256-byte page program)
+// that shares the display SPI bus on its own chip select. Only compiled in
+// with -DST7735_IMAGE_STORE (see platformio.ini); otherwise begin() reports
+// no store and every other call fails.
+//
+// Container layout, all little-endian:
+//   Sector 0        index: a 32-byte header slot ("ST7735IS", version), then
+//                   MAX_ENTRIES StoredImage slots
+//   Sector 1...     entry data, each entry starting on a sector boundary
+// An image or sequence holds frameCount frames, each a uint32_t byte count
+// followed by the payload exactly as it was cached (BinaryEncoding, see
+// PixelDecoder.h), all of one size and encoding. A playlist holds
+// frameCount NUL-terminated entry names.
+//
+// NOR flash only clears bits without an erase, so the index is append-only:
+// a slot is written once when its entry is committed and deleted by
+// clearing its state byte. Replacing a name commits a new slot and deletes
+// the old one. Data of deleted entries is reused only when it sits at the
+// end of the store; STORE_FORMAT (format()) reclaims everything else.
+//
+// The flash is read and written with the display DMA idle: every access
+// first completes the in-flight panel push.
+
+#ifndef IMAGE_STORE_CS
+#define IMAGE_STORE_CS 4
+#endif
+
+#ifndef IMAGE_STORE_SPI_FREQUENCY
+#define IMAGE_STORE_SPI_FREQUENCY 21000000UL
+#endif
+
+// Entry shown at boot instead of the test patterns when present
+#define IMAGE_STORE_SPLASH_NAME "SPLASH"
+
+enum StoreKind {
+  STORE_KIND_IMAGE = 1,      // One frame
+  STORE_KIND_SEQUENCE = 2,   // Frames shown frameDelayMs apart
+  STORE_KIND_PLAYLIST = 3    // Entry names, each held frameDelayMs after it finishes
+};
+
+enum StoreStatus {
+  STORE_OK = 0,
+  STORE_NOT_MOUNTED,   // No flash found / not built with ST7735_IMAGE_STORE
+  STORE_BAD_NAME,      // Empty, too long or not [A-Za-z0-9_.-]
+  STORE_NOT_FOUND,
+  STORE_NO_SLOT,       // Index full (format to reclaim deleted slots)
+  STORE_FULL,          // Not enough flash left
+  STORE_MISMATCH,      // Frame size or encoding differs from the entry's
+  STORE_NOT_LAST,      // Append to an entry that is not at the end of the store
+  STORE_NOT_OPEN,      // No entry being written
+  STORE_IO_ERROR       // Flash did not finish a program / erase
+};
+
+struct StoredImage {
+  uint8_t  state;        // Slot state (free / valid / deleted)
+  uint8_t  kind;         // StoreKind
+  uint8_t  encoding;     // BinaryEncoding of every frame
+  uint8_t  reserved;
+  uint16_t width;
+  uint16_t height;
+  uint16_t frameCount;   // Frames, or playlist items
+  uint16_t frameDelayMs;
+  uint32_t offset;       // Flash address of the first frame
+  uint32_t length;       // Data bytes (length prefixes included)
+  char     name[12];     // NUL-terminated
+};
+
+namespace ImageStore {
+
+static const uint32_t SECTOR_BYTES = 4096;
+static const uint16_t PAGE_BYTES = 256;
+static const uint8_t MAX_ENTRIES = SECTOR_BYTES / sizeof(StoredImage) - 1;
+static const uint8_t MAX_NAME = sizeof(((StoredImage*)0)->name) - 1;
+static const size_t CHUNK_BYTES = 512;       // Largest readChunk()
+
+// Probe the flash and read its index (formatting a blank chip). Safe to call
+// again; false when no store is available.
+bool begin();
+bool isMounted();
+
+// Look up a committed entry by name.
+bool find(const char *name, StoredImage &entry);
+
+// Read up to CHUNK_BYTES at a flash address into the store's own buffer;
+// nullptr if unmounted. The data stays valid until the next store call.
+const uint8_t *readChunk(uint32_t address, size_t length);
+
+// Writing: open a new entry (or reopen the newest one to add frames), add
+// frames or playlist names, then commit. Opening again or abortEntry() discards
+// an uncommitted entry.
+StoreStatus beginEntry(const char *name, uint8_t kind, uint16_t frameDelayMs);
+StoreStatus reopenEntry(const char *name);
+StoreStatus addFrame(uint16_t width, uint16_t height, uint8_t encoding, const uint8_t *data, uint32_t length);
+StoreStatus addName(const char *name);
+StoreStatus commit();
+void abortEntry();
+
+StoreStatus remove(const char *name);
+StoreStatus format();
+
+// Statistics
+uint32_t getCapacity();
+uint32_t getUsedBytes();    // Through the end of the last entry
+uint8_t getCount();
+uint8_t getFreeSlots();
+uint32_t getJedecId();
+
+// Print one line per entry ("<name> <kind> <w>x<h> enc:<e> frames:<n> delay:<ms> bytes:<len>")
+void list(Stream &out);
+
+const char *kindName(uint8_t kind);
+const char *statusName(StoreStatus status);
+
+} // namespace ImageStore
+
+#endif // IMAGE_STORE_H
@@ -0,0 +1,196 @@
+#include "Playback.h"
+#include <string.h>
+#include "ImageCache.h"
+
+// Sequencer state
+struct PlaybackState {
+  bool active;
+  uint8_t mask;              // Displays shown on
+  uint16_t loopsLeft;        // Passes still to show, including this one (0 = forever)
+  StoredImage list;          // Playlist being played (kind 0 = none)
+  uint16_t listItem;         // Playlist names read so far in this pass
+  uint32_t listAddress;      // Flash address of the next name
+  StoredImage item;          // Image or sequence being shown
+  uint16_t frame;            // Next frame of item
+  uint32_t frameAddress;     // Flash address of that frame's length prefix
+  unsigned long dueMillis;   // millis() at which the next frame is shown
+};
+
+static PlaybackState g_state;
+
+// --- Sequencing ----------------------------------------------------------
+
+static bool nextItem() {
+  // A sequence starts another pass; a single image is shown once
+  if (g_state.list.kind != STORE_KIND_PLAYLIST) {
+    if (g_state.item.kind != STORE_KIND_SEQUENCE || g_state.loopsLeft == 1) {
+      return false;
+    }
+    if (g_state.loopsLeft) {
+      g_state.loopsLeft--;
+    }
+    g_state.frame = 0;
+    g_state.frameAddress = g_state.item.offset;
+    return true;
+  }
+
+  // Next playlist name that is a stored image or sequence
+  for (uint16_t skipped = 0; skipped < g_state.list.frameCount; skipped++) {
+    if (g_state.listItem >= g_state.list.frameCount) {
+      if (g_state.loopsLeft == 1) {
+        return false;
+      }
+      if (g_state.loopsLeft) {
+        g_state.loopsLeft--;
+      }
+      g_state.listItem = 0;
+      g_state.listAddress = g_state.list.offset;
+    }
+    char name[ImageStore::MAX_NAME + 1];
+    const uint8_t *data = ImageStore::readChunk(g_state.listAddress, ImageStore::MAX_NAME + 1);
+    if (!data) {
+      return false;
+    }
+    memcpy(name, data, ImageStore::MAX_NAME);
+    name[ImageStore::MAX_NAME] = '\0';
+    g_state.listAddress += strlen(name) + 1;
+    g_state.listItem++;
+    if (ImageStore::find(name, g_state.item) && g_state.item.kind != STORE_KIND_PLAYLIST) {
+      g_state.frame = 0;
+      g_state.frameAddress = g_state.item.offset;
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool showFrame(PlaybackSink &sink) {
+  // One frame of the item: a length prefix, then the cached payload. Each
+  // read waits for the previous band's DMA, since the flash shares the bus
+  // with the panels
+  const StoredImage &item = g_state.item;
+  const uint8_t *prefix = ImageStore::readChunk(g_state.frameAddress, 4);
+  if (!prefix) {
+    return false;
+  }
+  uint32_t length = prefix[0] | ((uint32_t)prefix[1] << 8) | ((uint32_t)prefix[2] << 16) |
+                    ((uint32_t)prefix[3] << 24);
+  uint32_t address = g_state.frameAddress + 4;
+  if (address + length > item.offset + item.length) {
+    return false;
+  }
+  g_state.frameAddress = address + length;
+
+  sink.beginFrame(item, g_state.frame, g_state.mask);
+  bool readOk = true;
+  while (length) {
+    size_t chunk = length < ImageStore::CHUNK_BYTES ? length : ImageStore::CHUNK_BYTES;
+    const uint8_t *data = ImageStore::readChunk(address, chunk);
+    if (!data) {
+      readOk = false;
+      break;
+    }
+    sink.frameBytes(data, chunk);
+    address += chunk;
+    length -= chunk;
+  }
+  return sink.finishFrame(readOk);
+}
+
+// --- Store writes --------------------------------------------------------
+
+static StoreStatus addCachedFrames(const long *ids, int count) {
+  StoreStatus status = STORE_OK;
+  for (int i = 0; i < count && status == STORE_OK; i++) {
+    const CachedImage *image = ImageCache::find(ids[i]);
+    status = ImageStore::addFrame(image->width, image->height, image->encoding,
+                                  ImageCache::getData(image), image->length);
+  }
+  return status == STORE_OK ? ImageStore::commit() : status;
+}
+
+namespace Playback {
+
+bool start(const char *name, uint8_t mask, uint16_t loops, PlaybackSink &sink) {
+  stop();
+  StoredImage entry;
+  if (!mask || !ImageStore::find(name, entry)) {
+    return false;
+  }
+  memset(&g_state, 0, sizeof(g_state));
+  g_state.mask = mask;
+  g_state.loopsLeft = loops;
+  if (entry.kind == STORE_KIND_PLAYLIST) {
+    g_state.list = entry;
+    g_state.listAddress = entry.offset;
+  } else {
+    g_state.item = entry;
+    g_state.frameAddress = entry.offset;
+  }
+  g_state.active = true;
+  g_state.dueMillis = millis();
+  service(sink);
+  return g_state.active;
+}
+
+void service(PlaybackSink &sink) {
+  if (!g_state.active || (long)(millis() - g_state.dueMillis) < 0) {
+    return;
+  }
+  if (g_state.frame >= g_state.item.frameCount && !nextItem()) {
+    stop();
+    return;
+  }
+  if (!showFrame(sink)) {
+    stop();
+    return;
+  }
+
+  // Sequence frames are frameDelayMs apart; a playlist holds each item's last frame
+  g_state.frame++;
+  bool itemDone = g_state.frame >= g_state.item.frameCount;
+  bool inList = g_state.list.kind == STORE_KIND_PLAYLIST;
+  g_state.dueMillis = millis() + (itemDone && inList ? g_state.list.frameDelayMs : g_state.item.frameDelayMs);
+}
+
+void stop() {
+  g_state.active = false;
+}
+
+bool isActive() {
+  return g_state.active;
+}
+
+StoreStatus saveFrames(const char *name, uint16_t frameDelayMs, const long *ids, int count) {
+  stop();
+  StoreStatus status = ImageStore::beginEntry(name, STORE_KIND_SEQUENCE, frameDelayMs);
+  return status == STORE_OK ? addCachedFrames(ids, count) : status;
+}
+
+StoreStatus appendFrames(const char *name, const long *ids, int count) {
+  stop();
+  StoreStatus status = ImageStore::reopenEntry(name);
+  return status == STORE_OK ? addCachedFrames(ids, count) : status;
+}
+
+StoreStatus savePlaylist(const char *name, uint16_t holdMs, const char *const *items, uint16_t count) {
+  // Items are looked up when played, so they may be stored later
+  stop();
+  StoreStatus status = ImageStore::beginEntry(name, STORE_KIND_PLAYLIST, holdMs);
+  for (uint16_t i = 0; i < count && status == STORE_OK; i++) {
+    status = ImageStore::addName(items[i]);
+  }
+  return status == STORE_OK ? ImageStore::commit() : status;
+}
+
+StoreStatus remove(const char *name) {
+  stop();
+  return ImageStore::remove(name);
+}
+
+StoreStatus format() {
+  stop();
+  return ImageStore::format();
+}
+
+} // namespace Playback
@@ -0,0 +1,55 @@
+#ifndef PLAYBACK_H
+#define PLAYBACK_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "ImageStore.h"
+
+// Local playback of ImageStore entries (CMD:PLAY, the boot splash) and the
+// store writes that feed it from the image cache (CMD:STORE_*).
+//
+// The sequencer walks an image, a sequence (loops passes of its frames,
+// frameDelayMs apart) or a playlist (each named image or sequence in turn,
+// its last frame held for the playlist's frameDelayMs). Playlist names are
+// looked up as they come up; missing entries and nested playlists are
+// skipped, and a whole pass of them ends playback.
+//
+// Frames are read from flash in ImageStore::CHUNK_BYTES pieces and handed
+// to a PlaybackSink, which draws them (SerialProtocol replays them through
+// its reception path). Every store write stops playback first, since the
+// sequencer keeps flash addresses into the entries it plays.
+
+// Draws one stored frame: beginFrame(), its payload in pieces, then
+// finishFrame(), which is called even if the payload could not be read and
+// reports whether the frame was shown in full
+class PlaybackSink {
+public:
+  virtual void beginFrame(const StoredImage &item, uint16_t frame, uint8_t mask) = 0;
+  virtual void frameBytes(const uint8_t *data, size_t length) = 0;
+  virtual bool finishFrame(bool readOk) = 0;
+};
+
+namespace Playback {
+
+// Start playing a stored entry on the displays in mask (loops passes,
+// 0 = forever) and show its first frame; false if there is nothing to play
+bool start(const char *name, uint8_t mask, uint16_t loops, PlaybackSink &sink);
+
+// Show the next frame once it is due; call while the link is idle
+void service(PlaybackSink &sink);
+
+void stop();
+bool isActive();
+
+// Store writes. Frames are cached image ids (ImageCache), copied still
+// encoded; the caller checks they exist and match before anything is
+// written, since flash cannot take back a partial append.
+StoreStatus saveFrames(const char *name, uint16_t frameDelayMs, const long *ids, int count);
+StoreStatus appendFrames(const char *name, const long *ids, int count);
+StoreStatus savePlaylist(const char *name, uint16_t holdMs, const char *const *items, uint16_t count);
+StoreStatus remove(const char *name);
+StoreStatus format();
+
+} // namespace Playback
+
+#endif // PLAYBACK_H
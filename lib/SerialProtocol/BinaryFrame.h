@@ -0,0 +1,279 @@
+/*
+ * BinaryFrame.h
+ * Binary framed bitmap protocol (runs alongside the text protocol)
+ * 
+ * A frame is a fixed 24-byte little-endian header followed by payloadLength
+ * bytes of payload. The first header byte is BINARY_SYNC_BYTE, which can
+ * never start a text command, so SerialProtocol peeks at it to dispatch.
+ * 
+ * Frame layout:
+ *   [BinaryFrameHeader (24 bytes)][payload (payloadLength bytes)]
+ *   crc32 = CRC-32 (zlib polynomial) over header bytes 0..19 and the payload
+ * 
+ * Every frame is answered with one BinaryAck (8 bytes) carrying the
+ * frame's opcode, sequence number and a BinaryStatus code.
+ * 
+ * Credit flow control (BIN_FLAG_CREDIT, or ";CREDIT" on a text SIZE line):
+ * while the payload is received the firmware sends BinaryAck messages with
+ * opcode BIN_OP_CREDIT, the frame's sequence (0 for text transfers) and
+ * value = payload bytes the host may have sent so far (consumed bytes plus
+ * one receive ring). The first credit follows the header / READY; later
+ * ones are batched every BINARY_CREDIT_INTERVAL consumed bytes and stop
+ * once the window covers the whole payload, so the host can stream
+ * continuously without pacing. Text progress lines are suppressed.
+ * 
+ * Tear-free presentation (BIN_FLAG_VSYNC on a BLIT or STREAM_BEGIN): the
+ * first band of each frame is held until the tearing-effect edge of the
+ * first selected display with a TE line (DisplayConfig::te; without one the
+ * flag is ignored), so the write starts in vertical blanking and stays
+ * ahead of the refresh scan. A vsync stream rounds its frame slot to whole
+ * refresh periods (targetFps 0 = one frame per refresh) and its ack wait
+ * runs to the first refresh edge after the slot, so a host that sleeps for
+ * the ack value stays locked to the panel. CMD:STREAM_STATS reports the
+ * measured refresh period.
+ * 
+ * Opcodes:
+ *   BIN_OP_PING - No payload, acknowledged with BIN_STATUS_OK
+ *   BIN_OP_BLIT - RGB565 big-endian pixels (raw or compressed, see encoding)
+ *                 for a w x h window at (x, y) in display coordinates
+ *                 (or centred with BIN_FLAG_CENTER, or fitted to each
+ *                 display's usable area with BIN_FLAG_FIT),
+ *                 optionally broadcast to several displays (BIN_FLAG_DISPLAY_MASK)
+ *   BIN_OP_CACHE_STORE - Payload is [cache id][encoded image]; width, height and
+ *                 encoding describe the image, which is stored in the
+ *                 ImageCache (not drawn). Ids 0..254, see ImageCache.h
+ *   BIN_OP_CACHE_SHOW - Payload is [cache id]; draws the cached image like a
+ *                 BLIT of it (x/y, CENTER, FIT, CLEAR and display selection apply,
+ *                 width/height/encoding are ignored)
+ *   BIN_OP_PALETTE - Payload is [count][count x RGB565 big-endian] (count 0 =
+ *                 256); loads the session palette used by indexed encodings
+ *                 that do not carry their own (see PixelDecoder.h)
+ *   BIN_OP_STREAM_BEGIN - Payload is BinaryStreamParams; opens a stream: the
+ *                 header's displays, x/y (or CENTER), width/height and
+ *                 encoding are fixed for every following STREAM_FRAME
+ *                 (FIT only centres: delta regions need an unscaled window).
+ *                 CLEAR clears the displays once the stream is accepted
+ *                 (valid parameters and CRC). Replaces any open stream
+ *   BIN_OP_STREAM_FRAME - Payload is one encoded frame in the stream encoding
+ *                 (header encoding/display fields are ignored). width/height
+ *                 0 = whole stream window; otherwise a delta region at x/y
+ *                 relative to the stream origin, inside the stream window.
+ *                 The ack value is the time in microseconds until the next
+ *                 frame slot (0 when unpaced or late); the host should wait
+ *                 that long before sending the next frame. A frame that
+ *                 arrives more than one slot late under STREAM_DROP_LATE is
+ *                 CRC-checked but not drawn (BIN_STATUS_DROPPED)
+ *   BIN_OP_STREAM_END - No payload; closes the stream, ack value = frames
+ *                 drawn. CMD:STREAM_STATS reports achieved FPS and drops
+ *   BIN_OP_TEXT - Payload is BinaryTextParams followed by 1..GlyphText::MAX_LENGTH
+ *                 text bytes; draws one line with its top-left corner at x/y on
+ *                 every selected display (width/height/encoding ignored, clipped
+ *                 like a partial update). Atlases are stored beforehand with
+ *                 BIN_OP_CACHE_STORE and BIN_ENC_GLYPH_ATLAS (width/height ignored);
+ *                 atlas id GLYPH_ATLAS_BUILTIN_ID selects the built-in 5x7 font.
+ *                 Ack value = (text width << 16) | text height in pixels
+ *   BIN_OP_TILES - Payload is 1..BINARY_MAX_TILE_DRAWS BinaryTileDraw entries;
+ *                 composites cached raw RGB565 tiles at (x, y) + each entry's
+ *                 offset on every selected display, in list order (CLEAR
+ *                 clears first). Runs of tiles continuing a strip share one
+ *                 address window (DisplayManager::composeTiles). Ack value =
+ *                 strips drawn, or the offending id with CACHE_MISS (not
+ *                 stored) / UNSUPPORTED (not raw RGB565)
+ *   BIN_OP_BATCH - Payload is a sequence of BinaryBatchOp headers, each
+ *                 followed by its length operand bytes; the operations run in
+ *                 order as they arrive, so one frame and one ack replace a
+ *                 round trip per operation. Header displays only select the
+ *                 starting displays (BINARY_ACTIVE_DISPLAY keeps the selection,
+ *                 none needed); an operation with a non-zero display mask
+ *                 selects those displays first, like DISPLAY:. Operations:
+ *                   SELECT     - no operand; just selects the mask
+ *                   FILL       - no operand; color fills width x height at x/y,
+ *                                clipped like a partial update
+ *                   CLEAR      - no operand; color fills the whole screen
+ *                   BLIT       - operand is the pixel payload of a BIN_OP_BLIT
+ *                                (encoding, width/height, x/y or CENTER/FIT,
+ *                                CLEAR as there)
+ *                   CACHE_SHOW - operand is [cache id], drawn like BIN_OP_CACHE_SHOW
+ *                   TEXT       - operand is a BIN_OP_TEXT payload, drawn at x/y
+ *                   TILES      - operand is a BIN_OP_TILES payload, placed at x/y
+ *                 The first failing operation stops the batch (the rest is
+ *                 drained) and its status is acked. Ack value = operations
+ *                 completed, i.e. the index of the failing one. Drawing happens
+ *                 before the CRC is known, as for BLIT
+ */
+
+#ifndef BINARY_FRAME_H
+#define BINARY_FRAME_H
+
+#include <Arduino.h>
+
+// Sync bytes (outside the ASCII range used by text commands)
+static const uint8_t BINARY_SYNC_BYTE = 0xA5;      // Host -> Arduino frame header
+static const uint8_t BINARY_ACK_SYNC_BYTE = 0xA6;  // Arduino -> Host acknowledgement
+
+// Display id selecting the currently active display
+static const uint8_t BINARY_ACTIVE_DISPLAY = 0xFF;
+
+// Upper bound on accepted payloads (larger headers are treated as garbage)
+static const uint32_t BINARY_MAX_PAYLOAD = 1000UL * 1000UL * 2UL;
+
+// Tile placements per BIN_OP_TILES frame
+static const uint8_t BINARY_MAX_TILE_DRAWS = 64;
+
+// Consumed payload bytes between two credit messages
+static const uint32_t BINARY_CREDIT_INTERVAL = 2048;
+
+enum BinaryOpcode {
+    BIN_OP_PING = 0x00,
+    BIN_OP_BLIT = 0x01,
+    BIN_OP_CACHE_STORE = 0x02,
+    BIN_OP_CACHE_SHOW = 0x03,
+    BIN_OP_PALETTE = 0x04,
+    BIN_OP_CREDIT = 0x05,     // Firmware -> host only: receive window update
+    BIN_OP_STREAM_BEGIN = 0x06,
+    BIN_OP_STREAM_FRAME = 0x07,
+    BIN_OP_STREAM_END = 0x08,
+    BIN_OP_TEXT = 0x09,
+    BIN_OP_TILES = 0x0A,
+    BIN_OP_BATCH = 0x0B
+};
+
+enum BinaryFlags {
+    BIN_FLAG_CENTER = 0x01,   // Ignore x/y and centre in the usable area
+    BIN_FLAG_CLEAR = 0x02,    // Clear the display before drawing
+    BIN_FLAG_DISPLAY_MASK = 0x04, // displayId is a bitmask (bit i = display index i)
+    BIN_FLAG_CREDIT = 0x08,   // Send BIN_OP_CREDIT window updates during the payload
+    BIN_FLAG_FIT = 0x10,      // Centre, turned and scaled to each display (see CMD:FIT_ON)
+    BIN_FLAG_VSYNC = 0x20     // BLIT / STREAM_BEGIN: start each frame on the panel's TE edge
+};
+
+enum BinaryEncoding {
+    BIN_ENC_RGB565 = 0x00,    // Raw RGB565, 2 bytes per pixel, big-endian
+    BIN_ENC_RLE = 0x01,       // Run-length packets (see PixelDecoder.h)
+    BIN_ENC_QOI = 0x02,       // QOI-style RGB565 ops (see PixelDecoder.h)
+    BIN_ENC_INDEXED1 = 0x03,  // Palette indices, 1/2/4/8 bits per pixel (see PixelDecoder.h)
+    BIN_ENC_INDEXED2 = 0x04,
+    BIN_ENC_INDEXED4 = 0x05,
+    BIN_ENC_INDEXED8 = 0x06,
+    BIN_ENC_RGB888 = 0x07,    // 3 bytes per pixel (R, G, B), converted to RGB565 on the device
+    BIN_ENC_GLYPH_ATLAS = 0x10, // CACHE_STORE only: a glyph atlas for BIN_OP_TEXT (see GlyphAtlas.h)
+    BIN_ENC_DITHER_ORDERED = 0x20, // Modifiers for RGB888: 4x4 ordered (Bayer) dither
+    BIN_ENC_DITHER_DIFFUSE = 0x40, // or Floyd-Steinberg error diffusion instead of truncation
+    BIN_ENC_DITHER_MASK = 0x60,
+    BIN_ENC_PALETTE = 0x80    // Modifier for indexed encodings: payload starts with a palette
+};
+
+enum BinaryStatus {
+    BIN_STATUS_OK = 0x00,
+    BIN_STATUS_CRC_ERROR = 0x01,
+    BIN_STATUS_BAD_HEADER = 0x02,
+    BIN_STATUS_NO_DISPLAY = 0x03,
+    BIN_STATUS_UNSUPPORTED = 0x04,
+    BIN_STATUS_TIMEOUT = 0x05,
+    BIN_STATUS_DECODE_ERROR = 0x06, // Compressed payload did not yield width x height pixels
+    BIN_STATUS_CACHE_MISS = 0x07,   // CACHE_SHOW of an id that is not stored
+    BIN_STATUS_CACHE_FULL = 0x08,   // CACHE_STORE image larger than the cache arena
+    BIN_STATUS_DROPPED = 0x09,      // STREAM_FRAME received intact but skipped to catch up
+    BIN_STATUS_NO_STREAM = 0x0A     // STREAM_FRAME / STREAM_END without an open stream
+};
+
+enum BinaryTextFlags {
+    TEXT_FLAG_OPAQUE = 0x01   // Fill the text box with the background colour (else transparent)
+};
+
+enum BinaryBatchOpcode {
+    BATCH_OP_SELECT = 0x00,
+    BATCH_OP_FILL = 0x01,
+    BATCH_OP_CLEAR = 0x02,
+    BATCH_OP_BLIT = 0x03,
+    BATCH_OP_CACHE_SHOW = 0x04,
+    BATCH_OP_TEXT = 0x05,
+    BATCH_OP_TILES = 0x06
+};
+
+enum BinaryStreamDrop {
+    STREAM_DROP_NONE = 0x00,  // Draw every frame; a late stream re-bases its schedule
+    STREAM_DROP_LATE = 0x01   // Skip frames arriving more than one slot behind schedule
+};
+
+// Fixed frame header (all fields naturally aligned, no padding)
+struct BinaryFrameHeader {
+    uint8_t  sync;            // BINARY_SYNC_BYTE
+    uint8_t  opcode;          // BinaryOpcode
+    uint8_t  displayId;       // DisplayManager index or BINARY_ACTIVE_DISPLAY
+    uint8_t  sequence;        // Echoed back in the ack
+    int16_t  x;               // Window origin (display coordinates)
+    int16_t  y;
+    uint16_t width;           // Window size in pixels
+    uint16_t height;
+    uint8_t  encoding;        // BinaryEncoding
+    uint8_t  flags;           // BinaryFlags
+    uint16_t reserved;        // Must be zero
+    uint32_t payloadLength;   // Payload bytes following the header
+    uint32_t crc32;           // CRC over header bytes 0..19 and payload
+};
+
+// BIN_OP_STREAM_BEGIN payload
+struct BinaryStreamParams {
+    uint16_t targetFps;       // Frame slots per second, 0 = unpaced
+    uint8_t  dropPolicy;      // BinaryStreamDrop
+    uint8_t  reserved;        // Must be zero
+};
+
+// BIN_OP_TEXT payload (followed by the text bytes)
+struct BinaryTextParams {
+    uint16_t foreground;      // RGB565
+    uint16_t background;      // RGB565, used with TEXT_FLAG_OPAQUE
+    uint8_t  atlas;           // Cache id of the atlas or GLYPH_ATLAS_BUILTIN_ID
+    uint8_t  flags;           // BinaryTextFlags
+    uint8_t  scale;           // Integer magnification, 1..GlyphText::MAX_SCALE
+    uint8_t  reserved;        // Must be zero
+};
+
+// BIN_OP_TILES payload entry
+struct BinaryTileDraw {
+    int16_t  x;               // Offset from the frame's x/y
+    int16_t  y;
+    uint8_t  id;              // Cache id of a raw RGB565 tile
+    uint8_t  reserved;        // Must be zero
+};
+
+// BIN_OP_BATCH operation header (followed by length operand bytes)
+struct BinaryBatchOp {
+    uint8_t  op;              // BinaryBatchOpcode
+    uint8_t  displays;        // Display mask to select first (bit i = display index i), 0 = keep
+    uint8_t  encoding;        // BLIT: BinaryEncoding of the operand
+    uint8_t  flags;           // BLIT / CACHE_SHOW: BIN_FLAG_CENTER, _FIT, _CLEAR; TILES: _CLEAR
+    int16_t  x;               // Window origin (display coordinates)
+    int16_t  y;
+    uint16_t width;           // FILL / BLIT window size
+    uint16_t height;
+    uint16_t color;           // FILL / CLEAR colour (RGB565)
+    uint16_t length;          // Operand bytes following this header
+};
+
+// Acknowledgement sent after every frame
+struct BinaryAck {
+    uint8_t  sync;            // BINARY_ACK_SYNC_BYTE
+    uint8_t  opcode;          // Opcode being acknowledged
+    uint8_t  sequence;        // Sequence number being acknowledged
+    uint8_t  status;          // BinaryStatus
+    uint32_t value;           // Opcode specific (pixels written for BLIT / CACHE_SHOW, window for CREDIT,
+                              // wait for STREAM_FRAME, frames drawn for STREAM_END, size for TEXT,
+                              // strips for TILES, operations completed for BATCH)
+};
+
+static const size_t BINARY_HEADER_SIZE = sizeof(BinaryFrameHeader);
+static const size_t BINARY_HEADER_CRC_SPAN = BINARY_HEADER_SIZE - sizeof(uint32_t);
+
+static_assert(sizeof(BinaryFrameHeader) == 24, "BinaryFrameHeader must be 24 bytes");
+static_assert(sizeof(BinaryAck) == 8, "BinaryAck must be 8 bytes");
+static_assert(sizeof(BinaryStreamParams) == 4, "BinaryStreamParams must be 4 bytes");
+static_assert(sizeof(BinaryTextParams) == 8, "BinaryTextParams must be 8 bytes");
+static_assert(sizeof(BinaryTileDraw) == 6, "BinaryTileDraw must be 6 bytes");
+static_assert(sizeof(BinaryBatchOp) == 16, "BinaryBatchOp must be 16 bytes");
+
+// Running CRC-32 compatible with Python's zlib.crc32(data, crc); start with 0
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length);
+
+#endif // BINARY_FRAME_H
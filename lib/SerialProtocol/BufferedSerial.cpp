@@ -0,0 +1,101 @@
+/*
+ * BufferedSerial.cpp
+ * Implementation of the ring-buffered receive path
+ */
+
+#include "BufferedSerial.h"
+#include "Telemetry.h"
+
+BufferedSerial::BufferedSerial(Stream& src)
+    : source(src)
+    , head(0)
+    , tail(0)
+    , peakFill(0)
+    , totalReceived(0) {
+}
+
+size_t BufferedSerial::poll() {
+    TELEMETRY_MARK(pollStart);
+    size_t received = 0;
+    
+    // At most two passes: up to the end of the buffer, then wrapped
+    for (int pass = 0; pass < 2; pass++) {
+        int pending = source.available();
+        size_t space = getFreeSpace();
+        if (pending <= 0 || space == 0) {
+            break;
+        }
+        
+        size_t offset = head & (RX_BUFFER_SIZE - 1);
+        size_t contiguous = min(space, RX_BUFFER_SIZE - offset);
+        size_t count = min((size_t)pending, contiguous);
+        
+        count = source.readBytes(reinterpret_cast<char*>(buffer + offset), count);
+        head += count;
+        received += count;
+    }
+    
+    totalReceived += received;
+    if (received > 0) {
+        // Idle polls would drown the receive timings
+        TELEMETRY_RECORD_SINCE(TELEMETRY_RX, pollStart);
+    }
+    size_t fill = getBufferedCount();
+    if (fill > peakFill) {
+        peakFill = fill;
+    }
+    return received;
+}
+
+size_t BufferedSerial::readBlock(uint8_t* dest, size_t length) {
+    if (getBufferedCount() < length) {
+        poll();
+    }
+    
+    size_t count = min(length, getBufferedCount());
+    size_t offset = tail & (RX_BUFFER_SIZE - 1);
+    size_t first = min(count, RX_BUFFER_SIZE - offset);
+    
+    memcpy(dest, buffer + offset, first);
+    memcpy(dest + first, buffer, count - first);
+    tail += count;
+    return count;
+}
+
+int BufferedSerial::available() {
+    if (head == tail) {
+        poll();
+    }
+    return (int)getBufferedCount();
+}
+
+int BufferedSerial::read() {
+    if (head == tail && poll() == 0) {
+        return -1;
+    }
+    return buffer[tail++ & (RX_BUFFER_SIZE - 1)];
+}
+
+int BufferedSerial::peek() {
+    if (head == tail && poll() == 0) {
+        return -1;
+    }
+    return buffer[tail & (RX_BUFFER_SIZE - 1)];
+}
+
+size_t BufferedSerial::write(uint8_t value) {
+    return source.write(value);
+}
+
+size_t BufferedSerial::write(const uint8_t* data, size_t size) {
+    return source.write(data, size);
+}
+
+void BufferedSerial::flush() {
+    source.flush();
+}
+
+void BufferedSerial::resetStats() {
+    totalReceived = 0;
+    peakFill = getBufferedCount();
+}
@@ -0,0 +1,55 @@
+/*
+ * BufferedSerial.h
+ * Ring-buffered receive path for the native USB port
+ * 
+ * Wraps a Stream (SerialUSB) and drains it in large readBytes() blocks into
+ * a statically sized ring buffer. Reads are served from the ring; writes go
+ * straight to the underlying stream. poll() never blocks: it only requests
+ * bytes the source already reports as available.
+ */
+
+#ifndef BUFFERED_SERIAL_H
+#define BUFFERED_SERIAL_H
+
+#include <Arduino.h>
+
+class BufferedSerial : public Stream {
+public:
+    static const size_t RX_BUFFER_SIZE = 8192;    // Must be a power of two
+    
+    explicit BufferedSerial(Stream& source);
+    
+    // Pull everything the source has (up to free space) into the ring
+    size_t poll();
+    
+    // Bulk copy up to length buffered bytes into dest; returns bytes copied
+    size_t readBlock(uint8_t* dest, size_t length);
+    
+    // Stream interface (reads from ring, refilling when empty)
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t value) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    void flush() override;
+    using Print::write;
+    
+    // Statistics
+    size_t getBufferedCount() const { return head - tail; }
+    size_t getFreeSpace() const { return RX_BUFFER_SIZE - (head - tail); }
+    size_t getPeakFill() const { return peakFill; }
+    uint32_t getTotalReceived() const { return totalReceived; }
+    void resetStats();
+    
+private:
+    static_assert((RX_BUFFER_SIZE & (RX_BUFFER_SIZE - 1)) == 0, "RX_BUFFER_SIZE must be a power of two");
+    
+    Stream& source;
+    uint8_t buffer[RX_BUFFER_SIZE];
+    size_t head;             // Free-running write index
+    size_t tail;             // Free-running read index
+    size_t peakFill;
+    uint32_t totalReceived;
+};
+
+#endif // BUFFERED_SERIAL_H
@@ -0,0 +1,374 @@
+/*
+ * PixelDecoder.cpp
+ * RLE, QOI-style, indexed and RGB888 stream decoding
+ */
+
+#include "PixelDecoder.h"
+#include "BinaryFrame.h"
+
+// Native RGB565 <-> band buffer (wire) order
+static inline uint16_t toWire(uint16_t color) {
+    return (uint16_t)((color >> 8) | (color << 8));
+}
+
+PixelDecoder::PixelDecoder()
+    : encoding(BIN_ENC_RGB565)
+    , state(RLE_HEADER)
+    , pixelsRemaining(0)
+    , error(false)
+    , highByte(0)
+    , count(0)
+    , lumaGreen(0)
+    , previous(0)
+    , indexBits(8)
+    , paletteRemaining(0)
+    , paletteNext(0)
+    , red(0)
+    , green(0)
+    , dither(0)
+    , rowWidth(0)
+    , column(0)
+    , row(0) {
+    memset(index, 0, sizeof(index));
+    memset(palette, 0, sizeof(palette));
+}
+
+// 4x4 Bayer matrix as offsets into one quantisation step: (rank + 0.5) * 255 / 16
+static const uint8_t BAYER_THRESHOLDS[4][4] = {
+    {   8, 135,  40, 167 },
+    { 199,  72, 231, 104 },
+    {  56, 183,  24, 151 },
+    { 247, 120, 215,  88 }
+};
+
+// Ordered dither of one channel to levels 0..maxLevel, back to 8 bits (top bits = level)
+static inline uint8_t ditherChannel(uint8_t value, uint8_t maxLevel, uint8_t threshold, uint8_t shift) {
+    uint8_t level = ((uint16_t)value * maxLevel + threshold) / 255;
+    return level << shift;
+}
+
+static inline uint8_t saturate(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+bool PixelDecoder::isIndexed(uint8_t encoding) {
+    encoding &= ~BIN_ENC_PALETTE;
+    return encoding >= BIN_ENC_INDEXED1 && encoding <= BIN_ENC_INDEXED8;
+}
+
+bool PixelDecoder::isTrueColor(uint8_t encoding) {
+    // One dither mode at most
+    return (encoding & ~BIN_ENC_DITHER_MASK) == BIN_ENC_RGB888 &&
+           (encoding & BIN_ENC_DITHER_MASK) != BIN_ENC_DITHER_MASK;
+}
+
+bool PixelDecoder::isSupported(uint8_t encoding) {
+    return encoding == BIN_ENC_RLE || encoding == BIN_ENC_QOI || isIndexed(encoding) ||
+           isTrueColor(encoding);
+}
+
+static const char* const ENCODING_NAMES[] = {
+    "RGB565", "RLE", "QOI", "IDX1", "IDX2", "IDX4", "IDX8", "RGB888"
+};
+static const uint8_t ENCODING_NAME_COUNT = sizeof(ENCODING_NAMES) / sizeof(ENCODING_NAMES[0]);
+
+const char* PixelDecoder::encodingName(uint8_t encoding) {
+    encoding &= ~(BIN_ENC_PALETTE | BIN_ENC_DITHER_MASK);
+    return encoding < ENCODING_NAME_COUNT ? ENCODING_NAMES[encoding] : nullptr;
+}
+
+bool PixelDecoder::encodingFromName(const char* name, uint8_t& encoding) {
+    for (uint8_t i = 0; i < ENCODING_NAME_COUNT; i++) {
+        if (strcmp(name, ENCODING_NAMES[i]) == 0) {
+            encoding = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PixelDecoder::setPaletteColor(uint8_t paletteIndex, uint16_t color) {
+    palette[paletteIndex] = toWire(color);
+}
+
+bool PixelDecoder::begin(uint8_t enc, uint32_t pixelCount, uint16_t width) {
+    if (!isSupported(enc)) {
+        return false;
+    }
+    if (isTrueColor(enc)) {
+        dither = enc & BIN_ENC_DITHER_MASK;
+        if (dither && width == 0) {
+            return false;
+        }
+        if (dither == BIN_ENC_DITHER_DIFFUSE && width > DITHER_MAX_WIDTH) {
+            dither = BIN_ENC_DITHER_ORDERED;
+        }
+        enc = BIN_ENC_RGB888;
+        rowWidth = width;
+        column = 0;
+        row = 0;
+        memset(carry, 0, sizeof(carry));
+        memset(belowRight, 0, sizeof(belowRight));
+        if (dither == BIN_ENC_DITHER_DIFFUSE) {
+            memset(diffusion, 0, sizeof(diffusion));
+        }
+    }
+    encoding = enc;
+    pixelsRemaining = pixelCount;
+    error = false;
+    count = 0;
+    previous = 0;
+    paletteRemaining = 0;
+    if (isIndexed(enc)) {
+        // 1, 2, 4 or 8 bits per index
+        indexBits = 1 << ((enc & ~BIN_ENC_PALETTE) - BIN_ENC_INDEXED1);
+        // Remaining count is unknown until the count byte arrives; 1 keeps isComplete() false
+        paletteRemaining = (enc & BIN_ENC_PALETTE) ? 1 : 0;
+        state = paletteRemaining ? PALETTE_COUNT : INDEX_DATA;
+        return true;
+    }
+    if (enc == BIN_ENC_RGB888) {
+        state = RGB_RED;
+        return true;
+    }
+    state = (enc == BIN_ENC_RLE) ? RLE_HEADER : QOI_OP;
+    memset(index, 0, sizeof(index));
+    return true;
+}
+
+void PixelDecoder::decode(const uint8_t* data, size_t length, PixelSink& sink) {
+    for (size_t i = 0; i < length && !error; i++) {
+        if (encoding == BIN_ENC_RLE) {
+            decodeRle(data[i], sink);
+        } else if (encoding == BIN_ENC_QOI) {
+            decodeQoi(data[i], sink);
+        } else if (encoding == BIN_ENC_RGB888) {
+            decodeTrueColor(data[i], sink);
+        } else {
+            decodeIndexed(data[i], sink);
+        }
+    }
+}
+
+void PixelDecoder::decodeRle(uint8_t value, PixelSink& sink) {
+    switch (state) {
+        case RLE_HEADER:
+            count = (value & 0x7F) + 1;
+            state = (value & 0x80) ? RLE_RUN_HIGH : RLE_LITERAL_HIGH;
+            break;
+
+        case RLE_RUN_HIGH:
+            highByte = value;
+            state = RLE_RUN_LOW;
+            break;
+
+        case RLE_RUN_LOW:
+            emitRun((highByte << 8) | value, count, sink);
+            state = RLE_HEADER;
+            break;
+
+        case RLE_LITERAL_HIGH:
+            highByte = value;
+            state = RLE_LITERAL_LOW;
+            break;
+
+        case RLE_LITERAL_LOW:
+            emit((highByte << 8) | value, sink);
+            state = (--count > 0) ? RLE_LITERAL_HIGH : RLE_HEADER;
+            break;
+
+        default:
+            error = true;
+            break;
+    }
+}
+
+void PixelDecoder::decodeQoi(uint8_t value, PixelSink& sink) {
+    uint8_t r = previous >> 11;
+    uint8_t g = (previous >> 5) & 0x3F;
+    uint8_t b = previous & 0x1F;
+
+    switch (state) {
+        case QOI_OP:
+            if (value == 0xFE) {
+                state = QOI_RGB_HIGH;
+            } else if (value == 0xFF) {
+                error = true;   // Reserved
+            } else {
+                switch (value >> 6) {
+                    case 0:     // INDEX
+                        emit(index[value & 0x3F], sink);
+                        break;
+                    case 1:     // DIFF
+                        r = (r + ((value >> 4) & 0x03) - 2) & 0x1F;
+                        g = (g + ((value >> 2) & 0x03) - 2) & 0x3F;
+                        b = (b + (value & 0x03) - 2) & 0x1F;
+                        emit((r << 11) | (g << 5) | b, sink);
+                        break;
+                    case 2:     // LUMA (second byte follows)
+                        lumaGreen = (value & 0x3F) - 32;
+                        state = QOI_LUMA;
+                        break;
+                    default:    // RUN
+                        emitRun(previous, (value & 0x3F) + 1, sink);
+                        break;
+                }
+            }
+            break;
+
+        case QOI_LUMA:
+            r = (r + lumaGreen + (value >> 4) - 8) & 0x1F;
+            g = (g + lumaGreen) & 0x3F;
+            b = (b + lumaGreen + (value & 0x0F) - 8) & 0x1F;
+            emit((r << 11) | (g << 5) | b, sink);
+            state = QOI_OP;
+            break;
+
+        case QOI_RGB_HIGH:
+            highByte = value;
+            state = QOI_RGB_LOW;
+            break;
+
+        case QOI_RGB_LOW:
+            emit((highByte << 8) | value, sink);
+            state = QOI_OP;
+            break;
+
+        default:
+            error = true;
+            break;
+    }
+}
+
+void PixelDecoder::decodeIndexed(uint8_t value, PixelSink& sink) {
+    switch (state) {
+        case PALETTE_COUNT:
+            paletteRemaining = value ? value : 256;
+            paletteNext = 0;
+            state = PALETTE_HIGH;
+            break;
+
+        case PALETTE_HIGH:
+            highByte = value;
+            state = PALETTE_LOW;
+            break;
+
+        case PALETTE_LOW:
+            // Stored as received: big-endian is already wire order
+            palette[paletteNext++] = (value << 8) | highByte;
+            state = (--paletteRemaining > 0) ? PALETTE_HIGH : INDEX_DATA;
+            break;
+
+        case INDEX_DATA: {
+            // Expand every index in the byte; padding bits after the last pixel are ignored
+            if (pixelsRemaining == 0) {
+                error = true;
+                return;
+            }
+            uint8_t mask = (1 << indexBits) - 1;
+            for (int shift = 8 - indexBits; shift >= 0 && pixelsRemaining > 0; shift -= indexBits) {
+                pixelsRemaining--;
+                sink.emitPixel(palette[(value >> shift) & mask]);
+            }
+            break;
+        }
+
+        default:
+            error = true;
+            break;
+    }
+}
+
+void PixelDecoder::decodeTrueColor(uint8_t value, PixelSink& sink) {
+    switch (state) {
+        case RGB_RED:
+            red = value;
+            state = RGB_GREEN;
+            break;
+
+        case RGB_GREEN:
+            green = value;
+            state = RGB_BLUE;
+            break;
+
+        case RGB_BLUE:
+            emit(ditherPixel(value), sink);
+            state = RGB_RED;
+            break;
+
+        default:
+            error = true;
+            break;
+    }
+}
+
+uint16_t PixelDecoder::ditherPixel(uint8_t blue) {
+    uint8_t r = red;
+    uint8_t g = green;
+    uint8_t b = blue;
+
+    if (dither == BIN_ENC_DITHER_ORDERED) {
+        uint8_t threshold = BAYER_THRESHOLDS[row & 3][column & 3];
+        r = ditherChannel(r, 31, threshold, 3);
+        g = ditherChannel(g, 63, threshold, 2);
+        b = ditherChannel(b, 31, threshold, 3);
+    } else if (dither == BIN_ENC_DITHER_DIFFUSE) {
+        // diffusion[c][x + 1] holds the previous row's error for column x and is
+        // replaced by the next row's; x (left) was consumed already, x + 2 is still pending
+        uint8_t* channels[3] = { &r, &g, &b };
+        for (uint8_t c = 0; c < 3; c++) {
+            int16_t* errors = diffusion[c];
+            uint8_t value = saturate(*channels[c] + errors[column + 1] + carry[c]);
+            uint8_t keep = c == 1 ? 0xFC : 0xF8;    // 6-bit green, 5-bit red/blue
+            uint8_t quantised = value & keep;
+            quantised |= quantised >> (c == 1 ? 6 : 5);
+            int16_t error = value - quantised;
+
+            errors[column] += error * 3 / 16;
+            errors[column + 1] = error * 5 / 16 + belowRight[c];
+            belowRight[c] = error / 16;
+            carry[c] = error * 7 / 16;
+            *channels[c] = value;
+        }
+    }
+
+    if (rowWidth > 0 && ++column >= rowWidth) {
+        column = 0;
+        row++;
+        memset(carry, 0, sizeof(carry));
+        memset(belowRight, 0, sizeof(belowRight));
+        for (uint8_t c = 0; c < 3; c++) {
+            diffusion[c][0] = 0;    // Left of column 0: written, never read
+        }
+    }
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+void PixelDecoder::remember(uint16_t color) {
+    uint8_t r = color >> 11;
+    uint8_t g = (color >> 5) & 0x3F;
+    uint8_t b = color & 0x1F;
+    index[(r * 3 + g * 5 + b * 7) & 0x3F] = color;
+    previous = color;
+}
+
+void PixelDecoder::emit(uint16_t color, PixelSink& sink) {
+    if (pixelsRemaining == 0) {
+        error = true;
+        return;
+    }
+    pixelsRemaining--;
+    if (encoding == BIN_ENC_QOI) {
+        remember(color);
+    }
+    sink.emitPixel(toWire(color));
+}
+
+void PixelDecoder::emitRun(uint16_t color, uint32_t runLength, PixelSink& sink) {
+    if (runLength > pixelsRemaining) {
+        error = true;
+        return;
+    }
+    pixelsRemaining -= runLength;
+    sink.emitRun(toWire(color), runLength);
+}
@@ -0,0 +1,140 @@
+/*
+ * PixelDecoder.h
+ * Streaming decoders for compressed and indexed RGB565 pixel payloads
+ *
+ * Encodings (ids shared with BinaryEncoding and the text SIZE ";ENC=" option):
+ *
+ * BIN_ENC_RLE - PackBits-style packets
+ *   1hhhhhhh P     Run: pixel P repeated (h + 1) times (1..128)
+ *   0hhhhhhh P...  Literal: (h + 1) pixels follow (1..128)
+ *   P is RGB565 big-endian (2 bytes)
+ *
+ * BIN_ENC_QOI - QOI-style ops adapted to RGB565 (5/6/5 bit channels)
+ *   00iiiiii       INDEX: pixel from the 64-entry recently-seen table
+ *   01rrggbb       DIFF:  channel deltas -2..1 against the previous pixel
+ *   10gggggg RRRRBBBB  LUMA: green delta -32..31, red/blue delta to it -8..7
+ *   11nnnnnn       RUN:   previous pixel repeated n + 1 times (1..62)
+ *   11111110 P     RGB565: literal pixel, big-endian
+ *   Channel arithmetic wraps; index hash is (r * 3 + g * 5 + b * 7) % 64.
+ *   The previous pixel starts as black and the table as all zero.
+ *
+ * BIN_ENC_INDEXED1/2/4/8 - Palette indices, 1, 2, 4 or 8 bits per pixel
+ *   Indices are packed MSB first and run continuously across rows; the
+ *   last byte is zero padded. Each index is expanded through a 256-entry
+ *   lookup table kept in wire order, so pixels land in the band buffer
+ *   without conversion.
+ *   With BIN_ENC_PALETTE or'd into the encoding (text: ";PAL") the payload
+ *   starts with [count][count x RGB565 big-endian] (count 0 = 256), which
+ *   replaces the palette before the indices follow. Otherwise the session
+ *   palette (BIN_OP_PALETTE, CMD:PALETTE) is used as it stands.
+ *
+ * BIN_ENC_RGB888 - Uncompressed R, G, B bytes per pixel, reduced to RGB565
+ *   on the device so the host can skip its per-pixel conversion.
+ *   Plain RGB888 truncates like BitmapSender.rgb888_to_rgb565. Or'd with
+ *   BIN_ENC_DITHER_ORDERED (text: ";DITHER=ORDERED") each channel is
+ *   rounded to its 5/6-bit level against a 4x4 Bayer threshold table; with
+ *   BIN_ENC_DITHER_DIFFUSE (";DITHER=FS") the quantisation error is spread
+ *   Floyd-Steinberg style through one error row per channel. Diffusion is
+ *   limited to DITHER_MAX_WIDTH pixel rows; wider images fall back to the
+ *   ordered dither. Both need the row width passed to begin().
+ *
+ * Decoders are fed arbitrary chunks (state survives chunk boundaries) and
+ * report pixels to a PixelSink. Runs are reported as runs so the sink can
+ * map whole rows of one colour onto fillRect.
+ */
+
+#ifndef PIXEL_DECODER_H
+#define PIXEL_DECODER_H
+
+#include <Arduino.h>
+
+// Receiver of decoded pixels (wire byte order, as stored in band buffers)
+class PixelSink {
+public:
+    virtual void emitPixel(uint16_t wirePixel) = 0;
+    virtual void emitRun(uint16_t wirePixel, uint32_t count) = 0;
+};
+
+class PixelDecoder {
+public:
+    PixelDecoder();
+
+    static const uint16_t DITHER_MAX_WIDTH = 320;
+
+    // Start a stream of pixelCount pixels in rows of width pixels; false if encoding
+    // is not compressed/known (pixelCount 0 with an indexed BIN_ENC_PALETTE encoding
+    // loads just a palette). Dithered RGB888 needs width.
+    bool begin(uint8_t encoding, uint32_t pixelCount, uint16_t width = 0);
+
+    // Decode length bytes; stops (with an error) once pixelCount is exceeded
+    void decode(const uint8_t* data, size_t length, PixelSink& sink);
+
+    bool isComplete() const { return pixelsRemaining == 0 && paletteRemaining == 0 && !error; }
+    bool hasError() const { return error; }
+
+    // Session palette entry (native RGB565), kept across streams
+    void setPaletteColor(uint8_t index, uint16_t color);
+
+    static bool isSupported(uint8_t encoding);
+    static bool isIndexed(uint8_t encoding);
+    static bool isTrueColor(uint8_t encoding);
+
+    // Text protocol name ("RLE", "IDX4", ...) ignoring modifier bits; nullptr if unknown
+    static const char* encodingName(uint8_t encoding);
+    // Inverse of encodingName(); returns false if the name is unknown
+    static bool encodingFromName(const char* name, uint8_t& encoding);
+
+private:
+    enum State {
+        RLE_HEADER,
+        RLE_RUN_HIGH,
+        RLE_RUN_LOW,
+        RLE_LITERAL_HIGH,
+        RLE_LITERAL_LOW,
+        QOI_OP,
+        QOI_LUMA,
+        QOI_RGB_HIGH,
+        QOI_RGB_LOW,
+        PALETTE_COUNT,
+        PALETTE_HIGH,
+        PALETTE_LOW,
+        INDEX_DATA,
+        RGB_RED,
+        RGB_GREEN,
+        RGB_BLUE
+    };
+
+    void decodeRle(uint8_t value, PixelSink& sink);
+    void decodeQoi(uint8_t value, PixelSink& sink);
+    void decodeIndexed(uint8_t value, PixelSink& sink);
+    void decodeTrueColor(uint8_t value, PixelSink& sink);
+    uint16_t ditherPixel(uint8_t blue);
+    void emit(uint16_t color, PixelSink& sink);
+    void emitRun(uint16_t color, uint32_t count, PixelSink& sink);
+    void remember(uint16_t color);
+
+    uint8_t encoding;
+    State state;
+    uint32_t pixelsRemaining;
+    bool error;
+    uint8_t highByte;
+    uint8_t count;             // RLE run/literal pixels left
+    int8_t lumaGreen;          // QOI LUMA green delta pending second byte
+    uint16_t previous;         // Native RGB565
+    uint16_t index[64];
+    uint8_t indexBits;         // Bits per palette index
+    uint16_t paletteRemaining; // Inline palette entries still expected
+    uint16_t paletteNext;      // Next palette entry to fill
+    uint16_t palette[256];     // Wire order
+    uint8_t red;               // RGB888 channels of the pixel being assembled
+    uint8_t green;
+    uint8_t dither;            // BIN_ENC_DITHER_* mode of the stream
+    uint16_t rowWidth;
+    uint16_t column;           // Position of the next RGB888 pixel
+    uint16_t row;
+    int16_t carry[3];          // Error diffused to the right neighbour (per channel)
+    int16_t belowRight[3];     // Error for the pixel below-right, added one step late
+    int16_t diffusion[3][DITHER_MAX_WIDTH + 1]; // Next-row errors, shifted by one column
+};
+
+#endif // PIXEL_DECODER_H
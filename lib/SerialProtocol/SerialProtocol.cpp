@@ -4,22 +4,79 @@
  */
 
 #include "SerialProtocol.h"
+#include "Telemetry.h"
+#include <malloc.h>
 
-SerialProtocol::SerialProtocol(DisplayManager& displayMgr, Stream& serial)
+SerialProtocol::SerialProtocol(DisplayManager& displayMgr, BufferedSerial& serial)
     : displayManager(displayMgr)
     , serialPort(serial)
     , currentState(WAITING_FOR_DISPLAY_SELECT)
     , activeDisplay(nullptr)
+    , selectedMask(0)
     , bitmapWidth(0)
     , bitmapHeight(0)
     , currentRow(0)
     , currentCol(0)
-    , offsetX(0)
-    , offsetY(0)
+    , partialUpdate(false)
+    , pixelEncoding(BIN_ENC_RGB565)
+    , pixelBytesRemaining(0)
+    , pendingPixelByte(-1)
+    , pixelError(nullptr)
+    , creditEnabled(false)
+    , creditSequence(0)
+    , creditTotal(0)
+    , creditEdge(0)
+    , targetCount(0)
+    , lineBuffer(lineBuffers[0])
+    , visibleRowStart(0)
+    , visibleRowEnd(0)
+    , bandCapacity(0)
+    , bandStartRow(0)
+    , bandRowCount(0)
+    , vsyncDisplay(nullptr)
+    , capturePixels(nullptr)
+    , commandLength(0)
+    , cacheId(-1)
+    , cacheWrite(nullptr)
+    , streamActive(false)
+    , streamTargetCount(0)
+    , streamWidth(0)
+    , streamHeight(0)
+    , streamEncoding(BIN_ENC_RGB565)
+    , streamParams()
+    , pendingStreamParams()
+    , streamIntervalMicros(0)
+    , streamVsyncDisplay(nullptr)
+    , streamDueMicros(0)
+    , streamStartMillis(0)
+    , streamLastFrameMillis(0)
+    , streamFramesShown(0)
+    , streamFramesDropped(0)
+    , binaryHeaderBytes(0)
+    , binaryPayloadRemaining(0)
+    , binaryCrc(0)
+    , binaryDiscard(false)
+    , binaryStatus(BIN_STATUS_OK)
+    , binaryReturnState(WAITING_FOR_DISPLAY_SELECT)
+    , batchOp()
+    , batchOpBytes(0)
+    , batchOperandRemaining(0)
+    , batchOpsDone(0)
+    , transferStartMicros(0)
+    , transferBytes(0)
+    , lastTransferBytes(0)
+    , lastTransferMicros(0)
+    , statsIntervalStart(0)
+    , statsIntervalBytes(0)
+    , commandCount(0)
+    , lastCommandMicros(0)
+    , maxCommandMicros(0)
+    , heapPeak(0)
     , lastActivity(0)
     , imageFrameEnabled(true)
     , imageFrameColor(ST77XX_WHITE)
     , imageFrameThickness(1)
+    , fitImages(false)
     , usableAreaAdjustTop(0)
     , usableAreaAdjustBottom(0)
     , usableAreaAdjustLeft(0)
@@ -28,776 +85,3155 @@ SerialProtocol::SerialProtocol(DisplayManager& displayMgr, Stream& serial)
 
 void SerialProtocol::process() {
     if (!serialPort.available()) {
+        // Stored playback runs while the link is idle
+        if (Playback::isActive() && !isTransferActive() && !streamActive) {
+            Playback::service(*this);
+        }
+        return;
+    }
+    
+    lastActivity = millis();
+    
+    // Binary frames may start whenever no text transfer is in progress
+    if (isBinaryFrameStart()) {
+        stopPlayback();
+        binaryReturnState = currentState == BITMAP_COMPLETE ? WAITING_FOR_START : currentState;
+        binaryHeaderBytes = 0;
+        currentState = RECEIVING_BINARY_HEADER;
+    }
+    
+    // Payload states move pixels; every other state parses text or frame headers
+    switch (currentState) {
+        case WAITING_FOR_DISPLAY_SELECT: {
+            TELEMETRY_SCOPE(TELEMETRY_PARSE);
+            handleDisplaySelect();
+            break;
+        }
+            
+        case WAITING_FOR_START: {
+            TELEMETRY_SCOPE(TELEMETRY_PARSE);
+            handleStart();
+            break;
+        }
+            
+        case WAITING_FOR_SIZE: {
+            TELEMETRY_SCOPE(TELEMETRY_PARSE);
+            handleSize();
+            break;
+        }
+            
+        case RECEIVING_DATA: {
+            TELEMETRY_SCOPE(TELEMETRY_PAYLOAD);
+            handleDataReception();
+            break;
+        }
+            
+        case WAITING_FOR_END: {
+            TELEMETRY_SCOPE(TELEMETRY_PARSE);
+            handleEnd();
+            break;
+        }
+            
+        case BITMAP_COMPLETE: {
+            TELEMETRY_SCOPE(TELEMETRY_PARSE);
+            handleComplete();
+            break;
+        }
+            
+        case RECEIVING_BINARY_HEADER: {
+            TELEMETRY_SCOPE(TELEMETRY_PARSE);
+            handleBinaryHeader();
+            break;
+        }
+            
+        case RECEIVING_BINARY_PAYLOAD: {
+            TELEMETRY_SCOPE(TELEMETRY_PAYLOAD);
+            handleBinaryPayload();
+            break;
+        }
+    }
+}
+
+bool SerialProtocol::isTransferActive() const {
+    return currentState != WAITING_FOR_DISPLAY_SELECT &&
+           currentState != WAITING_FOR_START &&
+           currentState != BITMAP_COMPLETE;
+}
+
+// Text lines are parsed in place in commandLine: no String temporaries, so the
+// protocol path makes no heap allocations once setup() has finished
+
+// Strip leading and trailing whitespace in place
+static char* trimLine(char* line) {
+    while (isspace((unsigned char)*line)) {
+        line++;
+    }
+    size_t length = strlen(line);
+    while (length > 0 && isspace((unsigned char)line[length - 1])) {
+        line[--length] = '\0';
+    }
+    return line;
+}
+
+static bool startsWith(const char* text, const char* prefix) {
+    return strncmp(text, prefix, strlen(prefix)) == 0;
+}
+
+// Split off the text before the next separator (terminated in place); cursor
+// moves past the separator, or becomes nullptr after the last field
+static char* nextField(char*& cursor, char separator) {
+    char* field = cursor;
+    char* end = strchr(cursor, separator);
+    if (end) {
+        *end = '\0';
+        cursor = end + 1;
+    } else {
+        cursor = nullptr;
+    }
+    return field;
+}
+
+// Comma-separated integers (toInt() rules: empty or garbage fields are 0).
+// Stores up to maxCount values and returns the number of fields present
+static int parseNumbers(char* text, long* values, int maxCount) {
+    int count = 0;
+    for (char* cursor = text; cursor; count++) {
+        char* field = nextField(cursor, ',');
+        if (count < maxCount) {
+            values[count] = atol(field);
+        }
+    }
+    return count;
+}
+
+void SerialProtocol::handleDisplaySelect() {
+    // Act on complete lines only; a partial line stays in commandLine
+    if (!readCommandLine()) {
+        return;
+    }
+    char* command = trimLine(commandLine);
+    
+    // Handle CMD: commands
+    if (startsWith(command, "CMD:")) {
+        handleMenuCommand(command + 4);
+        return;
+    }
+    
+    // Handle RESET command
+    if (strcmp(command, "RESET") == 0) {
+        reset();
+        serialPort.println("Protocol reset");
+        return;
+    }
+    
+    // Handle FRAME commands
+    if (startsWith(command, "FRAME:")) {
+        const char* frameCmd = command + 6;
+    
+        if (strcmp(frameCmd, "ON") == 0) {
+            imageFrameEnabled = true;
+            serialPort.println("Frame enabled");
+        } else if (strcmp(frameCmd, "OFF") == 0) {
+            imageFrameEnabled = false;
+            serialPort.println("Frame disabled");
+        } else if (startsWith(frameCmd, "COLOR:")) {
+            // Parse color value (e.g., "COLOR:31" for blue)
+            imageFrameColor = atol(frameCmd + 6);
+            serialPort.print("Frame color set to: ");
+            serialPort.println(imageFrameColor);
+        } else if (startsWith(frameCmd, "THICKNESS:")) {
+            // Parse thickness value (e.g., "THICKNESS:2")
+            imageFrameThickness = atol(frameCmd + 10);
+            serialPort.print("Frame thickness set to: ");
+            serialPort.println(imageFrameThickness);
+        }
+        return;
+    }
+    
+    // Handle DISPLAY: command (bitmap protocol)
+    if (startsWith(command, "DISPLAY:")) {
+        const char* displayName = trimLine(command + 8);
+    
+        // Look up display(s) by name: "A", "A,B" or "ALL"
+        uint8_t mask = displayManager.resolveDisplayMask(displayName);
+    
+        if (mask) {
+            selectDisplays(mask);
+            serialPort.print("DISPLAY_READY:");
+            serialPort.println(displayName);
+            currentState = WAITING_FOR_START;
+            lastActivity = millis();
+            return;
+        } else {
+            sendError("Display not found: ", displayName);
+            return;
+        }
+    }
+    
+    if (*command) {
+        serialPort.println("Ready for next bitmap");
+    }
+}
+
+// CMD: handlers by name, kept in strcmp() order for the binary search in
+// findMenuCommand(). A command either never, always or optionally takes
+// ":<args>"; any other form is an unknown command
+const SerialProtocol::MenuCommand SerialProtocol::MENU_COMMANDS[] = {
+    { "ADJUST_BOTTOM",   MENU_ARGS_REQUIRED, &SerialProtocol::cmdAdjustBottom },
+    { "ADJUST_LEFT",     MENU_ARGS_REQUIRED, &SerialProtocol::cmdAdjustLeft },
+    { "ADJUST_RIGHT",    MENU_ARGS_REQUIRED, &SerialProtocol::cmdAdjustRight },
+    { "ADJUST_TOP",      MENU_ARGS_REQUIRED, &SerialProtocol::cmdAdjustTop },
+    { "BENCH",           MENU_ARGS_OPTIONAL, &SerialProtocol::runBenchmark },
+    { "CACHE_CLEAR",     MENU_ARGS_NONE,     &SerialProtocol::cmdCacheClear },
+    { "CACHE_DROP",      MENU_ARGS_REQUIRED, &SerialProtocol::cmdCacheDrop },
+    { "CACHE_LIST",      MENU_ARGS_NONE,     &SerialProtocol::cmdCacheList },
+    { "CACHE_SHOW",      MENU_ARGS_REQUIRED, &SerialProtocol::cmdCacheShow },
+    { "CALIBRATE",       MENU_ARGS_NONE,     &SerialProtocol::cmdCalibrate },
+    { "FIT_OFF",         MENU_ARGS_NONE,     &SerialProtocol::cmdFitOff },
+    { "FIT_ON",          MENU_ARGS_NONE,     &SerialProtocol::cmdFitOn },
+    { "FRAME_COLOR",     MENU_ARGS_REQUIRED, &SerialProtocol::cmdFrameColor },
+    { "FRAME_OFF",       MENU_ARGS_NONE,     &SerialProtocol::cmdFrameOff },
+    { "FRAME_ON",        MENU_ARGS_NONE,     &SerialProtocol::cmdFrameOn },
+    { "FRAME_THICKNESS", MENU_ARGS_REQUIRED, &SerialProtocol::cmdFrameThickness },
+    { "HELP",            MENU_ARGS_NONE,     &SerialProtocol::cmdHelp },
+    { "INFO",            MENU_ARGS_NONE,     &SerialProtocol::cmdInfo },
+    { "LIST",            MENU_ARGS_NONE,     &SerialProtocol::cmdList },
+    { "ORIENTATION",     MENU_ARGS_REQUIRED, &SerialProtocol::cmdOrientation },
+    { "PALETTE",         MENU_ARGS_REQUIRED, &SerialProtocol::cmdPalette },
+    { "PLAY",            MENU_ARGS_REQUIRED, &SerialProtocol::cmdPlay },
+    { "PROFILE",         MENU_ARGS_NONE,     &SerialProtocol::cmdProfile },
+    { "RESET",           MENU_ARGS_NONE,     &SerialProtocol::cmdReset },
+    { "SCROLL",          MENU_ARGS_REQUIRED, &SerialProtocol::cmdScroll },
+    { "SCROLL_AREA",     MENU_ARGS_OPTIONAL, &SerialProtocol::cmdScrollArea },
+    { "SCROLL_OFF",      MENU_ARGS_NONE,     &SerialProtocol::cmdScrollOff },
+    { "SNAPSHOT",        MENU_ARGS_OPTIONAL, &SerialProtocol::cmdSnapshot },
+    { "SNAPSHOT_CLEAR",  MENU_ARGS_NONE,     &SerialProtocol::cmdSnapshotClear },
+    { "SNAPSHOT_INFO",   MENU_ARGS_NONE,     &SerialProtocol::cmdSnapshotInfo },
+    { "STATS",           MENU_ARGS_NONE,     &SerialProtocol::cmdStats },
+    { "STATS_RESET",     MENU_ARGS_NONE,     &SerialProtocol::cmdStatsReset },
+    { "STOP",            MENU_ARGS_NONE,     &SerialProtocol::cmdStop },
+    { "STORE_ADD",       MENU_ARGS_REQUIRED, &SerialProtocol::cmdStoreAdd },
+    { "STORE_DELETE",    MENU_ARGS_REQUIRED, &SerialProtocol::cmdStoreDelete },
+    { "STORE_FORMAT",    MENU_ARGS_NONE,     &SerialProtocol::cmdStoreFormat },
+    { "STORE_INFO",      MENU_ARGS_NONE,     &SerialProtocol::cmdStoreInfo },
+    { "STORE_LIST",      MENU_ARGS_NONE,     &SerialProtocol::cmdStoreList },
+    { "STORE_PLAYLIST",  MENU_ARGS_REQUIRED, &SerialProtocol::cmdStorePlaylist },
+    { "STORE_SAVE",      MENU_ARGS_REQUIRED, &SerialProtocol::cmdStoreSave },
+    { "STREAM_STATS",    MENU_ARGS_NONE,     &SerialProtocol::cmdStreamStats },
+    { "TEST",            MENU_ARGS_NONE,     &SerialProtocol::cmdTest },
+    { "TEST_ALL",        MENU_ARGS_NONE,     &SerialProtocol::cmdTestAll },
+    { "TEXT",            MENU_ARGS_REQUIRED, &SerialProtocol::cmdText },
+    { "TILES",           MENU_ARGS_REQUIRED, &SerialProtocol::cmdTiles },
+    { "UPDATE_CONFIG",   MENU_ARGS_REQUIRED, &SerialProtocol::cmdUpdateConfig },
+};
+const uint8_t SerialProtocol::MENU_COMMAND_COUNT = sizeof(MENU_COMMANDS) / sizeof(MENU_COMMANDS[0]);
+
+const SerialProtocol::MenuCommand* SerialProtocol::findMenuCommand(const char* name) {
+    int low = 0;
+    int high = MENU_COMMAND_COUNT - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        int order = strcmp(name, MENU_COMMANDS[middle].name);
+        if (order == 0) {
+            return &MENU_COMMANDS[middle];
+        }
+        if (order < 0) {
+            high = middle - 1;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return nullptr;
+}
+
+void SerialProtocol::handleMenuCommand(char* command) {
+    // Handle menu/control commands (CMD: prefix already stripped): NAME or NAME:args
+    unsigned long start = micros();
+    char* cmd = trimLine(command);
+    char* args = strchr(cmd, ':');
+    if (args) {
+        *args++ = '\0';
+    }
+    
+    const MenuCommand* entry = findMenuCommand(cmd);
+    if (!entry || (args ? entry->arguments == MENU_ARGS_NONE : entry->arguments == MENU_ARGS_REQUIRED)) {
+        serialPort.print("ERROR:Unknown command: ");
+        serialPort.print(cmd);
+        if (args) {
+            serialPort.print(":");
+            serialPort.print(args);
+        }
+        serialPort.println();
+    } else {
+        // Handlers always get a string; it is empty when no ":<args>" was given
+        (this->*entry->handler)(args ? args : cmd + strlen(cmd));
+    }
+    
+    // Latency of the whole command, reply included (CMD:STATS)
+    lastCommandMicros = micros() - start;
+    if (lastCommandMicros > maxCommandMicros) {
+        maxCommandMicros = lastCommandMicros;
+    }
+    commandCount++;
+    sampleHeap();
+}
+
+void SerialProtocol::cmdReset(char* args) {
+    // Reset protocol state
+    reset();
+    serialPort.println("OK:Protocol reset");
+}
+
+void SerialProtocol::cmdList(char* args) {
+    // List all registered displays
+    serialPort.println("OK:DISPLAY_LIST");
+    int count = displayManager.getDisplayCount();
+    serialPort.print("Count:");
+    serialPort.println(count);
+    
+    // Use DisplayManager's listDisplays method
+    displayManager.listDisplays(serialPort);
+    
+    serialPort.println("END_LIST");
+}
+
+void SerialProtocol::cmdInfo(char* args) {
+    // Show active display info
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    const DisplayConfig& cfg = activeDisplay->getConfig();
+    serialPort.println("OK:DISPLAY_INFO");
+    serialPort.print("Name:");
+    serialPort.println(cfg.name);
+    serialPort.print("Resolution:");
+    serialPort.print(cfg.usableWidth);
+    serialPort.print("x");
+    serialPort.println(cfg.usableHeight);
+    serialPort.print("Rotation:");
+    serialPort.println(cfg.rotation);
+    serialPort.print("SpiClock:");
+    serialPort.println(activeDisplay->getSpiFrequency());
+    serialPort.print("TePin:");
+    if (cfg.te == DISPLAY_PIN_NONE) {
+        serialPort.println("None");
+    } else {
+        serialPort.println(cfg.te);
+        serialPort.print("VsyncPeriodUs:");
+        serialPort.println(activeDisplay->getVsyncPeriod());
+    }
+    serialPort.print("FrameEnabled:");
+    serialPort.println(imageFrameEnabled ? "Yes" : "No");
+    serialPort.print("FrameColor:");
+    serialPort.println(imageFrameColor);
+    serialPort.print("FrameThickness:");
+    serialPort.println(imageFrameThickness);
+    serialPort.print("Fit:");
+    serialPort.println(fitImages ? "Yes" : "No");
+    serialPort.print("UsableAreaAdjustTop:");
+    serialPort.println(usableAreaAdjustTop);
+    serialPort.print("UsableAreaAdjustBottom:");
+    serialPort.println(usableAreaAdjustBottom);
+    serialPort.print("UsableAreaAdjustLeft:");
+    serialPort.println(usableAreaAdjustLeft);
+    serialPort.print("UsableAreaAdjustRight:");
+    serialPort.println(usableAreaAdjustRight);
+    serialPort.print("CenterX:");
+    serialPort.println(cfg.centerX);
+    serialPort.print("CenterY:");
+    serialPort.println(cfg.centerY);
+    serialPort.println("END_INFO");
+}
+
+void SerialProtocol::cmdTest(char* args) {
+    // Test active display
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    serialPort.print("OK:Testing display ");
+    serialPort.println(activeDisplay->getName());
+    activeDisplay->showTestPattern();
+    serialPort.println("Test pattern displayed");
+}
+
+void SerialProtocol::cmdTestAll(char* args) {
+    // Test all displays
+    serialPort.println("OK:Testing all displays");
+    displayManager.showAllTestPatterns();
+    serialPort.println("All test patterns displayed");
+}
+
+void SerialProtocol::cmdFrameOn(char* args) {
+    // Enable frame on active display
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    activeDisplay->enableImageFrame(true, imageFrameColor, imageFrameThickness,
+                                   usableAreaAdjustTop, usableAreaAdjustBottom,
+                                   usableAreaAdjustLeft, usableAreaAdjustRight);
+    imageFrameEnabled = true;
+    serialPort.println("OK:Frame enabled");
+}
+
+void SerialProtocol::cmdFrameOff(char* args) {
+    // Disable frame on active display
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    activeDisplay->enableImageFrame(false);
+    imageFrameEnabled = false;
+    serialPort.println("OK:Frame disabled");
+}
+
+void SerialProtocol::cmdFitOn(char* args) {
+    // Centred images follow each display's shape and size
+    fitImages = true;
+    serialPort.println("OK:Fit enabled");
+}
+
+void SerialProtocol::cmdFitOff(char* args) {
+    fitImages = false;
+    serialPort.println("OK:Fit disabled");
+}
+
+void SerialProtocol::cmdFrameColor(char* args) {
+    // Set frame color
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    uint16_t color = atol(args);
+    imageFrameColor = color;
+    imageFrameEnabled = true;
+    serialPort.print("OK:Frame color set to ");
+    serialPort.println(color);
+    
+    // Immediately update display with new color
+    activeDisplay->updateCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
+                                         usableAreaAdjustLeft, usableAreaAdjustRight,
+                                         color, imageFrameThickness);
+}
+
+void SerialProtocol::cmdFrameThickness(char* args) {
+    // Set frame thickness
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    int thickness = atol(args);
+    
+    if (thickness < 1 || thickness > 10) {
+        serialPort.println("ERROR:Thickness must be between 1 and 10");
+        return;
+    }
+    
+    imageFrameThickness = thickness;
+    imageFrameEnabled = true;
+    serialPort.print("OK:Frame thickness set to ");
+    serialPort.println(thickness);
+    
+    // Immediately update display with new thickness
+    activeDisplay->updateCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
+                                         usableAreaAdjustLeft, usableAreaAdjustRight,
+                                         imageFrameColor, thickness);
+}
+
+void SerialProtocol::cmdAdjustTop(char* args) {
+    // Adjust usable area top edge
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    int8_t adjust = atol(args);
+    
+    const DisplayConfig& cfg = activeDisplay->getConfig();
+    // Top is inverted: positive adjustment moves edge UP (decreases Y)
+    int newTop = cfg.usableY - adjust;
+    
+    // Inner bound: center - 10 pixels
+    // Outer bound: -10 pixels (10 pixels beyond published top edge)
+    int innerBound = cfg.centerY - 10;
+    int outerBound = -10;
+    
+    if (newTop < outerBound) {
+        serialPort.print("ERROR:Top edge would be beyond limit (maximum adjustment: ");
+        serialPort.print(cfg.usableY - outerBound);
+        serialPort.println(")");
+        return;
+    }
+    
+    if (newTop > innerBound) {
+        serialPort.print("ERROR:Top edge would be past center-10 (minimum adjustment: ");
+        serialPort.print(cfg.usableY - innerBound);
+        serialPort.println(")");
+        return;
+    }
+    
+    usableAreaAdjustTop = adjust;
+    serialPort.print("OK:Top edge adjusted to ");
+    serialPort.println(adjust);
+    
+    // Notify if at outer limit
+    if (newTop <= -10) {
+        serialPort.println("NOTICE:Top edge at maximum outward position (-10 pixels beyond display)");
+    }
+    
+    // Immediately update display
+    activeDisplay->updateCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
+                                         usableAreaAdjustLeft, usableAreaAdjustRight,
+                                         imageFrameColor, imageFrameThickness);
+}
+
+void SerialProtocol::cmdAdjustBottom(char* args) {
+    // Adjust usable area bottom edge
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    int8_t adjust = atol(args);
+    
+    const DisplayConfig& cfg = activeDisplay->getConfig();
+    int configBottom = cfg.usableY + cfg.usableHeight - 1;
+    int newBottom = configBottom + adjust;
+    
+    // Inner bound: center + 10 pixels
+    // Outer bound: height + 10 - 1 (10 pixels beyond published bottom edge)
+    int innerBound = cfg.centerY + 10;
+    int outerBound = cfg.height + 10 - 1;
+    
+    if (newBottom > outerBound) {
+        serialPort.print("ERROR:Bottom edge would be beyond limit (maximum: ");
+        serialPort.print(outerBound - configBottom);
+        serialPort.println(")");
+        return;
+    }
+    
+    if (newBottom < innerBound) {
+        serialPort.print("ERROR:Bottom edge would be past center+10 (minimum: ");
+        serialPort.print(innerBound - configBottom);
+        serialPort.println(")");
+        return;
+    }
+    
+    usableAreaAdjustBottom = adjust;
+    serialPort.print("OK:Bottom edge adjusted to ");
+    serialPort.println(adjust);
+    
+    // Notify if at outer limit
+    if (newBottom >= cfg.height + 10 - 1) {
+        serialPort.print("NOTICE:Bottom edge at maximum outward position (");
+        serialPort.print(cfg.height + 10 - 1);
+        serialPort.println(" pixels, 10 beyond display)");
+    }
+    
+    // Immediately update display
+    activeDisplay->updateCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
+                                         usableAreaAdjustLeft, usableAreaAdjustRight,
+                                         imageFrameColor, imageFrameThickness);
+}
+
+void SerialProtocol::cmdAdjustLeft(char* args) {
+    // Adjust usable area left edge
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    int8_t adjust = atol(args);
+    
+    const DisplayConfig& cfg = activeDisplay->getConfig();
+    // Left is inverted: positive adjustment moves edge LEFT (decreases X)
+    int newLeft = cfg.usableX - adjust;
+    
+    // Inner bound: center - 10 pixels
+    // Outer bound: -10 pixels (10 pixels beyond published left edge)
+    int innerBound = cfg.centerX - 10;
+    int outerBound = -10;
+    
+    if (newLeft < outerBound) {
+        serialPort.print("ERROR:Left edge would be beyond limit (maximum adjustment: ");
+        serialPort.print(cfg.usableX - outerBound);
+        serialPort.println(")");
+        return;
+    }
+    
+    if (newLeft > innerBound) {
+        serialPort.print("ERROR:Left edge would be past center-10 (minimum adjustment: ");
+        serialPort.print(cfg.usableX - innerBound);
+        serialPort.println(")");
+        return;
+    }
+    
+    usableAreaAdjustLeft = adjust;
+    serialPort.print("OK:Left edge adjusted to ");
+    serialPort.println(adjust);
+    
+    // Notify if at outer limit
+    if (newLeft <= -10) {
+        serialPort.println("NOTICE:Left edge at maximum outward position (-10 pixels beyond display)");
+    }
+    
+    // Immediately update display
+    activeDisplay->updateCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
+                                         usableAreaAdjustLeft, usableAreaAdjustRight,
+                                         imageFrameColor, imageFrameThickness);
+}
+
+void SerialProtocol::cmdAdjustRight(char* args) {
+    // Adjust usable area right edge
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    int8_t adjust = atol(args);
+    
+    const DisplayConfig& cfg = activeDisplay->getConfig();
+    int configRight = cfg.usableX + cfg.usableWidth - 1;
+    int newRight = configRight + adjust;
+    
+    // Inner bound: center + 10 pixels
+    // Outer bound: width + 10 - 1 (10 pixels beyond published right edge)
+    int innerBound = cfg.centerX + 10;
+    int outerBound = cfg.width + 10 - 1;
+    
+    if (newRight > outerBound) {
+        serialPort.print("ERROR:Right edge would be beyond limit (maximum: ");
+        serialPort.print(outerBound - configRight);
+        serialPort.println(")");
+        return;
+    }
+    
+    if (newRight < innerBound) {
+        serialPort.print("ERROR:Right edge would be past center+10 (minimum: ");
+        serialPort.print(innerBound - configRight);
+        serialPort.println(")");
+        return;
+    }
+    
+    usableAreaAdjustRight = adjust;
+    serialPort.print("OK:Right edge adjusted to ");
+    serialPort.println(adjust);
+    
+    // Notify if at outer limit
+    if (newRight >= cfg.width + 10 - 1) {
+        serialPort.print("NOTICE:Right edge at maximum outward position (");
+        serialPort.print(cfg.width + 10 - 1);
+        serialPort.println(" pixels, 10 beyond display)");
+    }
+    
+    // Immediately update display
+    activeDisplay->updateCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
+                                         usableAreaAdjustLeft, usableAreaAdjustRight,
+                                         imageFrameColor, imageFrameThickness);
+}
+
+void SerialProtocol::cmdCalibrate(char* args) {
+    // Show calibration pattern on active display
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    serialPort.print("OK:Showing calibration pattern on ");
+    serialPort.println(activeDisplay->getName());
+    activeDisplay->drawCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
+                                       usableAreaAdjustLeft, usableAreaAdjustRight,
+                                       imageFrameColor, imageFrameThickness);
+    serialPort.println("Calibration pattern displayed");
+}
+
+void SerialProtocol::cmdUpdateConfig(char* args) {
+    // Update base configuration values
+    // Format: UPDATE_CONFIG:left,right,top,bottom,centerX,centerY
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    long values[6];
+    int count = parseNumbers(args, values, 6);
+    if (count > 6) {
+        serialPort.println("ERROR:Too many parameters");
+        return;
+    }
+    
+    if (count != 6) {
+        serialPort.println("ERROR:Expected 6 parameters (left,right,top,bottom,centerX,centerY)");
+        return;
+    }
+    
+    // Update the display's configuration
+    DisplayConfig& cfg = const_cast<DisplayConfig&>(activeDisplay->getConfig());
+    cfg.usableX = values[0];  // left
+    cfg.usableWidth = values[1] - values[0] + 1;  // width from right-left+1
+    cfg.usableY = values[2];  // top
+    cfg.usableHeight = values[3] - values[2] + 1;  // height from bottom-top+1
+    cfg.centerX = values[4];
+    cfg.centerY = values[5];
+    
+    // Reset adjustments since we're committing to new base config
+    usableAreaAdjustTop = 0;
+    usableAreaAdjustBottom = 0;
+    usableAreaAdjustLeft = 0;
+    usableAreaAdjustRight = 0;
+    
+    serialPort.println("OK:Base configuration updated");
+    serialPort.print("New usable area: ");
+    serialPort.print(cfg.usableX);
+    serialPort.print(",");
+    serialPort.print(cfg.usableX + cfg.usableWidth - 1);
+    serialPort.print(",");
+    serialPort.print(cfg.usableY);
+    serialPort.print(",");
+    serialPort.println(cfg.usableY + cfg.usableHeight - 1);
+    serialPort.print("New center: ");
+    serialPort.print(cfg.centerX);
+    serialPort.print(",");
+    serialPort.println(cfg.centerY);
+    serialPort.println("NOTE:Changes lost on power cycle - update .config file for permanent storage");
+}
+
+void SerialProtocol::cmdOrientation(char* args) {
+    // Set display orientation/rotation
+    // Format: ORIENTATION:value (0-3)
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    int rotation = atol(args);
+    
+    if (rotation < 0 || rotation > 3) {
+        serialPort.println("ERROR:Invalid orientation. Use 0-3 (0=Portrait, 1=Landscape, 2=Reverse Portrait, 3=Reverse Landscape)");
+        return;
+    }
+    
+    Adafruit_ST7735* tft = activeDisplay->getTFT();
+    if (!tft) {
+        serialPort.println("ERROR:Display not initialized");
+        return;
+    }
+    
+    activeDisplay->resetScroll();   // The scroll axis follows the rotation
+    tft->setRotation(rotation);
+    serialPort.print("OK:Orientation set to ");
+    serialPort.println(rotation);
+}
+
+void SerialProtocol::cmdScrollArea(char* args) {
+    // Hardware scroll area: SCROLL_AREA[:start,length] along the panel's scroll axis
+    // (rows in rotations 0/2, columns in 1/3); default = usable area inside the frame
+    if (!activeDisplay || !activeDisplay->getTFT()) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    
+    const DisplayConfig& cfg = activeDisplay->getConfig();
+    bool vertical = activeDisplay->isScrollVertical();
+    int inset = imageFrameEnabled ? imageFrameThickness : 0;
+    int start = (vertical ? cfg.usableY : cfg.usableX) + inset;
+    int length = (vertical ? cfg.usableHeight : cfg.usableWidth) - 2 * inset;
+    if (*args) {
+        const char* comma = strchr(args, ',');
+        if (!comma) {
+            serialPort.println("ERROR:Invalid format. Use SCROLL_AREA:start,length");
+            return;
+        }
+        start = atol(args);
+        length = atol(comma + 1);
+    }
+    
+    if (!activeDisplay->setScrollArea(start, length)) {
+        serialPort.println("ERROR:Invalid scroll area");
+        return;
+    }
+    serialPort.print("OK:Scroll area ");
+    serialPort.print(vertical ? "ROWS:" : "COLUMNS:");
+    serialPort.print(start);
+    serialPort.print(",");
+    serialPort.println(length);
+}
+
+void SerialProtocol::cmdScroll(char* args) {
+    // Advance the scroll area by n lines and blank the lines exposed at its end.
+    // Reply: OK:SCROLL:<pos>,<count>[,<pos>,<count>] - the logical line span(s) to draw
+    // the new lines into, in screen order (two spans when the area wraps)
+    if (!activeDisplay || !activeDisplay->isScrolling()) {
+        serialPort.println("ERROR:No scroll area (use CMD:SCROLL_AREA)");
+        return;
+    }
+    
+    int lines = atol(args);
+    int start = activeDisplay->getScrollStart();
+    int length = activeDisplay->getScrollLength();
+    if (lines <= 0 || lines >= length) {
+        serialPort.println("ERROR:Invalid scroll lines");
+        return;
+    }
+    activeDisplay->scrollBy(lines);
+    
+    // Logical lines run on in screen order until they wrap to the area start
+    int first = activeDisplay->scrollLineToLogical(start + length - lines);
+    int firstCount = min(lines, start + length - first);
+    fillScrollLines(activeDisplay, first, firstCount);
+    serialPort.print("OK:SCROLL:");
+    serialPort.print(first);
+    serialPort.print(",");
+    serialPort.print(firstCount);
+    if (firstCount < lines) {
+        fillScrollLines(activeDisplay, start, lines - firstCount);
+        serialPort.print(",");
+        serialPort.print(start);
+        serialPort.print(",");
+        serialPort.print(lines - firstCount);
+    }
+    serialPort.println();
+}
+
+void SerialProtocol::cmdScrollOff(char* args) {
+    // Back to a fixed screen (contents stay where the memory holds them)
+    if (!activeDisplay) {
+        serialPort.println("ERROR:No active display selected");
+        return;
+    }
+    activeDisplay->resetScroll();
+    serialPort.println("OK:Scrolling off");
+}
+
+void SerialProtocol::cmdPalette(char* args) {
+    // Load the session palette for indexed encodings: PALETTE:c0,c1,... (RGB565, 0-65535)
+    int count = 0;
+    char* cursor = args;
+    while (cursor && *cursor && count < 256) {
+        decoder.setPaletteColor(count++, atol(nextField(cursor, ',')));
+    }
+    serialPort.print("OK:Palette loaded, entries: ");
+    serialPort.println(count);
+}
+
+void SerialProtocol::cmdStats(char* args) {
+    // Show receive statistics
+    sendStats();
+}
+
+void SerialProtocol::cmdStatsReset(char* args) {
+    // Start a fresh measurement window
+    resetStats();
+    serialPort.println("OK:Stats reset");
+}
+
+void SerialProtocol::cmdProfile(char* args) {
+    // Stage latency histograms
+    sendProfile();
+}
+
+void SerialProtocol::cmdStreamStats(char* args) {
+    // Show stream mode counters (current or last stream)
+    sendStreamStats();
+}
+
+void SerialProtocol::cmdSnapshot(char* args) {
+    // Redraw the last received full image without resending it: SNAPSHOT[:names]
+    if (!DisplaySnapshot::hasSnapshot()) {
+        serialPort.println("ERROR:No snapshot stored");
+        return;
+    }
+    
+    uint8_t mask = *args ? displayManager.resolveDisplayMask(args) : selectedMask;
+    if (!mask) {
+        serialPort.println("ERROR:No display selected");
+        return;
+    }
+    
+    for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+        if (mask & (1u << i)) {
+            showSnapshot(displayManager.getDisplay(i));
+        }
+    }
+    serialPort.println("OK:Snapshot displayed");
+}
+
+void SerialProtocol::cmdSnapshotInfo(char* args) {
+    // Show stored snapshot details
+    const SnapshotHeader* hdr = DisplaySnapshot::getSnapshotHeader();
+    serialPort.println("OK:SNAPSHOT_INFO");
+    serialPort.print("Stored:");
+    serialPort.println(hdr ? "Yes" : "No");
+    if (hdr) {
+        serialPort.print("Size:");
+        serialPort.print(hdr->width);
+        serialPort.print("x");
+        serialPort.println(hdr->height);
+        serialPort.print("Offset:");
+        serialPort.print(hdr->offsetX);
+        serialPort.print(",");
+        serialPort.println(hdr->offsetY);
+        serialPort.print("Centered:");
+        serialPort.println((hdr->flags & SNAPSHOT_CENTERED) ? "Yes" : "No");
+        serialPort.print("Fitted:");
+        serialPort.println((hdr->flags & SNAPSHOT_FITTED) ? "Yes" : "No");
+    }
+    serialPort.println("END_SNAPSHOT_INFO");
+}
+
+void SerialProtocol::cmdSnapshotClear(char* args) {
+    // Free snapshot memory
+    capturePixels = nullptr;
+    DisplaySnapshot::discardSnapshot();
+    serialPort.println("OK:Snapshot cleared");
+}
+
+void SerialProtocol::cmdCacheShow(char* args) {
+    // Draw a cached image: CACHE_SHOW:<id>[:<name>,...|ALL]
+    const char* names = strchr(args, ':');
+    int id = atol(args);
+    uint8_t mask = names ? displayManager.resolveDisplayMask(names + 1) : selectedMask;
+    if (!mask) {
+        serialPort.println("ERROR:No display selected");
+        return;
+    }
+    
+    uint8_t status = BIN_STATUS_CACHE_MISS;
+    if (id >= 0 && id < IMAGE_CACHE_SNAPSHOT_ID) {
+        status = showCachedImage(id, mask, true, fitImages, true, 0, 0);
+    }
+    bitmapWidth = 0;
+    bitmapHeight = 0;
+    targetCount = 0;
+    if (status == BIN_STATUS_CACHE_MISS) {
+        serialPort.print("ERROR:Image not cached: ");
+        serialPort.println(id);
+    } else if (status == BIN_STATUS_UNSUPPORTED) {
+        serialPort.print("ERROR:Not an image: ");
+        serialPort.println(id);
+    } else if (status != BIN_STATUS_OK) {
+        serialPort.println("ERROR:Corrupt cached image");
+    } else {
+        serialPort.println("OK:Cached image displayed");
+    }
+}
+
+void SerialProtocol::cmdText(char* args) {
+    // Overlay text: TEXT:x,y,fg[,bg[,scale[,atlas]]]:<text> (bg -1 = transparent)
+    char* text = strchr(args, ':');
+    if (!text) {
+        serialPort.println("ERROR:Invalid format. Use TEXT:x,y,fg[,bg[,scale[,atlas]]]:text");
+        return;
+    }
+    *text++ = '\0';
+    long fields[6] = { 0, 0, 0, -1, 1, GLYPH_ATLAS_BUILTIN_ID };
+    if (parseNumbers(args, fields, 6) < 3) {
+        serialPort.println("ERROR:Invalid format. Use TEXT:x,y,fg[,bg[,scale[,atlas]]]:text");
+        return;
+    }
+    
+    BinaryTextParams params;
+    params.foreground = fields[2];
+    params.background = fields[3] < 0 ? 0 : fields[3];
+    params.atlas = fields[5];
+    params.flags = fields[3] < 0 ? 0 : TEXT_FLAG_OPAQUE;
+    params.scale = constrain(fields[4], 0, 255);
+    params.reserved = 0;
+    uint8_t status = drawText(selectedMask, fields[0], fields[1], params, text, strlen(text));
+    if (status == BIN_STATUS_NO_DISPLAY) {
+        serialPort.println("ERROR:No display selected");
+    } else if (status == BIN_STATUS_CACHE_MISS) {
+        serialPort.print("ERROR:Atlas not cached: ");
+        serialPort.println(params.atlas);
+    } else if (status == BIN_STATUS_UNSUPPORTED) {
+        serialPort.println("ERROR:Not a glyph atlas");
+    } else if (status != BIN_STATUS_OK) {
+        serialPort.println("ERROR:Invalid text (1-128 characters, scale 1-8)");
+    } else {
+        serialPort.print("OK:TEXT:");
+        serialPort.print(glyphText.getWidth());
+        serialPort.print(",");
+        serialPort.println(glyphText.getHeight());
+    }
+}
+
+void SerialProtocol::cmdTiles(char* args) {
+    // Composite cached tiles: TILES:id,x,y[;id,x,y...]
+    uint8_t count = 0;
+    char* cursor = args;
+    while (cursor && *cursor && count < BINARY_MAX_TILE_DRAWS) {
+        char* entry = nextField(cursor, ';');
+        const char* first = strchr(entry, ',');
+        const char* second = first ? strchr(first + 1, ',') : nullptr;
+        if (!second) {
+            serialPort.println("ERROR:Invalid format. Use TILES:id,x,y[;id,x,y...]");
+            return;
+        }
+        BinaryTileDraw& draw = tileList[count++];
+        draw.id = atol(entry);
+        draw.x = atol(first + 1);
+        draw.y = atol(second + 1);
+        draw.reserved = 0;
+    }
+    
+    uint32_t value = 0;
+    uint8_t status = count ? drawTiles(selectedMask, 0, 0, count, false, value) : (uint8_t)BIN_STATUS_BAD_HEADER;
+    if (status == BIN_STATUS_NO_DISPLAY) {
+        serialPort.println("ERROR:No display selected");
+    } else if (status == BIN_STATUS_CACHE_MISS) {
+        serialPort.print("ERROR:Tile not cached: ");
+        serialPort.println(value);
+    } else if (status == BIN_STATUS_UNSUPPORTED) {
+        serialPort.print("ERROR:Tile is not raw RGB565: ");
+        serialPort.println(value);
+    } else if (status != BIN_STATUS_OK) {
+        serialPort.println("ERROR:Invalid format. Use TILES:id,x,y[;id,x,y...]");
+    } else {
+        serialPort.print("OK:TILES:");
+        serialPort.print(count);
+        serialPort.print(",");
+        serialPort.println(value);
+    }
+}
+
+void SerialProtocol::cmdCacheList(char* args) {
+    // List cached images (id 255 is the snapshot)
+    serialPort.println("OK:CACHE_LIST");
+    serialPort.print("Entries:");
+    serialPort.println(ImageCache::getCount());
+    serialPort.print("Used:");
+    serialPort.print(ImageCache::getUsedBytes());
+    serialPort.print("/");
+    serialPort.println(ImageCache::ARENA_BYTES);
+    ImageCache::list(serialPort);
+    serialPort.println("END_CACHE_LIST");
+}
+
+void SerialProtocol::cmdCacheDrop(char* args) {
+    // Remove one cached image
+    int id = atol(args);
+    if (id < 0 || id >= IMAGE_CACHE_SNAPSHOT_ID || !ImageCache::remove(id)) {
+        serialPort.print("ERROR:Image not cached: ");
+        serialPort.println(id);
+        return;
+    }
+    serialPort.println("OK:Cached image dropped");
+}
+
+void SerialProtocol::cmdCacheClear(char* args) {
+    // Empty the whole arena, snapshot included
+    capturePixels = nullptr;
+    ImageCache::clear();
+    serialPort.println("OK:Cache cleared");
+}
+
+void SerialProtocol::cmdStoreSave(char* args) {
+    // Write cached images to the store: STORE_SAVE:<name>[,<delay_ms>]:<id>[,<id>...]
+    char* ids = strchr(args, ':');
+    if (!ids) {
+        serialPort.println("ERROR:Invalid format. Use STORE_SAVE:name[,delay_ms]:id[,id...]");
+        return;
+    }
+    *ids++ = '\0';
+    long frameIds[MAX_STORE_FRAMES];
+    int count = parseStoreFrames(ids, frameIds, nullptr);
+    if (count < 0) {
+        return;
+    }
+    char* cursor = args;
+    char* name = nextField(cursor, ',');
+    long delayMs = cursor ? atol(cursor) : 0;
+    
+    StoreStatus status = Playback::saveFrames(name, constrain(delayMs, 0, 65535), frameIds, count);
+    if (status != STORE_OK) {
+        sendStoreError(status);
+        return;
+    }
+    serialPort.print("OK:Stored ");
+    serialPort.print(name);
+    serialPort.print(" (");
+    serialPort.print(count);
+    serialPort.println(count == 1 ? " frame)" : " frames)");
+}
+
+void SerialProtocol::cmdStoreAdd(char* args) {
+    // Append cached frames to the newest entry: STORE_ADD:<name>:<id>[,<id>...]
+    char* ids = strchr(args, ':');
+    if (!ids) {
+        serialPort.println("ERROR:Invalid format. Use STORE_ADD:name:id[,id...]");
+        return;
+    }
+    *ids++ = '\0';
+    StoredImage entry;
+    if (!ImageStore::find(args, entry)) {
+        sendStoreError(ImageStore::isMounted() ? STORE_NOT_FOUND : STORE_NOT_MOUNTED);
+        return;
+    }
+    if (entry.kind == STORE_KIND_PLAYLIST) {
+        serialPort.println("ERROR:Not an image or sequence (use STORE_PLAYLIST)");
+        return;
+    }
+    long frameIds[MAX_STORE_FRAMES];
+    int count = parseStoreFrames(ids, frameIds, &entry);
+    if (count < 0) {
+        return;
+    }
+    
+    StoreStatus status = Playback::appendFrames(args, frameIds, count);
+    if (status != STORE_OK) {
+        sendStoreError(status);
+        return;
+    }
+    serialPort.print("OK:Added ");
+    serialPort.print(count);
+    serialPort.print(count == 1 ? " frame to " : " frames to ");
+    serialPort.println(args);
+}
+
+void SerialProtocol::cmdStorePlaylist(char* args) {
+    // Store entry names to play in turn: STORE_PLAYLIST:<name>[,<hold_ms>]:<entry>,...
+    char* entries = strchr(args, ':');
+    if (!entries || !*++entries) {
+        serialPort.println("ERROR:Invalid format. Use STORE_PLAYLIST:name[,hold_ms]:entry,...");
+        return;
+    }
+    entries[-1] = '\0';
+    char* cursor = args;
+    char* name = nextField(cursor, ',');
+    long holdMs = cursor ? atol(cursor) : 0;
+    
+    const char* items[MAX_PLAYLIST_ITEMS];
+    uint16_t count = 0;
+    for (cursor = entries; cursor; count++) {
+        items[count] = trimLine(nextField(cursor, ','));
+    }
+    StoreStatus status = Playback::savePlaylist(name, constrain(holdMs, 0, 65535), items, count);
+    if (status != STORE_OK) {
+        sendStoreError(status);
+        return;
+    }
+    serialPort.print("OK:Stored playlist ");
+    serialPort.print(name);
+    serialPort.print(" (");
+    serialPort.print(count);
+    serialPort.println(count == 1 ? " entry)" : " entries)");
+}
+
+void SerialProtocol::cmdStoreList(char* args) {
+    // List stored entries
+    if (!ImageStore::isMounted()) {
+        sendStoreError(STORE_NOT_MOUNTED);
+        return;
+    }
+    serialPort.println("OK:STORE_LIST");
+    serialPort.print("Entries:");
+    serialPort.println(ImageStore::getCount());
+    serialPort.print("Used:");
+    serialPort.print(ImageStore::getUsedBytes());
+    serialPort.print("/");
+    serialPort.println(ImageStore::getCapacity());
+    ImageStore::list(serialPort);
+    serialPort.println("END_STORE_LIST");
+}
+
+void SerialProtocol::cmdStoreInfo(char* args) {
+    // Flash identity and use
+    if (!ImageStore::isMounted()) {
+        sendStoreError(STORE_NOT_MOUNTED);
+        return;
+    }
+    serialPort.println("OK:STORE_INFO");
+    serialPort.print("Flash:0x");
+    serialPort.println(ImageStore::getJedecId(), HEX);
+    serialPort.print("Capacity:");
+    serialPort.println(ImageStore::getCapacity());
+    serialPort.print("Used:");
+    serialPort.println(ImageStore::getUsedBytes());
+    serialPort.print("Entries:");
+    serialPort.println(ImageStore::getCount());
+    serialPort.print("FreeSlots:");
+    serialPort.println(ImageStore::getFreeSlots());
+    serialPort.println("END_STORE_INFO");
+}
+
+void SerialProtocol::cmdStoreDelete(char* args) {
+    // Delete one entry (its space returns with STORE_FORMAT, or at once if it was the newest)
+    StoreStatus status = Playback::remove(args);
+    if (status != STORE_OK) {
+        sendStoreError(status);
+        return;
+    }
+    serialPort.println("OK:Stored entry deleted");
+}
+
+void SerialProtocol::cmdStoreFormat(char* args) {
+    // Erase the index; every entry is gone
+    StoreStatus status = Playback::format();
+    if (status != STORE_OK) {
+        sendStoreError(status);
+        return;
+    }
+    serialPort.println("OK:Store formatted");
+}
+
+void SerialProtocol::cmdPlay(char* args) {
+    // Play a stored entry: PLAY:<name>[,<loops>][:<name>,...|ALL]
+    char* names = strchr(args, ':');
+    if (names) {
+        *names++ = '\0';
+    }
+    char* cursor = args;
+    char* name = nextField(cursor, ',');
+    long loops = cursor ? atol(cursor) : 1;
+    uint8_t mask = names ? displayManager.resolveDisplayMask(names) : selectedMask;
+    if (!mask) {
+        serialPort.println("ERROR:No display selected");
+        return;
+    }
+    
+    StoredImage entry;
+    if (!ImageStore::find(name, entry)) {
+        sendStoreError(ImageStore::isMounted() ? STORE_NOT_FOUND : STORE_NOT_MOUNTED);
+        return;
+    }
+    if (!play(name, mask, constrain(loops, 0, 65535))) {
+        serialPort.print("ERROR:Nothing to play in ");
+        serialPort.println(name);
+        return;
+    }
+    serialPort.print("OK:Playing ");
+    serialPort.println(name);
+}
+
+void SerialProtocol::cmdStop(char* args) {
+    bool wasPlaying = Playback::isActive();
+    stopPlayback();
+    serialPort.println(wasPlaying ? "OK:Playback stopped" : "OK:Not playing");
+}
+
+void SerialProtocol::cmdHelp(char* args) {
+    // Show command help
+    serialPort.println("OK:HELP");
+    serialPort.println("Available CMD: commands:");
+    serialPort.println("  CMD:LIST - List all displays");
+    serialPort.println("  CMD:INFO - Show active display info");
+    serialPort.println("  CMD:TEST - Test active display");
+    serialPort.println("  CMD:TEST_ALL - Test all displays");
+    serialPort.println("  CMD:FRAME_ON - Enable frame");
+    serialPort.println("  CMD:FRAME_OFF - Disable frame");
+    serialPort.println("  CMD:FIT_ON / CMD:FIT_OFF - Turn and scale centred images to each display");
+    serialPort.println("  CMD:FRAME_COLOR:value - Set frame color (0-65535)");
+    serialPort.println("  CMD:FRAME_THICKNESS:value - Set thickness (1-10)");
+    serialPort.println("  CMD:ADJUST_TOP:value - Adjust top edge (relative to config)");
+    serialPort.println("  CMD:ADJUST_BOTTOM:value - Adjust bottom edge");
+    serialPort.println("  CMD:ADJUST_LEFT:value - Adjust left edge");
+    serialPort.println("  CMD:ADJUST_RIGHT:value - Adjust right edge");
+    serialPort.println("  CMD:CALIBRATE - Show calibration pattern");
+    serialPort.println("  CMD:UPDATE_CONFIG:left,right,top,bottom,centerX,centerY - Update base config");
+    serialPort.println("  CMD:ORIENTATION:value - Set rotation (0=Portrait, 1=Landscape, 2=Rev Portrait, 3=Rev Landscape)");
+    serialPort.println("  CMD:SCROLL_AREA[:start,length] - Hardware scroll area (default: usable area)");
+    serialPort.println("  CMD:SCROLL:lines - Scroll and report where to draw the new lines");
+    serialPort.println("  CMD:SCROLL_OFF - Stop hardware scrolling");
+    serialPort.println("  CMD:PALETTE:c0,c1,... - Load session palette for indexed images");
+    serialPort.println("  CMD:STATS - Show receive statistics (and stage timings)");
+    serialPort.println("  CMD:STATS_RESET - Clear receive statistics and stage timings");
+    serialPort.println("  CMD:PROFILE - Show stage latency histograms (-DST7735_TELEMETRY builds)");
+    serialPort.println("  CMD:BENCH[:kernel[,frames[,w,h]]] - Time FILL/BLIT/RLE/QOI/IDX4/RGB888/FS (default ALL) per frame");
+    serialPort.println("  CMD:STREAM_STATS - Show stream frames, drops and achieved FPS");
+    serialPort.println("  CMD:TEXT:x,y,fg[,bg[,scale[,atlas]]]:text - Draw text (bg -1 = transparent)");
+    serialPort.println("  CMD:TILES:id,x,y[;id,x,y...] - Draw cached RGB565 tiles");
+    serialPort.println("  CMD:SNAPSHOT[:name,...|ALL] - Redraw last image (selected displays by default)");
+    serialPort.println("  CMD:SNAPSHOT_INFO - Show stored snapshot");
+    serialPort.println("  CMD:SNAPSHOT_CLEAR - Free stored snapshot");
+    serialPort.println("  CMD:CACHE_SHOW:id[:name,...|ALL] - Draw a cached image");
+    serialPort.println("  CMD:CACHE_LIST - List cached images");
+    serialPort.println("  CMD:CACHE_DROP:id - Remove a cached image");
+    serialPort.println("  CMD:CACHE_CLEAR - Empty the image cache");
+    serialPort.println("  CMD:STORE_SAVE:name[,delay_ms]:id[,id...] - Write cached images to flash");
+    serialPort.println("  CMD:STORE_ADD:name:id[,id...] - Append cached frames to the newest entry");
+    serialPort.println("  CMD:STORE_PLAYLIST:name[,hold_ms]:entry,... - Store a playlist");
+    serialPort.println("  CMD:STORE_LIST - List stored entries");
+    serialPort.println("  CMD:STORE_INFO - Show flash size and use");
+    serialPort.println("  CMD:STORE_DELETE:name - Delete a stored entry");
+    serialPort.println("  CMD:STORE_FORMAT - Erase the image store");
+    serialPort.println("  CMD:PLAY:name[,loops][:name,...|ALL] - Play a stored entry (loops 0 = forever)");
+    serialPort.println("  CMD:STOP - Stop playback");
+    serialPort.println("  CMD:HELP - Show this help");
+    serialPort.println();
+    serialPort.println("Bitmap protocol commands:");
+    serialPort.println("  DISPLAY:<name> - Select display for bitmap");
+    serialPort.println("  DISPLAY:<name>,<name>|ALL - Broadcast bitmap to several displays");
+    serialPort.println("  BMPStart - Start bitmap transfer");
+    serialPort.println("  SIZE:width,height - Set bitmap dimensions (centred)");
+    serialPort.println("  SIZE:width,height,x,y - Partial update of the window at (x,y)");
+    serialPort.println("  SIZE:...;ENC=RLE|QOI;LEN=bytes - Compressed pixel data");
+    serialPort.println("  SIZE:...;ENC=IDX1|IDX2|IDX4|IDX8[;PAL];LEN=bytes - Palette indices");
+    serialPort.println("  SIZE:...;ENC=RGB888[;DITHER=ORDERED|FS];LEN=bytes - 24-bit pixels, converted here");
+    serialPort.println("  SIZE:...;CACHE=id - Also store the image in the cache (id 0-254)");
+    serialPort.println("  SIZE:...;CREDIT - Binary credit messages instead of progress lines");
+    serialPort.println("  <pixel data> - Send RGB565 pixel data");
+    serialPort.println("  BMPEnd - End bitmap transfer");
+    serialPort.println();
+    serialPort.println("Binary frames:");
+    serialPort.println("  0xA5 + 24-byte header + payload (see BinaryFrame.h), acked with 0xA6");
+    serialPort.println("END_HELP");
+}
+
+void SerialProtocol::handleStart() {
+    // Ensure we have an active display before accepting bitmap
+    if (!activeDisplay) {
+        sendError("No active display selected");
+        currentState = WAITING_FOR_DISPLAY_SELECT;
+        return;
+    }
+    
+    if (!readCommandLine()) {
+        return;
+    }
+    char* command = trimLine(commandLine);
+    
+    // Handle CMD: commands in any state
+    if (startsWith(command, "CMD:")) {
+        handleMenuCommand(command + 4);
+        return;
+    }
+    
+    if (strcmp(command, "BMPStart") == 0) {
+        stopPlayback();
+        serialPort.println("Start marker received");
+        currentState = WAITING_FOR_SIZE;
+    } else if (*command) {
+        sendError("Expected BMPStart, got: ", command);
+    }
+}
+
+void SerialProtocol::handleSize() {
+    if (!readCommandLine()) {
+        return;
+    }
+    char* sizeCommand = trimLine(commandLine);
+    
+    if (startsWith(sizeCommand, "SIZE:")) {
+        // Optional ";KEY=VALUE" options select the pixel encoding
+        uint32_t payloadLength = 0;
+        int cacheEntry = -1;
+        bool credit = false;
+        pixelEncoding = BIN_ENC_RGB565;
+        char* options = strchr(sizeCommand, ';');
+        if (options) {
+            *options++ = '\0';
+            if (!parseSizeOptions(options, pixelEncoding, payloadLength, cacheEntry, credit)) {
+                return;
+            }
+        }
+        
+        // SIZE:width,height (centred) or SIZE:width,height,x,y (partial update)
+        long values[4] = { 0, 0, 0, 0 };
+        int count = parseNumbers(sizeCommand + 5, values, 4);
+        if (count == 2 || count >= 4) {
+            bitmapWidth = values[0];
+            bitmapHeight = values[1];
+            partialUpdate = count >= 4;
+            int windowX = values[2];
+            int windowY = values[3];
+            
+            // Validate and place on every selected display before accepting data
+            targetCount = 0;
+            for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+                if (!(selectedMask & (1u << i))) {
+                    continue;
+                }
+                DisplayInstance* display = displayManager.getDisplay(i);
+                int originX = windowX, originY = windowY;
+                bool fit = fitImages && !partialUpdate;
+                if (!validateDimensions(display, bitmapWidth, bitmapHeight, !partialUpdate && !fit) ||
+                    (!partialUpdate && !fit && !calculateOffsets(display, bitmapWidth, bitmapHeight, originX, originY))) {
+                    targetCount = 0;
+                    return;
+                }
+                if (fit) {
+                    addCenteredTarget(display, bitmapWidth, bitmapHeight, true);
+                } else {
+                    addTarget(display, originX, originY);
+                }
+            }
+            
+            if (targetCount > 0) {
+                // Clear displays BEFORE sending READY (full images only)
+                if (!partialUpdate) {
+                    serialPort.println("Clearing display...");
+                    for (uint8_t i = 0; i < targetCount; i++) {
+                        targets[i].display->clear();
+                    }
+                }
+                
+                if (pixelEncoding == BIN_ENC_RGB565) {
+                    payloadLength = (uint32_t)bitmapWidth * bitmapHeight * 2;
+                }
+                
+                // Full images are kept for CMD:SNAPSHOT; windows are not. A cached
+                // image is stored instead (both share the cache arena, and a second
+                // fill would discard the first)
+                capturePixels = nullptr;
+                cacheId = cacheEntry;
+                cacheWrite = nullptr;
+                if (cacheId >= 0) {
+                    cacheWrite = ImageCache::begin(cacheId, bitmapWidth, bitmapHeight, pixelEncoding, payloadLength);
+                    if (!cacheWrite) {
+                        serialPort.println("NOTE:Image too large to cache");
+                    }
+                } else if (!partialUpdate) {
+                    beginSnapshotCapture(fitImages);
+                }
+                
+                if (pixelEncoding == BIN_ENC_RGB565) {
+                    serialPort.println("READY");
+                } else {
+                    serialPort.print("READY:");
+                    serialPort.println(PixelDecoder::encodingName(pixelEncoding));
+                }
+                serialPort.print("Receiving bitmap: ");
+                serialPort.print(bitmapWidth);
+                serialPort.print("x");
+                serialPort.print(bitmapHeight);
+                if (partialUpdate) {
+                    serialPort.print(" at (");
+                    serialPort.print(windowX);
+                    serialPort.print(",");
+                    serialPort.print(windowY);
+                    serialPort.print(")");
+                }
+                serialPort.println();
+                
+                currentRow = 0;
+                currentCol = 0;
+                pixelBytesRemaining = payloadLength;
+                if (pixelEncoding != BIN_ENC_RGB565) {
+                    decoder.begin(pixelEncoding, (uint32_t)bitmapWidth * bitmapHeight, bitmapWidth);
+                }
+                pendingPixelByte = -1;
+                pixelError = nullptr;
+                prepareRowClip();
+                beginTransferStats();
+                currentState = RECEIVING_DATA;
+                
+                serialPort.print("Ready to receive ");
+                serialPort.print(bitmapWidth * bitmapHeight);
+                serialPort.println(" pixels");
+                
+                // First window follows the text so the host can start streaming
+                beginCredit(credit, 0, pixelBytesRemaining);
+                updateCredit();
+            }
+        } else {
+            sendError("Invalid size format");
+        }
+    }
+}
+
+void SerialProtocol::handleDataReception() {
+    if (!activeDisplay) {
+        sendError("No active display");
+        return;
+    }
+    
+    // Drain pixel data (RGB565, 2 bytes per pixel) from the ring in blocks
+    uint8_t chunk[RX_CHUNK_BYTES];
+    while (pixelBytesRemaining > 0 && serialPort.available()) {
+        size_t count = serialPort.readBlock(chunk, min((uint32_t)RX_CHUNK_BYTES, pixelBytesRemaining));
+        pixelBytesRemaining -= count;
+        transferBytes += count;
+        if (pixelError) {
+            // Swallow the rest of the LEN= payload so it is not parsed as commands
+            updateCredit();
+            continue;
+        }
+        storeCacheBytes(chunk, count);
+        
+        int rowBefore = currentRow;
+        if (pixelEncoding == BIN_ENC_RGB565) {
+            consumePixelBytes(chunk, count);
+        } else {
+            decoder.decode(chunk, count, *this);
+            if (decoder.hasError()) {
+                pixelError = "Corrupt compressed pixel data";
+                finishBands();
+                updateCredit();
+                continue;
+            }
+        }
+        
+        // Progress indication every PROGRESS_REPORT_INTERVAL rows (credits replace it)
+        updateCredit();
+        if (!creditEnabled &&
+            currentRow / PROGRESS_REPORT_INTERVAL != rowBefore / PROGRESS_REPORT_INTERVAL &&
+            currentRow < bitmapHeight) {
+            float progress = (float)currentRow / bitmapHeight * 100.0f;
+            serialPort.print("Progress: ");
+            serialPort.print(progress, 1);
+            serialPort.print("% (Row ");
+            serialPort.print(currentRow);
+            serialPort.print("/");
+            serialPort.print(bitmapHeight);
+            serialPort.println(")");
+        }
+    }
+    
+    if (pixelBytesRemaining == 0) {
+        if (pixelError) {
+            sendError(pixelError);
+            return;
+        }
+        if (pixelEncoding != BIN_ENC_RGB565 && !decoder.isComplete()) {
+            sendError("Compressed pixel data ended early");
+            return;
+        }
+        endTransferStats();
+        currentState = WAITING_FOR_END;
+    }
+}
+
+bool SerialProtocol::parseSizeOptions(char* options, uint8_t& encoding, uint32_t& length,
+                                      int& cacheEntry, bool& credit) {
+    // ENC=<RGB565|RLE|QOI|IDX1|IDX2|IDX4|IDX8|RGB888>;PAL;DITHER=<ORDERED|FS>;LEN=<payload bytes>;
+    // CACHE=<id>;CREDIT, any order
+    bool inlinePalette = false;
+    uint8_t dither = 0;
+    char* cursor = options;
+    while (cursor && *cursor) {
+        const char* option = trimLine(nextField(cursor, ';'));
+        
+        if (startsWith(option, "ENC=")) {
+            const char* name = option + 4;
+            if (!PixelDecoder::encodingFromName(name, encoding)) {
+                sendError("Unsupported encoding: ", name);
+                return false;
+            }
+        } else if (strcmp(option, "PAL") == 0) {
+            inlinePalette = true;
+        } else if (strcmp(option, "DITHER=ORDERED") == 0) {
+            dither = BIN_ENC_DITHER_ORDERED;
+        } else if (strcmp(option, "DITHER=FS") == 0) {
+            dither = BIN_ENC_DITHER_DIFFUSE;
+        } else if (strcmp(option, "CREDIT") == 0) {
+            credit = true;
+        } else if (startsWith(option, "LEN=")) {
+            length = atol(option + 4);
+        } else if (startsWith(option, "CACHE=")) {
+            cacheEntry = atol(option + 6);
+            if (cacheEntry < 0 || cacheEntry >= IMAGE_CACHE_SNAPSHOT_ID) {
+                sendError("Cache id must be 0-254");
+                return false;
+            }
+        } else if (*option) {
+            sendError("Unknown SIZE option: ", option);
+            return false;
+        }
+    }
+    
+    if (inlinePalette) {
+        if (!PixelDecoder::isIndexed(encoding)) {
+            sendError("PAL needs an indexed encoding (IDX1-IDX8)");
+            return false;
+        }
+        encoding |= BIN_ENC_PALETTE;
+    }
+    if (dither) {
+        if (encoding != BIN_ENC_RGB888) {
+            sendError("DITHER needs ENC=RGB888");
+            return false;
+        }
+        encoding |= dither;
+    }
+    if (encoding != BIN_ENC_RGB565 && (length == 0 || length > BINARY_MAX_PAYLOAD)) {
+        sendError("Compressed encodings need LEN=<bytes>");
+        return false;
+    }
+    return true;
+}
+
+void SerialProtocol::consumePixelBytes(const uint8_t* data, size_t length) {
+    // Wire bytes are big-endian; reassemble them in wire order for the band buffer
+    size_t i = 0;
+    if (pendingPixelByte >= 0 && length > 0) {
+        acceptPixel((data[0] << 8) | pendingPixelByte);
+        pendingPixelByte = -1;
+        i = 1;
+    }
+    for (; i + 1 < length; i += 2) {
+        acceptPixel((data[i + 1] << 8) | data[i]);
+    }
+    if (i < length) {
+        pendingPixelByte = data[i];
+    }
+}
+
+void SerialProtocol::acceptPixel(uint16_t wirePixel) {
+    // Buffer whole rows visible on any target; pushBand crops per display
+    // Frame adjustments define the visible area regardless of frame visibility
+    bool rowVisible = currentRow >= visibleRowStart && currentRow < visibleRowEnd;
+    if (rowVisible) {
+        lineBuffer[bandRowCount * bitmapWidth + currentCol] = wirePixel;
+    }
+    if (capturePixels) {
+        capturePixels[currentRow * bitmapWidth + currentCol] = wirePixel;
+    }
+    
+    // Advance to next pixel
+    currentCol++;
+    if (currentCol >= bitmapWidth) {
+        currentCol = 0;
+        
+        if (rowVisible) {
+            if (bandRowCount == 0) {
+                bandStartRow = currentRow;
+            }
+            bandRowCount++;
+            if (bandRowCount >= bandCapacity) {
+                flushBand();
+            }
+        }
+        
+        currentRow++;
+        if (currentRow >= bitmapHeight) {
+            finishBands();
+        }
+    }
+}
+
+void SerialProtocol::addTarget(DisplayInstance* display, int originX, int originY) {
+    DisplayTarget& target = targets[targetCount++];
+    target = DisplayTarget();
+    target.display = display;
+    target.originX = originX;
+    target.originY = originY;
+}
+
+void SerialProtocol::addCenteredTarget(DisplayInstance* display, int width, int height, bool fit) {
+    DisplayTarget& target = targets[targetCount++];
+    target = DisplayTarget();
+    target.display = display;
+    display->centerTarget(target, width, height, fit);
+}
+
+void SerialProtocol::acceptRun(uint16_t wirePixel, uint32_t count) {
+    while (count > 0 && currentRow < bitmapHeight) {
+        // Whole rows of one colour go straight to fillRect instead of the band
+        if (currentCol == 0 && count >= (uint32_t)bitmapWidth) {
+            int rows = min(count / bitmapWidth, (uint32_t)(bitmapHeight - currentRow));
+            if (capturePixels) {
+                uint16_t* dest = capturePixels + currentRow * bitmapWidth;
+                for (uint32_t i = 0; i < (uint32_t)rows * bitmapWidth; i++) {
+                    dest[i] = wirePixel;
+                }
+            }
+            flushBand();
+            displayManager.fillRows(targets, targetCount, (wirePixel >> 8) | (wirePixel << 8),
+                                    currentRow, rows);
+            currentRow += rows;
+            count -= (uint32_t)rows * bitmapWidth;
+            if (currentRow >= bitmapHeight) {
+                finishBands();
+            }
+            continue;
+        }
+        acceptPixel(wirePixel);
+        count--;
+    }
+}
+
+void SerialProtocol::prepareRowClip() {
+    // Clip every target once per transfer; rows outside all of them are skipped
+    visibleRowStart = bitmapHeight;
+    visibleRowEnd = 0;
+    for (uint8_t i = 0; i < targetCount; i++) {
+        DisplayTarget& target = targets[i];
+        target.display->clipTarget(target, bitmapWidth, bitmapHeight,
+                                   usableAreaAdjustTop, usableAreaAdjustBottom,
+                                   usableAreaAdjustLeft, usableAreaAdjustRight);
+        if (target.colStart < target.colEnd && target.rowStart < target.rowEnd) {
+            visibleRowStart = min(visibleRowStart, (int)target.rowStart);
+            visibleRowEnd = max(visibleRowEnd, (int)target.rowEnd);
+        }
+    }
+    if (visibleRowEnd < visibleRowStart) {
+        visibleRowEnd = visibleRowStart;
+    }
+    
+    bandCapacity = bitmapWidth > 0 ? LINE_BUFFER_PIXELS / bitmapWidth : 0;
+    bandStartRow = 0;
+    bandRowCount = 0;
+    vsyncDisplay = nullptr;
+}
+
+void SerialProtocol::flushBand() {
+    if (bandRowCount == 0) {
+        return;
+    }
+    
+    // First band of a synced frame: start writing as the panel enters vertical blanking
+    if (vsyncDisplay) {
+        DisplayInstance::finishPendingPush();   // Previous frame's last band
+        vsyncDisplay->waitForVsync();
+        vsyncDisplay = nullptr;
+    }
+    
+    // Start clocking this band out to every target, then fill the other buffer meanwhile
+    displayManager.pushBand(targets, targetCount, lineBuffer, bitmapWidth, bandStartRow, bandRowCount);
+    lineBuffer = (lineBuffer == lineBuffers[0]) ? lineBuffers[1] : lineBuffers[0];
+    bandRowCount = 0;
+}
+
+void SerialProtocol::finishBands() {
+    flushBand();
+    DisplayInstance::finishPendingPush();
+}
+
+void SerialProtocol::handleEnd() {
+    if (!readCommandLine()) {
+        return;
+    }
+    const char* endCommand = trimLine(commandLine);
+    
+    if (strcmp(endCommand, "BMPEnd") == 0) {
+        if (capturePixels) {
+            DisplaySnapshot::commitCapture();
+            capturePixels = nullptr;
+        }
+        if (cacheWrite) {
+            ImageCache::commit(cacheId);
+            cacheWrite = nullptr;
+        }
+        
+        // Draw frame if enabled (partial updates may have overdrawn its edge)
+        if (imageFrameEnabled) {
+            for (uint8_t i = 0; i < targetCount; i++) {
+                targets[i].display->drawImageFrame(imageFrameColor, imageFrameThickness);
+            }
+        }
+        
+        currentState = BITMAP_COMPLETE;
+        serialPort.println("COMPLETE");
+        serialPort.println("Bitmap display completed successfully!");
+    }
+}
+
+void SerialProtocol::handleComplete() {
+    // Ready for next bitmap - stay in display selected mode
+    currentState = WAITING_FOR_START;
+    bitmapWidth = 0;
+    bitmapHeight = 0;
+    currentRow = 0;
+    currentCol = 0;
+    partialUpdate = false;
+    targetCount = 0;
+    capturePixels = nullptr;
+    serialPort.println("Ready for next bitmap");
+}
+
+bool SerialProtocol::readCommandLine() {
+    // Assemble a line from whatever is buffered; never waits for more bytes.
+    // Stops right after '\n' so bytes that follow (pixel data) stay in the ring
+    while (serialPort.available()) {
+        char c = serialPort.read();
+        if (c == '\n') {
+            bool overflow = commandLength >= COMMAND_LINE_MAX;
+            commandLine[min(commandLength, (size_t)COMMAND_LINE_MAX)] = '\0';
+            commandLength = 0;
+            if (overflow) {
+                serialPort.println("ERROR:Command line too long");
+                continue;
+            }
+            return true;
+        }
+        if (commandLength < COMMAND_LINE_MAX) {
+            commandLine[commandLength] = c;
+        }
+        commandLength++;
+    }
+    return false;
+}
+
+bool SerialProtocol::isBinaryFrameStart() {
+    // Only at a line boundary: 0xA5 inside a partial text line is text
+    if (commandLength != 0) {
+        return false;
+    }
+    if (currentState != WAITING_FOR_DISPLAY_SELECT &&
+        currentState != WAITING_FOR_START &&
+        currentState != BITMAP_COMPLETE) {
+        return false;
+    }
+    return serialPort.available() && serialPort.peek() == BINARY_SYNC_BYTE;
+}
+
+void SerialProtocol::handleBinaryHeader() {
+    uint8_t* raw = reinterpret_cast<uint8_t*>(&binaryHeader);
+    while (binaryHeaderBytes < BINARY_HEADER_SIZE && serialPort.available()) {
+        raw[binaryHeaderBytes++] = serialPort.read();
+    }
+    if (binaryHeaderBytes < BINARY_HEADER_SIZE) {
         return;
     }
     
-    lastActivity = millis();
+    binaryCrc = crc32Update(0, raw, BINARY_HEADER_CRC_SPAN);
+    pendingPixelByte = -1;
+    beginTransferStats();
     
-    switch (currentState) {
-        case WAITING_FOR_DISPLAY_SELECT:
-            handleDisplaySelect();
-            break;
+    // Garbage header: resynchronise on the next sync byte
+    if (binaryHeader.payloadLength > BINARY_MAX_PAYLOAD) {
+        sendBinaryAck(binaryHeader.opcode, binaryHeader.sequence, BIN_STATUS_BAD_HEADER, 0);
+        currentState = binaryReturnState;
+        return;
+    }
+    
+    binaryStatus = beginBinaryFrame();
+    binaryDiscard = (binaryStatus != BIN_STATUS_OK);
+    binaryPayloadRemaining = binaryHeader.payloadLength;
+    currentState = RECEIVING_BINARY_PAYLOAD;
+    
+    // Rejected payloads are still drained, so they are still credited
+    beginCredit(binaryHeader.flags & BIN_FLAG_CREDIT, binaryHeader.sequence, binaryPayloadRemaining);
+    updateCredit();
+    
+    if (binaryPayloadRemaining == 0) {
+        finishBinaryFrame();
+    }
+}
+
+uint8_t SerialProtocol::beginBinaryFrame() {
+    if (binaryHeader.reserved != 0) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    
+    switch (binaryHeader.opcode) {
+        case BIN_OP_PING:
+            return binaryHeader.payloadLength == 0 ? BIN_STATUS_OK : BIN_STATUS_BAD_HEADER;
             
-        case WAITING_FOR_START:
-            handleStart();
-            break;
+        case BIN_OP_CACHE_STORE:
+            return beginCacheStore();
             
-        case WAITING_FOR_SIZE:
-            handleSize();
-            break;
+        case BIN_OP_PALETTE:
+            // [count][entries]: decoded like an inline palette with no pixels
+            if (binaryHeader.payloadLength < 3 || binaryHeader.payloadLength > 1 + 256 * 2) {
+                return BIN_STATUS_BAD_HEADER;
+            }
+            pixelEncoding = BIN_ENC_INDEXED8 | BIN_ENC_PALETTE;
+            decoder.begin(pixelEncoding, 0);
+            return BIN_STATUS_OK;
             
-        case RECEIVING_DATA:
-            handleDataReception();
-            break;
+        case BIN_OP_CACHE_SHOW:
+            // Drawn in finishBinaryFrame() once the id byte has been checked
+            if (binaryHeader.payloadLength != 1) {
+                return BIN_STATUS_BAD_HEADER;
+            }
+            cacheId = -1;
+            return resolveBinaryDisplays();
             
-        case WAITING_FOR_END:
-            handleEnd();
-            break;
+        case BIN_OP_STREAM_BEGIN:
+            return beginStreamOpen();
             
-        case BITMAP_COMPLETE:
-            handleComplete();
-            break;
-    }
-}
-
-void SerialProtocol::handleDisplaySelect() {
-    unsigned long startTime = millis();
-    String displayName = "";
-    
-    // Give a short time for a command to arrive
-    while (serialPort.available() || (millis() - startTime < DISPLAY_SELECT_TIMEOUT)) {
-        if (serialPort.available()) {
-            String command = serialPort.readStringUntil('\n');
-            command.trim();
+        case BIN_OP_STREAM_FRAME:
+            return beginStreamFrame();
             
-            // Handle CMD: commands
-            if (command.startsWith("CMD:")) {
-                handleMenuCommand(command.substring(4));
-                return;
+        case BIN_OP_STREAM_END:
+            if (binaryHeader.payloadLength != 0) {
+                return BIN_STATUS_BAD_HEADER;
             }
+            return streamActive ? BIN_STATUS_OK : BIN_STATUS_NO_STREAM;
             
-            // Handle RESET command
-            if (command == "RESET") {
-                reset();
-                serialPort.println("Protocol reset");
-                return;
+        case BIN_OP_TEXT:
+            // Drawn in finishBinaryFrame() once the parameters and text have arrived intact
+            if (binaryHeader.payloadLength <= sizeof(BinaryTextParams) ||
+                binaryHeader.payloadLength > sizeof(textPayload)) {
+                return BIN_STATUS_BAD_HEADER;
             }
+            return resolveBinaryDisplays();
             
-            // Handle FRAME commands
-            if (command.startsWith("FRAME:")) {
-                String frameCmd = command.substring(6);
-                
-                if (frameCmd == "ON") {
-                    imageFrameEnabled = true;
-                    serialPort.println("Frame enabled");
-                } else if (frameCmd == "OFF") {
-                    imageFrameEnabled = false;
-                    serialPort.println("Frame disabled");
-                } else if (frameCmd.startsWith("COLOR:")) {
-                    // Parse color value (e.g., "COLOR:31" for blue)
-                    String colorStr = frameCmd.substring(6);
-                    imageFrameColor = colorStr.toInt();
-                    serialPort.print("Frame color set to: ");
-                    serialPort.println(imageFrameColor);
-                } else if (frameCmd.startsWith("THICKNESS:")) {
-                    // Parse thickness value (e.g., "THICKNESS:2")
-                    String thickStr = frameCmd.substring(10);
-                    imageFrameThickness = thickStr.toInt();
-                    serialPort.print("Frame thickness set to: ");
-                    serialPort.println(imageFrameThickness);
-                }
-                return;
+        case BIN_OP_TILES:
+            // Drawn in finishBinaryFrame() once the whole list has arrived intact
+            if (binaryHeader.payloadLength == 0 ||
+                binaryHeader.payloadLength % sizeof(BinaryTileDraw) != 0 ||
+                binaryHeader.payloadLength > sizeof(tileList)) {
+                return BIN_STATUS_BAD_HEADER;
             }
+            return resolveBinaryDisplays();
             
-            // Handle DISPLAY: command (bitmap protocol)
-            if (command.startsWith("DISPLAY:")) {
-                displayName = command.substring(8);
-                displayName.trim();
-                
-                // Look up display by name
-                activeDisplay = displayManager.getDisplay(displayName.c_str());
-                
-                if (activeDisplay) {
-                    serialPort.print("DISPLAY_READY:");
-                    serialPort.println(displayName);
-                    currentState = WAITING_FOR_START;
-                    lastActivity = millis();
-                    return;
-                } else {
-                    sendError("Display not found: " + displayName);
-                    return;
-                }
+        case BIN_OP_BATCH:
+            // Operations run in handleBinaryPayload() as they arrive; they may select displays themselves
+            if (binaryHeader.payloadLength < sizeof(BinaryBatchOp)) {
+                return BIN_STATUS_BAD_HEADER;
             }
-        }
-        delay(10);
+            batchOpBytes = 0;
+            batchOperandRemaining = 0;
+            batchOpsDone = 0;
+            return binaryHeader.displayId == BINARY_ACTIVE_DISPLAY ? (uint8_t)BIN_STATUS_OK : resolveBinaryDisplays();
+            
+        case BIN_OP_BLIT:
+            break;
+            
+        default:
+            return BIN_STATUS_UNSUPPORTED;
     }
     
-    // Timeout waiting for display selection
-    if (displayName.length() == 0) {
-        serialPort.println("Ready for next bitmap");
+    uint8_t status = resolveBinaryDisplays();
+    if (status != BIN_STATUS_OK) {
+        return status;
     }
+    return beginBlit(binaryHeader.x, binaryHeader.y, binaryHeader.width, binaryHeader.height,
+                     binaryHeader.encoding, binaryHeader.flags, binaryHeader.payloadLength);
 }
 
-void SerialProtocol::handleMenuCommand(const String& command) {
-    // Handle menu/control commands (CMD: prefix already stripped)
-    String cmd = command;
-    cmd.trim();
+uint8_t SerialProtocol::beginBlit(int x, int y, int width, int height, uint8_t encoding, uint8_t flags,
+                                  uint32_t length) {
+    // BLIT window of length payload bytes on the selected displays (BIN_OP_BLIT, BATCH_OP_BLIT)
+    pixelEncoding = encoding;
+    if (pixelEncoding != BIN_ENC_RGB565 && !PixelDecoder::isSupported(pixelEncoding)) {
+        return BIN_STATUS_UNSUPPORTED;
+    }
     
-    if (cmd == "RESET") {
-        // Reset protocol state
-        reset();
-        serialPort.println("OK:Protocol reset");
-        
-    } else if (cmd == "LIST") {
-        // List all registered displays
-        serialPort.println("OK:DISPLAY_LIST");
-        int count = displayManager.getDisplayCount();
-        serialPort.print("Count:");
-        serialPort.println(count);
-        
-        // Use DisplayManager's listDisplays method
-        displayManager.listDisplays(serialPort);
-        
-        serialPort.println("END_LIST");
-        
-    } else if (cmd == "INFO") {
-        // Show active display info
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+    if (width <= 0 || height <= 0 || width > LINE_BUFFER_PIXELS) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    if (pixelEncoding == BIN_ENC_RGB565 ? length != (uint32_t)width * height * 2 : length == 0) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    
+    bitmapWidth = width;
+    bitmapHeight = height;
+    bool fit = fitImages || (flags & BIN_FLAG_FIT);
+    addBinaryTargets(x, y, width, height, flags, fit);
+    
+    currentRow = 0;
+    currentCol = 0;
+    capturePixels = nullptr;
+    if (flags & (BIN_FLAG_CENTER | BIN_FLAG_FIT)) {
+        beginSnapshotCapture(fit);
+    }
+    if (pixelEncoding != BIN_ENC_RGB565) {
+        decoder.begin(pixelEncoding, (uint32_t)width * height, width);
+    }
+    prepareRowClip();
+    if (flags & BIN_FLAG_VSYNC) {
+        vsyncDisplay = findVsyncDisplay();
+    }
+    return BIN_STATUS_OK;
+}
+
+void SerialProtocol::addBinaryTargets(int x, int y, int width, int height, uint8_t flags, bool fit) {
+    // One target per selected display, at x/y or centred in its usable area
+    targetCount = 0;
+    for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+        if (!(selectedMask & (1u << i))) {
+            continue;
         }
-        
-        const DisplayConfig& cfg = activeDisplay->getConfig();
-        serialPort.println("OK:DISPLAY_INFO");
-        serialPort.print("Name:");
-        serialPort.println(cfg.name);
-        serialPort.print("Resolution:");
-        serialPort.print(cfg.usableWidth);
-        serialPort.print("x");
-        serialPort.println(cfg.usableHeight);
-        serialPort.print("Rotation:");
-        serialPort.println(cfg.rotation);
-        serialPort.print("FrameEnabled:");
-        serialPort.println(imageFrameEnabled ? "Yes" : "No");
-        serialPort.print("FrameColor:");
-        serialPort.println(imageFrameColor);
-        serialPort.print("FrameThickness:");
-        serialPort.println(imageFrameThickness);
-        serialPort.print("UsableAreaAdjustTop:");
-        serialPort.println(usableAreaAdjustTop);
-        serialPort.print("UsableAreaAdjustBottom:");
-        serialPort.println(usableAreaAdjustBottom);
-        serialPort.print("UsableAreaAdjustLeft:");
-        serialPort.println(usableAreaAdjustLeft);
-        serialPort.print("UsableAreaAdjustRight:");
-        serialPort.println(usableAreaAdjustRight);
-        serialPort.print("CenterX:");
-        serialPort.println(cfg.centerX);
-        serialPort.print("CenterY:");
-        serialPort.println(cfg.centerY);
-        serialPort.println("END_INFO");
-        
-    } else if (cmd == "TEST") {
-        // Test active display
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+        DisplayInstance* display = displayManager.getDisplay(i);
+        if (flags & (BIN_FLAG_CENTER | BIN_FLAG_FIT)) {
+            addCenteredTarget(display, width, height, fit);
+        } else {
+            addTarget(display, x, y);
         }
         
-        serialPort.print("OK:Testing display ");
-        serialPort.println(activeDisplay->getName());
-        activeDisplay->showTestPattern();
-        serialPort.println("Test pattern displayed");
-        
-    } else if (cmd == "TEST_ALL") {
-        // Test all displays
-        serialPort.println("OK:Testing all displays");
-        displayManager.showAllTestPatterns();
-        serialPort.println("All test patterns displayed");
-        
-    } else if (cmd == "FRAME_ON") {
-        // Enable frame on active display
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+        if (flags & BIN_FLAG_CLEAR) {
+            display->clear();
         }
-        
-        activeDisplay->enableImageFrame(true, imageFrameColor, imageFrameThickness,
-                                       usableAreaAdjustTop, usableAreaAdjustBottom,
-                                       usableAreaAdjustLeft, usableAreaAdjustRight);
-        imageFrameEnabled = true;
-        serialPort.println("OK:Frame enabled");
-        
-    } else if (cmd == "FRAME_OFF") {
-        // Disable frame on active display
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+    }
+}
+
+uint8_t SerialProtocol::resolveBinaryDisplays() {
+    // Resolve target display(s) (binary frames select them like DISPLAY: does)
+    uint8_t mask = selectedMask;
+    if (binaryHeader.displayId != BINARY_ACTIVE_DISPLAY) {
+        mask = (binaryHeader.flags & BIN_FLAG_DISPLAY_MASK) ? binaryHeader.displayId
+                                                            : (uint8_t)(1u << binaryHeader.displayId);
+    }
+    return selectBinaryDisplays(mask);
+}
+
+uint8_t SerialProtocol::selectBinaryDisplays(uint8_t mask) {
+    if (mask == 0 || (mask & ~displayManager.getAllDisplaysMask())) {
+        return BIN_STATUS_NO_DISPLAY;
+    }
+    for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+        if ((mask & (1u << i)) && !displayManager.getDisplay(i)->getTFT()) {
+            return BIN_STATUS_NO_DISPLAY;
         }
-        
-        activeDisplay->enableImageFrame(false);
-        imageFrameEnabled = false;
-        serialPort.println("OK:Frame disabled");
-        
-    } else if (cmd.startsWith("FRAME_COLOR:")) {
-        // Set frame color
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+    }
+    selectDisplays(mask);
+    binaryReturnState = WAITING_FOR_START;
+    return BIN_STATUS_OK;
+}
+
+uint8_t SerialProtocol::beginCacheStore() {
+    // Stored, not drawn: no display needs to be selected
+    pixelEncoding = binaryHeader.encoding;
+    
+    // Payload is [id][encoded image] (or [id][glyph atlas], checked once complete)
+    uint32_t imageBytes = binaryHeader.payloadLength - 1;
+    if (pixelEncoding == BIN_ENC_GLYPH_ATLAS) {
+        if (binaryHeader.payloadLength < 1 + sizeof(GlyphAtlasHeader)) {
+            return BIN_STATUS_BAD_HEADER;
         }
-        
-        String colorStr = cmd.substring(12);
-        uint16_t color = colorStr.toInt();
-        imageFrameColor = color;
-        imageFrameEnabled = true;
-        serialPort.print("OK:Frame color set to ");
-        serialPort.println(color);
-        
-        // Immediately update display with new color
-        activeDisplay->drawCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
-                                           usableAreaAdjustLeft, usableAreaAdjustRight,
-                                           color, imageFrameThickness);
-        
-    } else if (cmd.startsWith("FRAME_THICKNESS:")) {
-        // Set frame thickness
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+        cacheId = -1;
+        cacheWrite = nullptr;
+        return imageBytes > ImageCache::ARENA_BYTES ? BIN_STATUS_CACHE_FULL : BIN_STATUS_OK;
+    }
+    if (pixelEncoding != BIN_ENC_RGB565 && !PixelDecoder::isSupported(pixelEncoding)) {
+        return BIN_STATUS_UNSUPPORTED;
+    }
+    
+    int width = binaryHeader.width;
+    int height = binaryHeader.height;
+    if (width <= 0 || height <= 0 || width > LINE_BUFFER_PIXELS || binaryHeader.payloadLength < 2) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    if (pixelEncoding == BIN_ENC_RGB565 && imageBytes != (uint32_t)width * height * 2) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    if (imageBytes > ImageCache::ARENA_BYTES) {
+        return BIN_STATUS_CACHE_FULL;
+    }
+    
+    cacheId = -1;
+    cacheWrite = nullptr;
+    return BIN_STATUS_OK;
+}
+
+void SerialProtocol::handleBinaryPayload() {
+    uint8_t chunk[RX_CHUNK_BYTES];
+    
+    while (binaryPayloadRemaining > 0 && serialPort.available()) {
+        size_t count = serialPort.readBlock(chunk, min((uint32_t)RX_CHUNK_BYTES, binaryPayloadRemaining));
+        binaryCrc = crc32Update(binaryCrc, chunk, count);
+        binaryPayloadRemaining -= count;
+        transferBytes += count;
+        updateCredit();
+        
+        if (binaryDiscard) {
+            continue;
         }
-        
-        String thickStr = cmd.substring(16);
-        int thickness = thickStr.toInt();
-        
-        if (thickness < 1 || thickness > 10) {
-            serialPort.println("ERROR:Thickness must be between 1 and 10");
-            return;
+        if (binaryHeader.opcode == BIN_OP_CACHE_SHOW) {
+            cacheId = chunk[0];
+            continue;
         }
-        
-        imageFrameThickness = thickness;
-        imageFrameEnabled = true;
-        serialPort.print("OK:Frame thickness set to ");
-        serialPort.println(thickness);
-        
-        // Immediately update display with new thickness
-        activeDisplay->drawCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
-                                           usableAreaAdjustLeft, usableAreaAdjustRight,
-                                           imageFrameColor, thickness);
-        
-    } else if (cmd.startsWith("ADJUST_TOP:")) {
-        // Adjust usable area top edge
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+        if (binaryHeader.opcode == BIN_OP_STREAM_BEGIN) {
+            // Parameters may arrive split across reads
+            uint32_t offset = binaryHeader.payloadLength - binaryPayloadRemaining - count;
+            memcpy(reinterpret_cast<uint8_t*>(&pendingStreamParams) + offset, chunk, count);
+            continue;
         }
-        
-        String adjustStr = cmd.substring(11);
-        int8_t adjust = adjustStr.toInt();
-        
-        const DisplayConfig& cfg = activeDisplay->getConfig();
-        // Top is inverted: positive adjustment moves edge UP (decreases Y)
-        int newTop = cfg.usableY - adjust;
-        
-        // Inner bound: center - 10 pixels
-        // Outer bound: -10 pixels (10 pixels beyond published top edge)
-        int innerBound = cfg.centerY - 10;
-        int outerBound = -10;
-        
-        if (newTop < outerBound) {
-            serialPort.print("ERROR:Top edge would be beyond limit (maximum adjustment: ");
-            serialPort.print(cfg.usableY - outerBound);
-            serialPort.println(")");
-            return;
+        if (binaryHeader.opcode == BIN_OP_BATCH) {
+            consumeBatchBytes(chunk, count);
+            continue;
         }
-        
-        if (newTop > innerBound) {
-            serialPort.print("ERROR:Top edge would be past center-10 (minimum adjustment: ");
-            serialPort.print(cfg.usableY - innerBound);
-            serialPort.println(")");
-            return;
+        if (binaryHeader.opcode == BIN_OP_TEXT || binaryHeader.opcode == BIN_OP_TILES) {
+            uint8_t* dest = binaryHeader.opcode == BIN_OP_TEXT ? textPayload : reinterpret_cast<uint8_t*>(tileList);
+            uint32_t offset = binaryHeader.payloadLength - binaryPayloadRemaining - count;
+            memcpy(dest + offset, chunk, count);
+            continue;
         }
-        
-        usableAreaAdjustTop = adjust;
-        serialPort.print("OK:Top edge adjusted to ");
-        serialPort.println(adjust);
-        
-        // Notify if at outer limit
-        if (newTop <= -10) {
-            serialPort.println("NOTICE:Top edge at maximum outward position (-10 pixels beyond display)");
+        if (binaryHeader.opcode == BIN_OP_CACHE_STORE) {
+            size_t skip = 0;
+            if (cacheId < 0) {
+                // First payload byte is the cache id
+                cacheId = chunk[0];
+                skip = 1;
+                if (cacheId != IMAGE_CACHE_SNAPSHOT_ID) {
+                    cacheWrite = ImageCache::begin(cacheId, binaryHeader.width, binaryHeader.height,
+                                                   pixelEncoding, binaryHeader.payloadLength - 1);
+                }
+                if (!cacheWrite) {
+                    binaryStatus = cacheId == IMAGE_CACHE_SNAPSHOT_ID ? BIN_STATUS_BAD_HEADER
+                                                                      : BIN_STATUS_CACHE_FULL;
+                    binaryDiscard = true;
+                    continue;
+                }
+            }
+            storeCacheBytes(chunk + skip, count - skip);
+            continue;
         }
-        
-        // Immediately update display
-        activeDisplay->drawCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
-                                           usableAreaAdjustLeft, usableAreaAdjustRight,
-                                           imageFrameColor, imageFrameThickness);
-        
-    } else if (cmd.startsWith("ADJUST_BOTTOM:")) {
-        // Adjust usable area bottom edge
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+        if (pixelEncoding == BIN_ENC_RGB565) {
+            consumePixelBytes(chunk, count);
+        } else {
+            decoder.decode(chunk, count, *this);
+            if (decoder.hasError()) {
+                // Keep checking the CRC, but stop drawing
+                binaryStatus = BIN_STATUS_DECODE_ERROR;
+                binaryDiscard = true;
+                finishBands();
+            }
         }
-        
-        String adjustStr = cmd.substring(14);
-        int8_t adjust = adjustStr.toInt();
-        
-        const DisplayConfig& cfg = activeDisplay->getConfig();
-        int configBottom = cfg.usableY + cfg.usableHeight - 1;
-        int newBottom = configBottom + adjust;
-        
-        // Inner bound: center + 10 pixels
-        // Outer bound: height + 10 - 1 (10 pixels beyond published bottom edge)
-        int innerBound = cfg.centerY + 10;
-        int outerBound = cfg.height + 10 - 1;
-        
-        if (newBottom > outerBound) {
-            serialPort.print("ERROR:Bottom edge would be beyond limit (maximum: ");
-            serialPort.print(outerBound - configBottom);
-            serialPort.println(")");
-            return;
+    }
+    
+    if (binaryPayloadRemaining == 0) {
+        finishBinaryFrame();
+    }
+}
+
+void SerialProtocol::finishBinaryFrame() {
+    endTransferStats();
+    
+    uint8_t status = binaryStatus;
+    if (status == BIN_STATUS_OK &&
+        (binaryHeader.opcode == BIN_OP_BLIT || binaryHeader.opcode == BIN_OP_PALETTE ||
+         binaryHeader.opcode == BIN_OP_STREAM_FRAME) &&
+        pixelEncoding != BIN_ENC_RGB565 && !decoder.isComplete()) {
+        // Compressed stream ended short of width x height pixels (or of the palette)
+        status = BIN_STATUS_DECODE_ERROR;
+        binaryDiscard = true;
+        finishBands();
+    }
+    if (binaryHeader.opcode == BIN_OP_BATCH && status == BIN_STATUS_OK && batchOpBytes != 0) {
+        // Payload ended inside an operation
+        status = BIN_STATUS_BAD_HEADER;
+        finishBands();
+    }
+    if ((status == BIN_STATUS_OK || status == BIN_STATUS_DECODE_ERROR || status == BIN_STATUS_DROPPED) &&
+        binaryCrc != binaryHeader.crc32) {
+        status = BIN_STATUS_CRC_ERROR;
+    }
+    
+    if (capturePixels) {
+        // Only a good frame replaces the snapshot
+        if (status == BIN_STATUS_OK) {
+            DisplaySnapshot::commitCapture();
+        } else {
+            DisplaySnapshot::abortCapture();
         }
-        
-        if (newBottom < innerBound) {
-            serialPort.print("ERROR:Bottom edge would be past center+10 (minimum: ");
-            serialPort.print(innerBound - configBottom);
-            serialPort.println(")");
-            return;
+    }
+    capturePixels = nullptr;
+    if (cacheWrite && status == BIN_STATUS_OK && pixelEncoding == BIN_ENC_GLYPH_ATLAS &&
+        !GlyphAtlas::isValid(cacheWrite - (binaryHeader.payloadLength - 1), binaryHeader.payloadLength - 1)) {
+        // Never commit an atlas CMD:TEXT could read out of bounds (begin() drops the fill)
+        status = BIN_STATUS_DECODE_ERROR;
+    }
+    if (cacheWrite && status == BIN_STATUS_OK) {
+        ImageCache::commit(cacheId);
+    }
+    cacheWrite = nullptr;
+    
+    uint32_t value = 0;
+    if (binaryHeader.opcode == BIN_OP_CACHE_SHOW && status == BIN_STATUS_OK) {
+        status = showCachedImage(cacheId, selectedMask, binaryHeader.flags & (BIN_FLAG_CENTER | BIN_FLAG_FIT),
+                                 fitImages || (binaryHeader.flags & BIN_FLAG_FIT),
+                                 binaryHeader.flags & BIN_FLAG_CLEAR, binaryHeader.x, binaryHeader.y);
+        if (status == BIN_STATUS_OK) {
+            value = (uint32_t)bitmapWidth * bitmapHeight;
         }
-        
-        usableAreaAdjustBottom = adjust;
-        serialPort.print("OK:Bottom edge adjusted to ");
-        serialPort.println(adjust);
-        
-        // Notify if at outer limit
-        if (newBottom >= cfg.height + 10 - 1) {
-            serialPort.print("NOTICE:Bottom edge at maximum outward position (");
-            serialPort.print(cfg.height + 10 - 1);
-            serialPort.println(" pixels, 10 beyond display)");
+    }
+    if (binaryHeader.opcode == BIN_OP_STREAM_BEGIN && status == BIN_STATUS_OK) {
+        status = openStream();
+    }
+    if (binaryHeader.opcode == BIN_OP_TEXT && status == BIN_STATUS_OK) {
+        BinaryTextParams params;
+        memcpy(&params, textPayload, sizeof(params));
+        status = params.reserved != 0 ? (uint8_t)BIN_STATUS_BAD_HEADER
+               : drawText(selectedMask, binaryHeader.x, binaryHeader.y, params,
+                          reinterpret_cast<const char*>(textPayload) + sizeof(params),
+                          binaryHeader.payloadLength - sizeof(params));
+        if (status == BIN_STATUS_OK) {
+            value = ((uint32_t)glyphText.getWidth() << 16) | (uint16_t)glyphText.getHeight();
         }
-        
-        // Immediately update display
-        activeDisplay->drawCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
-                                           usableAreaAdjustLeft, usableAreaAdjustRight,
-                                           imageFrameColor, imageFrameThickness);
-        
-    } else if (cmd.startsWith("ADJUST_LEFT:")) {
-        // Adjust usable area left edge
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+    }
+    if (binaryHeader.opcode == BIN_OP_TILES && status == BIN_STATUS_OK) {
+        status = drawTiles(selectedMask, binaryHeader.x, binaryHeader.y,
+                           binaryHeader.payloadLength / sizeof(BinaryTileDraw),
+                           binaryHeader.flags & BIN_FLAG_CLEAR, value);
+    }
+    if (binaryHeader.opcode == BIN_OP_STREAM_FRAME) {
+        if (status == BIN_STATUS_OK) {
+            streamFramesShown++;
+            streamLastFrameMillis = millis();
+            value = streamWaitMicros();
+        } else if (status == BIN_STATUS_DROPPED) {
+            streamFramesDropped++;
         }
+    }
+    if (binaryHeader.opcode == BIN_OP_BATCH) {
+        value = batchOpsDone;
+    }
+    if (binaryHeader.opcode == BIN_OP_STREAM_END && status == BIN_STATUS_OK) {
+        streamActive = false;
+        value = streamFramesShown;
+    }
+    if (binaryHeader.opcode == BIN_OP_BLIT && !binaryDiscard) {
+        value = (uint32_t)bitmapWidth * bitmapHeight;
         
-        String adjustStr = cmd.substring(12);
-        int8_t adjust = adjustStr.toInt();
-        
-        const DisplayConfig& cfg = activeDisplay->getConfig();
-        // Left is inverted: positive adjustment moves edge LEFT (decreases X)
-        int newLeft = cfg.usableX - adjust;
-        
-        // Inner bound: center - 10 pixels
-        // Outer bound: -10 pixels (10 pixels beyond published left edge)
-        int innerBound = cfg.centerX - 10;
-        int outerBound = -10;
-        
-        if (newLeft < outerBound) {
-            serialPort.print("ERROR:Left edge would be beyond limit (maximum adjustment: ");
-            serialPort.print(cfg.usableX - outerBound);
-            serialPort.println(")");
-            return;
+        // Same frame treatment as BMPEnd (windows may have overdrawn its edge)
+        if (imageFrameEnabled) {
+            for (uint8_t i = 0; i < targetCount; i++) {
+                targets[i].display->drawImageFrame(imageFrameColor, imageFrameThickness);
+            }
         }
-        
-        if (newLeft > innerBound) {
-            serialPort.print("ERROR:Left edge would be past center-10 (minimum adjustment: ");
-            serialPort.print(cfg.usableX - innerBound);
-            serialPort.println(")");
-            return;
+    }
+    
+    sendBinaryAck(binaryHeader.opcode, binaryHeader.sequence, status, value);
+    
+    bitmapWidth = 0;
+    bitmapHeight = 0;
+    currentRow = 0;
+    currentCol = 0;
+    targetCount = 0;
+    binaryDiscard = false;
+    currentState = binaryReturnState;
+}
+
+void SerialProtocol::sendBinaryAck(uint8_t opcode, uint8_t sequence, uint8_t status, uint32_t value) {
+    BinaryAck ack;
+    ack.sync = BINARY_ACK_SYNC_BYTE;
+    ack.opcode = opcode;
+    ack.sequence = sequence;
+    ack.status = status;
+    ack.value = value;
+    serialPort.write(reinterpret_cast<const uint8_t*>(&ack), sizeof(ack));
+}
+
+void SerialProtocol::consumeBatchBytes(const uint8_t* data, size_t length) {
+    // Operation headers and operands may arrive split across reads
+    while (length > 0) {
+        uint8_t status = BIN_STATUS_OK;
+        if (batchOpBytes < sizeof(BinaryBatchOp)) {
+            size_t count = min(length, sizeof(BinaryBatchOp) - batchOpBytes);
+            memcpy(reinterpret_cast<uint8_t*>(&batchOp) + batchOpBytes, data, count);
+            batchOpBytes += count;
+            data += count;
+            length -= count;
+            if (batchOpBytes < sizeof(BinaryBatchOp)) {
+                return;
+            }
+            status = beginBatchOp();
+        } else {
+            size_t count = min((uint32_t)length, batchOperandRemaining);
+            uint32_t offset = batchOp.length - batchOperandRemaining;
+            if (batchOp.op == BATCH_OP_BLIT) {
+                if (pixelEncoding == BIN_ENC_RGB565) {
+                    consumePixelBytes(data, count);
+                } else {
+                    decoder.decode(data, count, *this);
+                    if (decoder.hasError()) {
+                        status = BIN_STATUS_DECODE_ERROR;
+                    }
+                }
+            } else if (batchOp.op == BATCH_OP_CACHE_SHOW) {
+                cacheId = data[0];
+            } else {
+                uint8_t* dest = batchOp.op == BATCH_OP_TEXT ? textPayload : reinterpret_cast<uint8_t*>(tileList);
+                memcpy(dest + offset, data, count);
+            }
+            batchOperandRemaining -= count;
+            data += count;
+            length -= count;
         }
         
-        usableAreaAdjustLeft = adjust;
-        serialPort.print("OK:Left edge adjusted to ");
-        serialPort.println(adjust);
-        
-        // Notify if at outer limit
-        if (newLeft <= -10) {
-            serialPort.println("NOTICE:Left edge at maximum outward position (-10 pixels beyond display)");
+        if (status == BIN_STATUS_OK && batchOperandRemaining == 0) {
+            status = finishBatchOp();
         }
-        
-        // Immediately update display
-        activeDisplay->drawCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
-                                           usableAreaAdjustLeft, usableAreaAdjustRight,
-                                           imageFrameColor, imageFrameThickness);
-        
-    } else if (cmd.startsWith("ADJUST_RIGHT:")) {
-        // Adjust usable area right edge
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
+        if (status != BIN_STATUS_OK) {
+            // The rest of the batch is drained (CRC still checked) without running
+            binaryStatus = status;
+            binaryDiscard = true;
+            finishBands();
+            targetCount = 0;
             return;
         }
-        
-        String adjustStr = cmd.substring(13);
-        int8_t adjust = adjustStr.toInt();
-        
-        const DisplayConfig& cfg = activeDisplay->getConfig();
-        int configRight = cfg.usableX + cfg.usableWidth - 1;
-        int newRight = configRight + adjust;
-        
-        // Inner bound: center + 10 pixels
-        // Outer bound: width + 10 - 1 (10 pixels beyond published right edge)
-        int innerBound = cfg.centerX + 10;
-        int outerBound = cfg.width + 10 - 1;
-        
-        if (newRight > outerBound) {
-            serialPort.print("ERROR:Right edge would be beyond limit (maximum: ");
-            serialPort.print(outerBound - configRight);
-            serialPort.println(")");
-            return;
+    }
+}
+
+uint8_t SerialProtocol::beginBatchOp() {
+    // Header of the next operation is complete: select, then check its operand
+    batchOperandRemaining = batchOp.length;
+    if (batchOp.displays) {
+        uint8_t status = selectBinaryDisplays(batchOp.displays);
+        if (status != BIN_STATUS_OK) {
+            return status;
+        }
+    }
+    if (batchOp.op != BATCH_OP_SELECT && !selectedMask) {
+        return BIN_STATUS_NO_DISPLAY;
+    }
+    
+    switch (batchOp.op) {
+        case BATCH_OP_SELECT:
+        case BATCH_OP_FILL:
+        case BATCH_OP_CLEAR:
+            return batchOp.length == 0 ? BIN_STATUS_OK : BIN_STATUS_BAD_HEADER;
+            
+        case BATCH_OP_BLIT:
+            return beginBlit(batchOp.x, batchOp.y, batchOp.width, batchOp.height,
+                             batchOp.encoding, batchOp.flags, batchOp.length);
+            
+        case BATCH_OP_CACHE_SHOW:
+            return batchOp.length == 1 ? BIN_STATUS_OK : BIN_STATUS_BAD_HEADER;
+            
+        case BATCH_OP_TEXT:
+            return batchOp.length > sizeof(BinaryTextParams) && batchOp.length <= sizeof(textPayload)
+                   ? BIN_STATUS_OK : BIN_STATUS_BAD_HEADER;
+            
+        case BATCH_OP_TILES:
+            return batchOp.length > 0 && batchOp.length % sizeof(BinaryTileDraw) == 0 &&
+                   batchOp.length <= sizeof(tileList) ? BIN_STATUS_OK : BIN_STATUS_BAD_HEADER;
+            
+        default:
+            return BIN_STATUS_UNSUPPORTED;
+    }
+}
+
+uint8_t SerialProtocol::finishBatchOp() {
+    // Operand complete: draw like the matching standalone frame
+    uint8_t status = BIN_STATUS_OK;
+    uint32_t value = 0;
+    switch (batchOp.op) {
+        case BATCH_OP_FILL:
+            // A solid window, clipped to the frame bounds like a partial update
+            bitmapWidth = batchOp.width;
+            bitmapHeight = batchOp.height;
+            targetCount = 0;
+            for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+                if (selectedMask & (1u << i)) {
+                    addTarget(displayManager.getDisplay(i), batchOp.x, batchOp.y);
+                }
+            }
+            prepareRowClip();
+            displayManager.fillRows(targets, targetCount, batchOp.color, 0, bitmapHeight);
+            break;
+            
+        case BATCH_OP_CLEAR:
+            for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+                if (selectedMask & (1u << i)) {
+                    displayManager.getDisplay(i)->clear(batchOp.color);
+                }
+            }
+            break;
+            
+        case BATCH_OP_BLIT:
+            if (pixelEncoding != BIN_ENC_RGB565 && !decoder.isComplete()) {
+                status = BIN_STATUS_DECODE_ERROR;
+            }
+            finishBands();
+            if (status == BIN_STATUS_OK && imageFrameEnabled) {
+                for (uint8_t i = 0; i < targetCount; i++) {
+                    targets[i].display->drawImageFrame(imageFrameColor, imageFrameThickness);
+                }
+            }
+            break;
+            
+        case BATCH_OP_CACHE_SHOW:
+            status = showCachedImage(cacheId, selectedMask, batchOp.flags & (BIN_FLAG_CENTER | BIN_FLAG_FIT),
+                                     fitImages || (batchOp.flags & BIN_FLAG_FIT),
+                                     batchOp.flags & BIN_FLAG_CLEAR, batchOp.x, batchOp.y);
+            break;
+            
+        case BATCH_OP_TEXT: {
+            BinaryTextParams params;
+            memcpy(&params, textPayload, sizeof(params));
+            status = params.reserved != 0 ? (uint8_t)BIN_STATUS_BAD_HEADER
+                   : drawText(selectedMask, batchOp.x, batchOp.y, params,
+                              reinterpret_cast<const char*>(textPayload) + sizeof(params),
+                              batchOp.length - sizeof(params));
+            break;
+        }
+            
+        case BATCH_OP_TILES:
+            status = drawTiles(selectedMask, batchOp.x, batchOp.y, batchOp.length / sizeof(BinaryTileDraw),
+                               batchOp.flags & BIN_FLAG_CLEAR, value);
+            break;
+    }
+    
+    bitmapWidth = 0;
+    bitmapHeight = 0;
+    targetCount = 0;
+    batchOpBytes = 0;
+    if (status == BIN_STATUS_OK) {
+        batchOpsDone++;
+    }
+    return status;
+}
+
+uint8_t SerialProtocol::beginStreamOpen() {
+    // Geometry is checked here; the stream opens once its parameters have arrived intact
+    if (binaryHeader.payloadLength != sizeof(BinaryStreamParams)) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    uint8_t status = resolveBinaryDisplays();
+    if (status != BIN_STATUS_OK) {
+        return status;
+    }
+    
+    uint8_t encoding = binaryHeader.encoding;
+    if (encoding != BIN_ENC_RGB565 && !PixelDecoder::isSupported(encoding)) {
+        return BIN_STATUS_UNSUPPORTED;
+    }
+    int width = binaryHeader.width;
+    int height = binaryHeader.height;
+    if (width <= 0 || height <= 0 || width > LINE_BUFFER_PIXELS) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    
+    // Delta regions are placed relative to the stream origin, so streams are never fitted.
+    // CLEAR waits for openStream(): a STREAM_BEGIN that is then rejected leaves the panels alone
+    addBinaryTargets(binaryHeader.x, binaryHeader.y, width, height, binaryHeader.flags & ~BIN_FLAG_CLEAR, false);
+    return BIN_STATUS_OK;
+}
+
+uint8_t SerialProtocol::openStream() {
+    if (pendingStreamParams.reserved != 0 || pendingStreamParams.dropPolicy > STREAM_DROP_LATE) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    streamParams = pendingStreamParams;
+    
+    streamTargetCount = targetCount;
+    for (uint8_t i = 0; i < targetCount; i++) {
+        streamTargets[i] = targets[i];
+    }
+    streamWidth = binaryHeader.width;
+    streamHeight = binaryHeader.height;
+    streamEncoding = binaryHeader.encoding;
+    streamIntervalMicros = streamParams.targetFps ? 1000000UL / streamParams.targetFps : 0;
+    
+    // Vsync streams: slots of whole refresh periods (one per refresh when unpaced)
+    streamVsyncDisplay = (binaryHeader.flags & BIN_FLAG_VSYNC) ? findVsyncDisplay() : nullptr;
+    if (streamVsyncDisplay && streamVsyncDisplay->measureVsync()) {
+        uint32_t period = streamVsyncDisplay->getVsyncPeriod();
+        uint32_t periods = (streamIntervalMicros + period / 2) / period;
+        streamIntervalMicros = max(periods, (uint32_t)1) * period;
+    }
+    streamDueMicros = micros();
+    streamStartMillis = millis();
+    streamLastFrameMillis = streamStartMillis;
+    streamFramesShown = 0;
+    streamFramesDropped = 0;
+    streamActive = true;
+    
+    if (binaryHeader.flags & BIN_FLAG_CLEAR) {
+        for (uint8_t i = 0; i < targetCount; i++) {
+            targets[i].display->clear();
         }
-        
-        if (newRight < innerBound) {
-            serialPort.print("ERROR:Right edge would be past center+10 (minimum: ");
-            serialPort.print(innerBound - configRight);
-            serialPort.println(")");
-            return;
+    }
+    
+    // Frames are delta updates inside the border; it is drawn once here instead of per frame
+    if (imageFrameEnabled) {
+        for (uint8_t i = 0; i < targetCount; i++) {
+            targets[i].display->drawImageFrame(imageFrameColor, imageFrameThickness);
         }
-        
-        usableAreaAdjustRight = adjust;
-        serialPort.print("OK:Right edge adjusted to ");
-        serialPort.println(adjust);
-        
-        // Notify if at outer limit
-        if (newRight >= cfg.width + 10 - 1) {
-            serialPort.print("NOTICE:Right edge at maximum outward position (");
-            serialPort.print(cfg.width + 10 - 1);
-            serialPort.println(" pixels, 10 beyond display)");
+    }
+    return BIN_STATUS_OK;
+}
+
+uint8_t SerialProtocol::beginStreamFrame() {
+    if (!streamActive) {
+        return BIN_STATUS_NO_STREAM;
+    }
+    
+    // width/height 0 = whole window, otherwise a region relative to the stream origin
+    int x = 0;
+    int y = 0;
+    int width = streamWidth;
+    int height = streamHeight;
+    if (binaryHeader.width != 0 || binaryHeader.height != 0) {
+        x = binaryHeader.x;
+        y = binaryHeader.y;
+        width = binaryHeader.width;
+        height = binaryHeader.height;
+        if (width <= 0 || height <= 0 || x < 0 || y < 0 ||
+            x + width > streamWidth || y + height > streamHeight) {
+            return BIN_STATUS_BAD_HEADER;
         }
-        
-        // Immediately update display
-        activeDisplay->drawCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
-                                           usableAreaAdjustLeft, usableAreaAdjustRight,
-                                           imageFrameColor, imageFrameThickness);
-        
-    } else if (cmd == "CALIBRATE") {
-        // Show calibration pattern on active display
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+    }
+    
+    pixelEncoding = streamEncoding;
+    if (pixelEncoding == BIN_ENC_RGB565 ?
+        binaryHeader.payloadLength != (uint32_t)width * height * 2 : binaryHeader.payloadLength == 0) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    if (!scheduleStreamFrame()) {
+        return BIN_STATUS_DROPPED;
+    }
+    
+    bitmapWidth = width;
+    bitmapHeight = height;
+    targetCount = 0;
+    for (uint8_t i = 0; i < streamTargetCount; i++) {
+        addTarget(streamTargets[i].display, streamTargets[i].originX + x, streamTargets[i].originY + y);
+    }
+    
+    currentRow = 0;
+    currentCol = 0;
+    capturePixels = nullptr;
+    if (pixelEncoding != BIN_ENC_RGB565) {
+        decoder.begin(pixelEncoding, (uint32_t)width * height, width);
+    }
+    prepareRowClip();
+    vsyncDisplay = streamVsyncDisplay;
+    return BIN_STATUS_OK;
+}
+
+bool SerialProtocol::scheduleStreamFrame() {
+    if (streamIntervalMicros == 0) {
+        return true;
+    }
+    
+    unsigned long now = micros();
+    long late = (long)(now - streamDueMicros);
+    if (late > (long)streamIntervalMicros) {
+        if (streamParams.dropPolicy == STREAM_DROP_LATE) {
+            // Receiving without drawing is fast: skip this one and give the next frame a fresh slot
+            streamDueMicros = now + streamIntervalMicros;
+            return false;
         }
-        
-        serialPort.print("OK:Showing calibration pattern on ");
-        serialPort.println(activeDisplay->getName());
-        activeDisplay->drawCalibrationFrame(usableAreaAdjustTop, usableAreaAdjustBottom,
-                                           usableAreaAdjustLeft, usableAreaAdjustRight,
-                                           imageFrameColor, imageFrameThickness);
-        serialPort.println("Calibration pattern displayed");
-        
-    } else if (cmd.startsWith("UPDATE_CONFIG:")) {
-        // Update base configuration values
-        // Format: UPDATE_CONFIG:left,right,top,bottom,centerX,centerY
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+        streamDueMicros = now;    // Re-base rather than rushing the following frames
+    } else if (late < 0) {
+        streamDueMicros = now;    // Came in early (wait hint ignored): its slot starts now
+    }
+    streamDueMicros += streamIntervalMicros;
+    return true;
+}
+
+uint32_t SerialProtocol::streamWaitMicros() const {
+    if (streamIntervalMicros == 0) {
+        return 0;
+    }
+    if (streamVsyncDisplay) {
+        // Until the refresh edge that opens the next slot
+        return streamVsyncDisplay->microsUntilVsync(streamDueMicros);
+    }
+    long wait = (long)(streamDueMicros - micros());
+    return wait > 0 ? (uint32_t)wait : 0;
+}
+
+DisplayInstance* SerialProtocol::findVsyncDisplay() const {
+    for (uint8_t i = 0; i < targetCount; i++) {
+        if (targets[i].display->hasVsync()) {
+            return targets[i].display;
         }
-        
-        String params = cmd.substring(14);  // Skip "UPDATE_CONFIG:"
-        int values[6];
-        int idx = 0;
-        int start = 0;
-        
-        // Parse comma-separated values
-        for (int i = 0; i <= params.length(); i++) {
-            if (i == params.length() || params.charAt(i) == ',') {
-                if (idx >= 6) {
-                    serialPort.println("ERROR:Too many parameters");
-                    return;
-                }
-                values[idx++] = params.substring(start, i).toInt();
-                start = i + 1;
+    }
+    return nullptr;
+}
+
+void SerialProtocol::sendStreamStats() {
+    unsigned long elapsed = streamLastFrameMillis - streamStartMillis;
+    uint32_t fpsTenths = elapsed > 0 ? (uint32_t)((uint64_t)streamFramesShown * 10000 / elapsed) : 0;
+    
+    serialPort.println("OK:STREAM_STATS");
+    serialPort.print("Active:");
+    serialPort.println(streamActive ? "Yes" : "No");
+    serialPort.print("Size:");
+    serialPort.print(streamWidth);
+    serialPort.print("x");
+    serialPort.println(streamHeight);
+    serialPort.print("Encoding:");
+    serialPort.println(PixelDecoder::encodingName(streamEncoding));
+    serialPort.print("TargetFps:");
+    serialPort.println(streamParams.targetFps);
+    serialPort.print("Frames:");
+    serialPort.println(streamFramesShown);
+    serialPort.print("Dropped:");
+    serialPort.println(streamFramesDropped);
+    serialPort.print("Fps:");
+    serialPort.print(fpsTenths / 10);
+    serialPort.print(".");
+    serialPort.println(fpsTenths % 10);
+    serialPort.print("Vsync:");
+    serialPort.println(streamVsyncDisplay ? streamVsyncDisplay->getName() : "No");
+    if (streamVsyncDisplay) {
+        uint32_t period = streamVsyncDisplay->getVsyncPeriod();
+        uint32_t refreshTenths = period ? 10000000UL / period : 0;
+        serialPort.print("VsyncPeriodUs:");
+        serialPort.println(period);
+        serialPort.print("RefreshHz:");
+        serialPort.print(refreshTenths / 10);
+        serialPort.print(".");
+        serialPort.println(refreshTenths % 10);
+        serialPort.print("SlotUs:");
+        serialPort.println(streamIntervalMicros);
+        serialPort.print("VsyncTimeouts:");
+        serialPort.println(streamVsyncDisplay->getVsyncTimeouts());
+    }
+    serialPort.println("END_STREAM_STATS");
+}
+
+void SerialProtocol::beginCredit(bool enabled, uint8_t sequence, uint32_t total) {
+    creditEnabled = enabled;
+    creditSequence = sequence;
+    creditTotal = total;
+    creditEdge = 0;
+}
+
+void SerialProtocol::updateCredit() {
+    if (!creditEnabled || creditEdge >= creditTotal) {
+        return;
+    }
+    
+    // Bytes sent but not consumed sit in the ring, so one ring past the consumed count is safe
+    uint32_t edge = transferBytes + BufferedSerial::RX_BUFFER_SIZE;
+    if (creditEdge > 0 && edge < creditEdge + BINARY_CREDIT_INTERVAL && edge < creditTotal) {
+        return;
+    }
+    creditEdge = edge;
+    sendBinaryAck(BIN_OP_CREDIT, creditSequence, BIN_STATUS_OK, edge);
+}
+
+void SerialProtocol::beginTransferStats() {
+    transferStartMicros = micros();
+    transferBytes = 0;
+}
+
+void SerialProtocol::endTransferStats() {
+    lastTransferBytes = transferBytes;
+    lastTransferMicros = micros() - transferStartMicros;
+}
+
+void SerialProtocol::sendStats() {
+    unsigned long now = millis();
+    uint32_t received = serialPort.getTotalReceived();
+    unsigned long intervalMs = now - statsIntervalStart;
+    uint32_t intervalBytes = received - statsIntervalBytes;
+    
+    serialPort.println("OK:STATS");
+    serialPort.print("RxBytes:");
+    serialPort.println(received);
+    serialPort.print("RxBuffered:");
+    serialPort.println(serialPort.getBufferedCount());
+    serialPort.print("RxPeakFill:");
+    serialPort.print(serialPort.getPeakFill());
+    serialPort.print("/");
+    serialPort.println(BufferedSerial::RX_BUFFER_SIZE);
+    serialPort.print("RxRate:");
+    serialPort.println(intervalMs > 0 ? (uint32_t)((uint64_t)intervalBytes * 1000 / intervalMs) : 0);
+    serialPort.print("LastTransferBytes:");
+    serialPort.println(lastTransferBytes);
+    serialPort.print("LastTransferUs:");
+    serialPort.println(lastTransferMicros);
+    serialPort.print("LastTransferRate:");
+    serialPort.println(lastTransferMicros > 0 ?
+                       (uint32_t)((uint64_t)lastTransferBytes * 1000000 / lastTransferMicros) : 0);
+    serialPort.print("Commands:");
+    serialPort.println(commandCount);
+    serialPort.print("CommandLastUs:");
+    serialPort.println(lastCommandMicros);
+    serialPort.print("CommandMaxUs:");
+    serialPort.println(maxCommandMicros);
+    sampleHeap();
+    struct mallinfo heap = mallinfo();
+    serialPort.print("HeapUsed:");
+    serialPort.println(heap.uordblks);
+    serialPort.print("HeapPeak:");
+    serialPort.println(heapPeak);
+    serialPort.print("HeapArena:");
+    serialPort.println(heap.arena);
+#ifdef ST7735_TELEMETRY
+    serialPort.println("Telemetry:On");
+    Telemetry::printSummary(serialPort);
+#else
+    serialPort.println("Telemetry:Off");
+#endif
+    serialPort.println("END_STATS");
+    
+    statsIntervalStart = now;
+    statsIntervalBytes = received;
+}
+
+void SerialProtocol::resetStats() {
+    serialPort.resetStats();
+    statsIntervalStart = millis();
+    statsIntervalBytes = serialPort.getTotalReceived();
+    lastTransferBytes = 0;
+    lastTransferMicros = 0;
+    commandCount = 0;
+    lastCommandMicros = 0;
+    maxCommandMicros = 0;
+    heapPeak = 0;
+    sampleHeap();
+#ifdef ST7735_TELEMETRY
+    Telemetry::reset();
+#endif
+}
+
+void SerialProtocol::sampleHeap() {
+    // Heap bytes in use (newlib allocator); CMD: parsing itself never allocates,
+    // so a rising peak points at a library call
+    uint32_t used = mallinfo().uordblks;
+    if (used > heapPeak) {
+        heapPeak = used;
+    }
+}
+
+void SerialProtocol::sendProfile() {
+#ifdef ST7735_TELEMETRY
+    serialPort.println("OK:PROFILE");
+    Telemetry::printProfile(serialPort);
+    serialPort.println("END_PROFILE");
+#else
+    serialPort.println("ERROR:Telemetry disabled (build with -DST7735_TELEMETRY)");
+#endif
+}
+
+void SerialProtocol::runBenchmark(char* args) {
+    // BENCH[:kernel[,frames[,width,height]]]
+    uint16_t frames = 10;
+    int width = 0;
+    int height = 0;
+    char* cursor = args;
+    char* kernelName = trimLine(nextField(cursor, ','));
+    if (cursor) {
+        long values[3] = { 0, 0, 0 };
+        int count = parseNumbers(cursor, values, 3);
+        frames = constrain(values[0], 1, (long)Benchmark::MAX_FRAMES);
+        if (count >= 2) {
+            if (count < 3) {
+                serialPort.println("ERROR:Invalid format. Use BENCH[:kernel[,frames[,width,height]]]");
+                return;
+            }
+            width = values[1];
+            height = values[2];
+            if (width <= 0 || height <= 0 || width > PixelDecoder::DITHER_MAX_WIDTH || height > MAX_DIMENSION) {
+                serialPort.println("ERROR:Invalid benchmark size");
+                return;
             }
         }
-        
-        if (idx != 6) {
-            serialPort.println("ERROR:Expected 6 parameters (left,right,top,bottom,centerX,centerY)");
+    }
+    for (char* c = kernelName; *c; c++) {
+        *c = toupper((unsigned char)*c);
+    }
+    
+    int selected = -1;
+    if (*kernelName && strcmp(kernelName, "ALL") != 0) {
+        selected = Benchmark::findKernel(kernelName);
+        if (selected < 0) {
+            serialPort.print("ERROR:Unknown benchmark kernel: ");
+            serialPort.println(kernelName);
             return;
         }
-        
-        // Update the display's configuration
-        DisplayConfig& cfg = const_cast<DisplayConfig&>(activeDisplay->getConfig());
-        cfg.usableX = values[0];  // left
-        cfg.usableWidth = values[1] - values[0] + 1;  // width from right-left+1
-        cfg.usableY = values[2];  // top
-        cfg.usableHeight = values[3] - values[2] + 1;  // height from bottom-top+1
-        cfg.centerX = values[4];
-        cfg.centerY = values[5];
-        
-        // Reset adjustments since we're committing to new base config
-        usableAreaAdjustTop = 0;
-        usableAreaAdjustBottom = 0;
-        usableAreaAdjustLeft = 0;
-        usableAreaAdjustRight = 0;
-        
-        serialPort.println("OK:Base configuration updated");
-        serialPort.print("New usable area: ");
-        serialPort.print(cfg.usableX);
-        serialPort.print(",");
-        serialPort.print(cfg.usableX + cfg.usableWidth - 1);
-        serialPort.print(",");
-        serialPort.print(cfg.usableY);
-        serialPort.print(",");
-        serialPort.println(cfg.usableY + cfg.usableHeight - 1);
-        serialPort.print("New center: ");
-        serialPort.print(cfg.centerX);
-        serialPort.print(",");
-        serialPort.println(cfg.centerY);
-        serialPort.println("NOTE:Changes lost on power cycle - update .config file for permanent storage");
-        
-    } else if (cmd.startsWith("ORIENTATION:")) {
-        // Set display orientation/rotation
-        // Format: ORIENTATION:value (0-3)
-        if (!activeDisplay) {
-            serialPort.println("ERROR:No active display selected");
-            return;
+    }
+    if (!selectedMask) {
+        serialPort.println("ERROR:No display selected");
+        return;
+    }
+    
+    serialPort.println("OK:BENCH");
+    for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+        DisplayInstance* display = displayManager.getDisplay(i);
+        if (!(selectedMask & (1u << i)) || !display->getTFT()) {
+            continue;
         }
-        
-        int rotation = cmd.substring(12).toInt();  // Skip "ORIENTATION:"
-        
-        if (rotation < 0 || rotation > 3) {
-            serialPort.println("ERROR:Invalid orientation. Use 0-3 (0=Portrait, 1=Landscape, 2=Reverse Portrait, 3=Reverse Landscape)");
-            return;
+        const DisplayConfig& cfg = display->getConfig();
+        int w = width ? width : cfg.usableWidth;
+        int h = height ? height : cfg.usableHeight;
+        for (uint8_t k = 0; k < Benchmark::getKernelCount(); k++) {
+            if (selected < 0 || selected == k) {
+                benchmarkKernel(k, display, w, h, frames);
+            }
         }
-        
-        Adafruit_ST7735* tft = activeDisplay->getTFT();
-        if (!tft) {
-            serialPort.println("ERROR:Display not initialized");
-            return;
+    }
+    serialPort.println("END_BENCH");
+    
+    // The band buffers held synthetic data; nothing of the last image is left in them
+    targetCount = 0;
+    lineBuffer = lineBuffers[0];
+    bandRowCount = 0;
+}
+
+void SerialProtocol::benchmarkKernel(uint8_t kernel, DisplayInstance* display, int width, int height,
+                                     uint16_t frames) {
+    // Targets and row clip exactly as for a received centred image
+    targetCount = 0;
+    addCenteredTarget(display, width, height, false);
+    bitmapWidth = width;
+    bitmapHeight = height;
+    prepareRowClip();
+    
+    uint16_t* const bands[2] = { lineBuffers[0], lineBuffers[1] };
+    BenchResult result;
+    Benchmark::run(kernel, displayManager, targets, targetCount, width, height, bands, LINE_BUFFER_PIXELS,
+                   bandCapacity, decoder, frames, result);
+    
+    const BenchKernel& bench = Benchmark::getKernel(kernel);
+    serialPort.print("BENCH:kernel=");
+    serialPort.print(bench.name);
+    serialPort.print(",display=");
+    serialPort.print(display->getConfig().name);
+    serialPort.print(",width=");
+    serialPort.print(width);
+    serialPort.print(",height=");
+    serialPort.print(height);
+    serialPort.print(",frames=");
+    serialPort.print(frames);
+    serialPort.print(",avg_us=");
+    serialPort.print(result.totalMicros / frames);
+    serialPort.print(",min_us=");
+    serialPort.print(result.minMicros);
+    serialPort.print(",max_us=");
+    serialPort.print(result.maxMicros);
+    if (bench.kind == BENCH_DECODE) {
+        serialPort.print(",ok=");
+        serialPort.print(result.complete ? 1 : 0);
+        serialPort.print(",checksum=");
+        serialPort.print(result.checksum);
+    }
+    serialPort.println();
+}
+
+void SerialProtocol::selectDisplays(uint8_t mask) {
+    selectedMask = mask;
+    activeDisplay = nullptr;
+    for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+        if (mask & (1u << i)) {
+            activeDisplay = displayManager.getDisplay(i);
+            break;
         }
-        
-        tft->setRotation(rotation);
-        serialPort.print("OK:Orientation set to ");
-        serialPort.println(rotation);
-        
-    } else if (cmd == "HELP") {
-        // Show command help
-        serialPort.println("OK:HELP");
-        serialPort.println("Available CMD: commands:");
-        serialPort.println("  CMD:LIST - List all displays");
-        serialPort.println("  CMD:INFO - Show active display info");
-        serialPort.println("  CMD:TEST - Test active display");
-        serialPort.println("  CMD:TEST_ALL - Test all displays");
-        serialPort.println("  CMD:FRAME_ON - Enable frame");
-        serialPort.println("  CMD:FRAME_OFF - Disable frame");
-        serialPort.println("  CMD:FRAME_COLOR:value - Set frame color (0-65535)");
-        serialPort.println("  CMD:FRAME_THICKNESS:value - Set thickness (1-10)");
-        serialPort.println("  CMD:ADJUST_TOP:value - Adjust top edge (relative to config)");
-        serialPort.println("  CMD:ADJUST_BOTTOM:value - Adjust bottom edge");
-        serialPort.println("  CMD:ADJUST_LEFT:value - Adjust left edge");
-        serialPort.println("  CMD:ADJUST_RIGHT:value - Adjust right edge");
-        serialPort.println("  CMD:CALIBRATE - Show calibration pattern");
-        serialPort.println("  CMD:UPDATE_CONFIG:left,right,top,bottom,centerX,centerY - Update base config");
-        serialPort.println("  CMD:ORIENTATION:value - Set rotation (0=Portrait, 1=Landscape, 2=Rev Portrait, 3=Rev Landscape)");
-        serialPort.println("  CMD:HELP - Show this help");
-        serialPort.println();
-        serialPort.println("Bitmap protocol commands:");
-        serialPort.println("  DISPLAY:<name> - Select display for bitmap");
-        serialPort.println("  BMPStart - Start bitmap transfer");
-        serialPort.println("  SIZE:width,height - Set bitmap dimensions");
-        serialPort.println("  <pixel data> - Send RGB565 pixel data");
-        serialPort.println("  BMPEnd - End bitmap transfer");
-        serialPort.println("END_HELP");
-        
-    } else {
-        serialPort.print("ERROR:Unknown command: ");
-        serialPort.println(cmd);
     }
 }
 
-void SerialProtocol::handleStart() {
-    // Ensure we have an active display before accepting bitmap
-    if (!activeDisplay) {
-        sendError("No active display selected");
-        currentState = WAITING_FOR_DISPLAY_SELECT;
+void SerialProtocol::beginSnapshotCapture(bool fitted) {
+    // Record where the image landed on the first target; restores re-centre (and re-fit) it
+    capturePixels = DisplaySnapshot::beginCapture(bitmapWidth, bitmapHeight,
+                                                  targets[0].originX, targets[0].originY,
+                                                  SNAPSHOT_CENTERED | (fitted ? SNAPSHOT_FITTED : 0));
+}
+
+void SerialProtocol::showSnapshot(DisplayInstance* display) {
+    const SnapshotHeader* hdr = DisplaySnapshot::getSnapshotHeader();
+    if (!hdr || !display || !display->getTFT()) {
         return;
     }
     
-    String command = serialPort.readStringUntil('\n');
-    command.trim();
-    
-    // Handle CMD: commands in any state
-    if (command.startsWith("CMD:")) {
-        handleMenuCommand(command.substring(4));
-        return;
+    DisplayTarget target;
+    target.display = display;
+    target.originX = hdr->offsetX;
+    target.originY = hdr->offsetY;
+    if (hdr->flags & SNAPSHOT_CENTERED) {
+        display->centerTarget(target, hdr->width, hdr->height, hdr->flags & SNAPSHOT_FITTED);
+        display->clear();
     }
     
-    if (command == "BMPStart") {
-        serialPort.println("Start marker received");
-        currentState = WAITING_FOR_SIZE;
-    } else if (command.length() > 0) {
-        sendError("Expected BMPStart, got: " + command);
+    // Same clipped bulk path as reception: the whole snapshot is one band
+    display->clipTarget(target, hdr->width, hdr->height,
+                        usableAreaAdjustTop, usableAreaAdjustBottom,
+                        usableAreaAdjustLeft, usableAreaAdjustRight);
+    displayManager.pushBand(&target, 1, DisplaySnapshot::getSnapshotPixels(),
+                            hdr->width, 0, hdr->height);
+    DisplayInstance::finishPendingPush();
+    
+    if (imageFrameEnabled) {
+        display->drawImageFrame(imageFrameColor, imageFrameThickness);
     }
 }
 
-void SerialProtocol::handleSize() {
-    String sizeCommand = serialPort.readStringUntil('\n');
-    sizeCommand.trim();
-    
-    if (sizeCommand.startsWith("SIZE:")) {
-        int commaIndex = sizeCommand.indexOf(',');
-        if (commaIndex > 0) {
-            bitmapWidth = sizeCommand.substring(5, commaIndex).toInt();
-            bitmapHeight = sizeCommand.substring(commaIndex + 1).toInt();
-            
-            if (validateDimensions(bitmapWidth, bitmapHeight) && 
-                calculateOffsets(bitmapWidth, bitmapHeight, offsetX, offsetY)) {
-                
-                // Clear display BEFORE sending READY
-                if (activeDisplay) {
-                    serialPort.println("Clearing display...");
-                    activeDisplay->getTFT()->fillScreen(ST77XX_BLACK);
-                    delay(50);  // Brief delay to ensure clear completes
-                }
-                
-                serialPort.println("READY");
-                serialPort.print("Receiving bitmap: ");
-                serialPort.print(bitmapWidth);
-                serialPort.print("x");
-                serialPort.println(bitmapHeight);
-                
-                currentRow = 0;
-                currentCol = 0;
-                currentState = RECEIVING_DATA;
-                
-                serialPort.print("Ready to receive ");
-                serialPort.print(bitmapWidth * bitmapHeight);
-                serialPort.println(" pixels");
-            }
-        } else {
-            sendError("Invalid size format");
-        }
+void SerialProtocol::fillScrollLines(DisplayInstance* display, int first, int count) {
+    // Blank logical lines across the usable area, leaving the frame edges alone
+    const DisplayConfig& cfg = display->getConfig();
+    int inset = imageFrameEnabled ? imageFrameThickness : 0;
+    Adafruit_ST7735* tft = display->getTFT();
+    if (display->isScrollVertical()) {
+        tft->fillRect(cfg.usableX + inset, first, cfg.usableWidth - 2 * inset, count, ST77XX_BLACK);
+    } else {
+        tft->fillRect(first, cfg.usableY + inset, count, cfg.usableHeight - 2 * inset, ST77XX_BLACK);
     }
 }
 
-void SerialProtocol::handleDataReception() {
-    if (!activeDisplay) {
-        sendError("No active display");
-        return;
+void SerialProtocol::storeCacheBytes(const uint8_t* data, size_t length) {
+    if (cacheWrite) {
+        memcpy(cacheWrite, data, length);
+        cacheWrite += length;
+    }
+}
+
+uint8_t SerialProtocol::showCachedImage(uint8_t id, uint8_t mask, bool center, bool fit, bool clear, int x, int y) {
+    // The snapshot entry has its own layout (CMD:SNAPSHOT draws it)
+    const CachedImage* image = id != IMAGE_CACHE_SNAPSHOT_ID ? ImageCache::find(id) : nullptr;
+    if (!image) {
+        return BIN_STATUS_CACHE_MISS;
+    }
+    if (image->encoding == BIN_ENC_GLYPH_ATLAS) {
+        return BIN_STATUS_UNSUPPORTED;   // Used by CMD:TEXT, not drawable itself
     }
     
-    Adafruit_ST7735* tft = activeDisplay->getTFT();
-    
-    // Read pixel data (2 bytes per pixel for RGB565)
-    while (serialPort.available() >= 2 && currentState == RECEIVING_DATA) {
-        if (currentRow >= bitmapHeight) {
-            currentState = WAITING_FOR_END;
-            break;
+    beginReplay(image->width, image->height, mask, center, fit, clear, x, y);
+    uint8_t status = BIN_STATUS_OK;
+    const uint8_t* data = ImageCache::getData(image);
+    if (image->encoding == BIN_ENC_RGB565) {
+        consumePixelBytes(data, image->length);
+    } else {
+        decoder.begin(image->encoding, (uint32_t)bitmapWidth * bitmapHeight, bitmapWidth);
+        decoder.decode(data, image->length, *this);
+        if (!decoder.isComplete()) {
+            status = BIN_STATUS_DECODE_ERROR;
         }
-        
-        // Read RGB565 pixel data (big-endian)
-        uint8_t highByte = serialPort.read();
-        uint8_t lowByte = serialPort.read();
-        uint16_t pixelColor = (highByte << 8) | lowByte;
-        
-        // Calculate pixel position
-        int displayX = currentCol + offsetX;
-        int displayY = currentRow + offsetY;
-        
-        // Draw pixel with frame bounds checking (acts as cropping guide)
-        // Frame adjustments define the visible area regardless of frame visibility
-        if (activeDisplay->isWithinFrameBounds(displayX, displayY,
-                                              usableAreaAdjustTop, usableAreaAdjustBottom,
-                                              usableAreaAdjustLeft, usableAreaAdjustRight)) {
-            tft->drawPixel(displayX, displayY, pixelColor);
+    }
+    finishReplay();
+    return status;
+}
+
+void SerialProtocol::beginReplay(int width, int height, uint8_t mask, bool center, bool fit, bool clear,
+                                 int x, int y) {
+    bitmapWidth = width;
+    bitmapHeight = height;
+    targetCount = 0;
+    for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+        DisplayInstance* display = displayManager.getDisplay(i);
+        if (!(mask & (1u << i)) || !display->getTFT()) {
+            continue;
         }
-        
-        // Advance to next pixel
-        currentCol++;
-        if (currentCol >= bitmapWidth) {
-            currentCol = 0;
-            currentRow++;
-            
-            // Progress indication every PROGRESS_REPORT_INTERVAL rows
-            if (currentRow % PROGRESS_REPORT_INTERVAL == 0 && currentRow < bitmapHeight) {
-                float progress = (float)currentRow / bitmapHeight * 100.0f;
-                serialPort.print("Progress: ");
-                serialPort.print(progress, 1);
-                serialPort.print("% (Row ");
-                serialPort.print(currentRow);
-                serialPort.print("/");
-                serialPort.print(bitmapHeight);
-                serialPort.println(")");
-            }
+        if (center) {
+            addCenteredTarget(display, bitmapWidth, bitmapHeight, fit);
+        } else {
+            addTarget(display, x, y);
+        }
+        if (clear) {
+            display->clear();
         }
     }
+    
+    // The payload then goes through the normal reception path
+    currentRow = 0;
+    currentCol = 0;
+    pendingPixelByte = -1;
+    capturePixels = nullptr;
+    prepareRowClip();
 }
 
-void SerialProtocol::handleEnd() {
-    String endCommand = serialPort.readStringUntil('\n');
-    endCommand.trim();
+void SerialProtocol::finishReplay() {
+    finishBands();
     
-    if (endCommand == "BMPEnd") {
-        // Draw frame if enabled
-        if (imageFrameEnabled && activeDisplay) {
-            activeDisplay->drawImageFrame(imageFrameColor, imageFrameThickness);
+    if (imageFrameEnabled) {
+        for (uint8_t i = 0; i < targetCount; i++) {
+            targets[i].display->drawImageFrame(imageFrameColor, imageFrameThickness);
         }
-        
-        currentState = BITMAP_COMPLETE;
-        serialPort.println("COMPLETE");
-        serialPort.println("Bitmap display completed successfully!");
     }
 }
 
-void SerialProtocol::handleComplete() {
-    // Ready for next bitmap - stay in display selected mode
-    currentState = WAITING_FOR_START;
+int SerialProtocol::parseStoreFrames(char* ids, long* frameIds, const StoredImage* entry) {
+    // Cached image ids for STORE_SAVE / STORE_ADD; -1 (after the reply) if one is unusable.
+    // Checked before anything is written: flash cannot take back a partial append
+    int count = parseNumbers(ids, frameIds, MAX_STORE_FRAMES);
+    if (count > MAX_STORE_FRAMES) {
+        serialPort.print("ERROR:At most ");
+        serialPort.print(MAX_STORE_FRAMES);
+        serialPort.println(" frames per command (append more with STORE_ADD)");
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        long id = frameIds[i];
+        const CachedImage* image = id >= 0 && id < IMAGE_CACHE_SNAPSHOT_ID ? ImageCache::find(id) : nullptr;
+        if (!image) {
+            serialPort.print("ERROR:Image not cached: ");
+            serialPort.println(id);
+            return -1;
+        }
+        if (image->encoding == BIN_ENC_GLYPH_ATLAS) {
+            serialPort.print("ERROR:Not an image: ");
+            serialPort.println(id);
+            return -1;
+        }
+        if (i == 0 && !entry) {
+            continue;
+        }
+        const CachedImage* first = ImageCache::find(frameIds[0]);
+        uint16_t width = entry ? entry->width : first->width;
+        uint16_t height = entry ? entry->height : first->height;
+        uint8_t encoding = entry ? entry->encoding : first->encoding;
+        if (image->width != width || image->height != height || image->encoding != encoding) {
+            serialPort.print("ERROR:Frame size or encoding differs: ");
+            serialPort.println(id);
+            return -1;
+        }
+    }
+    return count;
+}
+
+void SerialProtocol::sendStoreError(StoreStatus status) {
+    serialPort.print("ERROR:");
+    serialPort.print(ImageStore::statusName(status));
+    if (status == STORE_NOT_MOUNTED) {
+#ifdef ST7735_IMAGE_STORE
+        serialPort.print(" (no SPI flash answered on CS pin ");
+        serialPort.print(IMAGE_STORE_CS);
+        serialPort.print(", or not formatted)");
+#else
+        serialPort.print(" (build with -DST7735_IMAGE_STORE)");
+#endif
+    }
+    serialPort.println();
+}
+
+bool SerialProtocol::play(const char* name, uint8_t mask, uint16_t loops) {
+    return Playback::start(name, mask, loops, *this);
+}
+
+void SerialProtocol::beginFrame(const StoredImage& item, uint16_t frame, uint8_t mask) {
+    // Later frames of a sequence overwrite the same window without a clear
+    beginReplay(item.width, item.height, mask, true, fitImages, frame == 0, 0, 0);
+    pixelEncoding = item.encoding;
+    if (pixelEncoding != BIN_ENC_RGB565) {
+        decoder.begin(pixelEncoding, (uint32_t)bitmapWidth * bitmapHeight, bitmapWidth);
+    }
+}
+
+void SerialProtocol::frameBytes(const uint8_t* data, size_t length) {
+    if (pixelEncoding == BIN_ENC_RGB565) {
+        consumePixelBytes(data, length);
+    } else {
+        decoder.decode(data, length, *this);
+    }
+}
+
+bool SerialProtocol::finishFrame(bool readOk) {
+    bool complete = readOk && (pixelEncoding == BIN_ENC_RGB565 || decoder.isComplete());
+    finishReplay();
     bitmapWidth = 0;
     bitmapHeight = 0;
-    currentRow = 0;
-    currentCol = 0;
-    offsetX = 0;
-    offsetY = 0;
-    serialPort.println("Ready for next bitmap");
+    targetCount = 0;
+    return complete;
 }
 
-bool SerialProtocol::validateDimensions(int width, int height) {
-    if (!activeDisplay) {
+uint8_t SerialProtocol::drawText(uint8_t mask, int x, int y, const BinaryTextParams& params,
+                                 const char* text, size_t length) {
+    if (!mask) {
+        return BIN_STATUS_NO_DISPLAY;
+    }
+    GlyphAtlas atlas = GlyphAtlas::builtin();
+    if (params.atlas != GLYPH_ATLAS_BUILTIN_ID) {
+        const CachedImage* entry = ImageCache::find(params.atlas);
+        if (!entry) {
+            return BIN_STATUS_CACHE_MISS;
+        }
+        if (entry->encoding != BIN_ENC_GLYPH_ATLAS || !atlas.load(ImageCache::getData(entry), entry->length)) {
+            return BIN_STATUS_UNSUPPORTED;
+        }
+    }
+    if (!glyphText.layout(atlas, text, length, params.scale)) {
+        return BIN_STATUS_BAD_HEADER;
+    }
+    
+    // The text box is a partial update at (x, y) on every display, clipped to its frame bounds
+    for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+        DisplayInstance* display = displayManager.getDisplay(i);
+        if (!(mask & (1u << i)) || !display->getTFT()) {
+            continue;
+        }
+        DisplayTarget target;
+        target.display = display;
+        target.originX = x;
+        target.originY = y;
+        display->clipTarget(target, glyphText.getWidth(), glyphText.getHeight(),
+                            usableAreaAdjustTop, usableAreaAdjustBottom,
+                            usableAreaAdjustLeft, usableAreaAdjustRight);
+        glyphText.draw(target, params.foreground, params.background, params.flags & TEXT_FLAG_OPAQUE);
+    }
+    DisplayInstance::finishPendingPush();
+    return BIN_STATUS_OK;
+}
+
+uint8_t SerialProtocol::drawTiles(uint8_t mask, int x, int y, uint8_t count, bool clear, uint32_t& value) {
+    if (!mask) {
+        return BIN_STATUS_NO_DISPLAY;
+    }
+    
+    // Tiles are read in place, so every one must be a complete raw entry
+    for (uint8_t i = 0; i < count; i++) {
+        const BinaryTileDraw& draw = tileList[i];
+        value = draw.id;
+        if (draw.reserved != 0) {
+            return BIN_STATUS_BAD_HEADER;
+        }
+        const CachedImage* tile = draw.id != IMAGE_CACHE_SNAPSHOT_ID ? ImageCache::find(draw.id) : nullptr;
+        if (!tile) {
+            return BIN_STATUS_CACHE_MISS;
+        }
+        if (tile->encoding != BIN_ENC_RGB565 || tile->length != (uint32_t)tile->width * tile->height * 2) {
+            return BIN_STATUS_UNSUPPORTED;
+        }
+        tileDraws[i].pixels = reinterpret_cast<const uint16_t*>(ImageCache::getData(tile));
+        tileDraws[i].x = draw.x;
+        tileDraws[i].y = draw.y;
+        tileDraws[i].width = tile->width;
+        tileDraws[i].height = tile->height;
+    }
+    
+    targetCount = 0;
+    for (uint8_t i = 0; i < displayManager.getDisplayCount(); i++) {
+        DisplayInstance* display = displayManager.getDisplay(i);
+        if (!(mask & (1u << i)) || !display->getTFT()) {
+            continue;
+        }
+        addTarget(display, x, y);
+        if (clear) {
+            display->clear();
+        }
+    }
+    value = displayManager.composeTiles(targets, targetCount, tileDraws, count,
+                                        usableAreaAdjustTop, usableAreaAdjustBottom,
+                                        usableAreaAdjustLeft, usableAreaAdjustRight);
+    DisplayInstance::finishPendingPush();
+    targetCount = 0;
+    return BIN_STATUS_OK;
+}
+
+bool SerialProtocol::validateDimensions(DisplayInstance* display, int width, int height, bool fitUsableArea) {
+    if (!display) {
         sendError("No active display selected");
         return false;
     }
     
-    const DisplayConfig& cfg = activeDisplay->getConfig();
+    const DisplayConfig& cfg = display->getConfig();
+    char message[64];   // Error text, formatted on the stack
     
     // Check for negative or zero dimensions
     if (width <= 0 || height <= 0) {
-        sendError("Invalid dimensions: width=" + String(width) + ", height=" + String(height));
+        snprintf(message, sizeof(message), "Invalid dimensions: width=%d, height=%d", width, height);
+        sendError(message);
         return false;
     }
     
     // Check against maximum allowed dimensions
     if (width > MAX_DIMENSION || height > MAX_DIMENSION) {
-        sendError("Dimensions too large: width=" + String(width) + ", height=" + String(height));
+        snprintf(message, sizeof(message), "Dimensions too large: width=%d, height=%d", width, height);
+        sendError(message);
+        return false;
+    }
+    
+    // Partial updates are clipped to the frame bounds instead
+    if (fitUsableArea && width > cfg.usableWidth) {
+        snprintf(message, sizeof(message), "Width %d exceeds usable width %d on ", width, cfg.usableWidth);
+        sendError(message, display->getName());
         return false;
     }
     
-    if (width > cfg.usableWidth) {
-        sendError("Width " + String(width) + " exceeds usable width " + String(cfg.usableWidth));
+    if (fitUsableArea && height > cfg.usableHeight) {
+        snprintf(message, sizeof(message), "Height %d exceeds usable height %d on ", height, cfg.usableHeight);
+        sendError(message, display->getName());
         return false;
     }
     
-    if (height > cfg.usableHeight) {
-        sendError("Height " + String(height) + " exceeds usable height " + String(cfg.usableHeight));
+    if (width > LINE_BUFFER_PIXELS) {
+        snprintf(message, sizeof(message), "Width %d exceeds line buffer %d", width, LINE_BUFFER_PIXELS);
+        sendError(message);
         return false;
     }
     
-    serialPort.print("Dimensions validated: ");
+    serialPort.print("Dimensions validated for ");
+    serialPort.print(display->getName());
+    serialPort.print(": ");
     serialPort.print(width);
     serialPort.print("x");
     serialPort.println(height);
     return true;
 }
 
-bool SerialProtocol::calculateOffsets(int bmpWidth, int bmpHeight, int& offsetX, int& offsetY) {
-    if (!activeDisplay) {
+bool SerialProtocol::calculateOffsets(DisplayInstance* display, int bmpWidth, int bmpHeight,
+                                      int& offsetX, int& offsetY) {
+    if (!display) {
         return false;
     }
     
-    const DisplayConfig& cfg = activeDisplay->getConfig();
+    const DisplayConfig& cfg = display->getConfig();
     
     // Calculate centering offsets within usable area
     int usableCenterX = cfg.usableX + cfg.usableWidth / 2;
@@ -814,8 +3250,8 @@ bool SerialProtocol::calculateOffsets(int bmpWidth, int bmpHeight, int& offsetX,
     int minY = offsetY;
     int maxY = offsetY + bmpHeight - 1;
     
-    if (!activeDisplay->isWithinBounds(minX, minY) || 
-        !activeDisplay->isWithinBounds(maxX, maxY)) {
+    if (!display->isWithinBounds(minX, minY) || 
+        !display->isWithinBounds(maxX, maxY)) {
         sendError("Calculated bitmap position exceeds bounds");
         return false;
     }
@@ -851,20 +3287,22 @@ bool SerialProtocol::calculateOffsets(int bmpWidth, int bmpHeight, int& offsetX,
     return true;
 }
 
-void SerialProtocol::sendError(const String& message) {
+void SerialProtocol::sendError(const char* message, const char* detail) {
     serialPort.print("ERROR: ");
-    serialPort.println(message);
+    serialPort.print(message);
+    serialPort.println(detail ? detail : "");
     
     // Display error on active display
     if (activeDisplay && activeDisplay->getTFT()) {
+        activeDisplay->clear(ST77XX_RED);
         Adafruit_ST7735* tft = activeDisplay->getTFT();
-        tft->fillScreen(ST77XX_RED);
         tft->setTextColor(ST77XX_WHITE);
         tft->setTextSize(1);
         tft->setCursor(5, 10);
         tft->println("ERROR:");
         tft->setCursor(5, 25);
-        tft->println(message);
+        tft->print(message);
+        tft->println(detail ? detail : "");
     }
     
     reset();
@@ -872,13 +3310,30 @@ void SerialProtocol::sendError(const String& message) {
 
 void SerialProtocol::reset() {
     currentState = WAITING_FOR_DISPLAY_SELECT;
+    commandLength = 0;
     activeDisplay = nullptr;
+    selectedMask = 0;
+    targetCount = 0;
     bitmapWidth = 0;
     bitmapHeight = 0;
     currentRow = 0;
     currentCol = 0;
-    offsetX = 0;
-    offsetY = 0;
+    partialUpdate = false;
+    if (capturePixels) {
+        // Transfer abandoned: keep the previous snapshot
+        DisplaySnapshot::abortCapture();
+    }
+    capturePixels = nullptr;
+    cacheId = -1;
+    cacheWrite = nullptr;
+    pixelEncoding = BIN_ENC_RGB565;
+    pixelBytesRemaining = 0;
+    pendingPixelByte = -1;
+    pixelError = nullptr;
+    creditEnabled = false;
+    streamActive = false;
+    bandRowCount = 0;
+    stopPlayback();
 }
 
 void SerialProtocol::checkTimeout() {
@@ -889,6 +3344,17 @@ void SerialProtocol::checkTimeout() {
         currentState != WAITING_FOR_START &&
         currentState != BITMAP_COMPLETE && 
         (millis() - lastActivity > TIMEOUT_MS)) {
+        TELEMETRY_COUNT(TELEMETRY_TIMEOUTS, 1);
+        
+        // Binary senders wait for an ack rather than parsing text: no error
+        // text in the ack stream and no red screen
+        if (currentState == RECEIVING_BINARY_HEADER || currentState == RECEIVING_BINARY_PAYLOAD) {
+            sendBinaryAck(binaryHeader.opcode, binaryHeader.sequence, BIN_STATUS_TIMEOUT, 0);
+            reset();
+            lastActivity = millis();
+            return;
+        }
+        
         sendError("Timeout waiting for data");
         serialPort.println("Timeout - resetting protocol");
         reset();  // Actually reset the protocol state
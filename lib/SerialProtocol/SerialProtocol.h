@@ -13,20 +13,110 @@
  *   CMD:FRAME_OFF - Disable frame
  *   CMD:FRAME_COLOR:value - Set frame color (0-65535)
  *   CMD:FRAME_THICKNESS:value - Set frame thickness (1-10)
+ *   CMD:FIT_ON / CMD:FIT_OFF - Turn and scale centred images (full SIZE
+ *     transfers, centred BLITs, SNAPSHOT and CACHE_SHOW) to each display's
+ *     usable area, so one canonical asset suits every panel; see
+ *     DisplayInstance::centerTarget()
+ *   CMD:PALETTE:c0,c1,... - Load the session palette for indexed encodings
+ *   CMD:STATS - Show receive statistics (bytes, buffer fill, rates), CMD: latency
+ *     (last / max microseconds) and heap use (current, peak, arena); builds with
+ *     -DST7735_TELEMETRY add per-stage cycle timings and pixel counters (see Telemetry.h)
+ *   CMD:STATS_RESET - Clear the statistics and stage timings for a new measurement
+ *   CMD:PROFILE - Per-stage latency histograms (telemetry builds only)
+ *   CMD:BENCH[:<kernel>[,<frames>[,<w>,<h>]]] - Run synthetic kernels on each
+ *     selected display and report microseconds per frame, one
+ *     "BENCH:kernel=..,display=..,width=..,height=..,frames=..,avg_us=..,min_us=..,max_us=.."
+ *     line per kernel and display between OK:BENCH and END_BENCH. FILL and BLIT
+ *     draw a w x h window (default: the usable area) through fillRows / pushBand;
+ *     RLE, QOI, IDX4, RGB888 and FS (RGB888 with Floyd-Steinberg) only time the
+ *     decoder on a synthetic payload. Kernel ALL (default) runs every one
+ *   CMD:SNAPSHOT[:<name>,...|ALL] - Redraw the last full image (selected displays by default)
+ *   CMD:SNAPSHOT_INFO / CMD:SNAPSHOT_CLEAR - Inspect / free the snapshot
+ *   CMD:CACHE_SHOW:<id>[:<name>,...|ALL] - Draw a cached image (see ImageCache.h)
+ *   CMD:CACHE_LIST / CMD:CACHE_DROP:<id> / CMD:CACHE_CLEAR - Manage the image cache
+ *   CMD:STREAM_STATS - Show stream mode frame counts, achieved FPS and, for
+ *     vsync streams (BIN_FLAG_VSYNC), the panel refresh period
+ *   CMD:STORE_SAVE:<name>[,<delay_ms>]:<id>[,<id>...] - Write cached images to
+ *     the SPI flash image store (see ImageStore.h) as one image, or as a
+ *     sequence shown delay_ms apart; an existing name is replaced
+ *   CMD:STORE_ADD:<name>:<id>[,<id>...] - Append cached frames to the newest entry
+ *   CMD:STORE_PLAYLIST:<name>[,<hold_ms>]:<entry>,... - Store a playlist of
+ *     entry names, each held hold_ms after its last frame
+ *   CMD:STORE_LIST / CMD:STORE_INFO / CMD:STORE_DELETE:<name> / CMD:STORE_FORMAT -
+ *     Manage the store (builds with -DST7735_IMAGE_STORE)
+ *   CMD:PLAY:<name>[,<loops>][:<display>,...|ALL] - Play a stored entry on the
+ *     selected displays from flash, without the host (loops 0 = forever). Frames
+ *     advance while the serial link is idle; BMPStart, a binary frame,
+ *     CMD:STOP or CMD:RESET end playback. An entry named SPLASH plays at boot
+ *   CMD:TEXT:x,y,fg[,bg[,scale[,atlas]]]:<text> - Draw one line of text at (x, y)
+ *     on the selected displays with a glyph atlas (built-in 5x7 font by default,
+ *     or a cached BIN_ENC_GLYPH_ATLAS id), so a changing label needs no image
+ *     upload. bg -1 (default) = transparent. Reply: OK:TEXT:<w>,<h> (see GlyphAtlas.h)
+ *   CMD:TILES:id,x,y[;id,x,y...] - Composite cached raw RGB565 tiles at display
+ *     (x, y) on the selected displays, in order; tiles continuing a strip share
+ *     one address window. Reply: OK:TILES:<tiles>,<windows>
+ *   CMD:SCROLL_AREA[:start,length] / CMD:SCROLL:<lines> / CMD:SCROLL_OFF - Hardware
+ *     scrolling of the active display; SCROLL replies with the logical lines to draw
+ *     the exposed content into, so a new log line costs one partial update
  *   CMD:HELP - Show command help
  *   Responses: OK:<data> or ERROR:<message>
+ *   Lines are parsed in place (no String copies) and CMD: names are looked up in
+ *   the sorted MENU_COMMANDS table, so commands never touch the heap
  * 
  * DISPLAY: - Bitmap protocol (existing)
  * 1. Client: "DISPLAY:<device_name>"  -> Select target display
+ *    "DISPLAY:<name>,<name>,..." or "DISPLAY:ALL" selects several displays;
+ *    one transfer is then broadcast to all of them (centred on each, and
+ *    fitted to each with CMD:FIT_ON: an image larger than the usable area
+ *    is then accepted and reduced instead of rejected)
  * 2. Arduino: "DISPLAY_READY" or "DISPLAY_ERROR"
  * 3. Client: "BMPStart"
  * 4. Arduino: "Start marker received"
  * 5. Client: "SIZE:width,height"
+ *    or "SIZE:width,height,x,y" for a partial (dirty-rectangle) update: the
+ *    window is placed at display coordinates (x, y), not centred, and the
+ *    screen is not cleared. Pixels outside the frame bounds are dropped
+ *    Options may follow after ';': "SIZE:w,h[,x,y];ENC=RLE;LEN=<bytes>"
+ *    selects a compressed encoding (RGB565, RLE, QOI - see PixelDecoder.h)
+ *    whose payload is LEN bytes. Firmware that knows the encoding answers
+ *    "READY:<ENC>"; a bare "READY" means raw RGB565 is expected.
+ *    ENC=IDX1|IDX2|IDX4|IDX8 sends palette indices; add ";PAL" when the
+ *    payload starts with the image's own palette.
+ *    ENC=RGB888 sends 3-byte pixels that the firmware reduces to RGB565,
+ *    optionally with ";DITHER=ORDERED" or ";DITHER=FS" (see PixelDecoder.h)
+ *    ";CREDIT" replaces the progress lines with binary credit messages
+ *    (see BinaryFrame.h) so the host can stream without pacing
+ *    ";CACHE=<id>" (0-254) also keeps the payload, as received, in the
+ *    image cache so CMD:CACHE_SHOW / BIN_OP_CACHE_SHOW can redraw it later
  * 6. Arduino: "READY" (after validation)
  * 7. Client: Raw pixel data (RGB565, 2 bytes per pixel)
+ *    Rows are clipped to the frame bounds once per transfer and pushed to the
+ *    display in row bands (one address window per band). Two band buffers
+ *    alternate so the next band is received while the previous one is DMA'd
  * 8. Arduino: Progress updates
  * 9. Client: "BMPEnd"
  * 10. Arduino: "COMPLETE"
+ * 
+ * Binary frames (see BinaryFrame.h) - accepted whenever no text transfer is
+ * in progress. A leading BINARY_SYNC_BYTE switches the state machine into
+ * frame reception; each frame is answered with a BinaryAck.
+ * 
+ * Stream mode (BIN_OP_STREAM_BEGIN / _FRAME / _END): the displays, window
+ * and encoding are set up once, then each frame (or delta region) packet is
+ * decoded through the same band buffers as a BLIT, without clearing,
+ * snapshot capture or frame redraw. An optional target FPS paces the host
+ * through the frame ack and lets late frames be dropped to catch up. With
+ * BIN_FLAG_VSYNC frames start on a display's tearing-effect edge and the
+ * pacing follows its refresh (see BinaryFrame.h).
+ * 
+ * Batch frames (BIN_OP_BATCH): a list of select / fill / clear / blit /
+ * cache-show / text / tile operations, each optionally aimed at other
+ * displays, run in order as the payload arrives and answered with one ack,
+ * so a multi-step screen update costs one round trip.
+ * 
+ * process() never waits for input: text lines are assembled incrementally
+ * from whatever has been buffered and each state acts once its line is
+ * complete, so loop() can interleave other work between calls.
  */
 
 #ifndef SERIAL_PROTOCOL_H
@@ -34,6 +124,15 @@
 
 #include <Arduino.h>
 #include "DisplayManager.h"
+#include "BinaryFrame.h"
+#include "BufferedSerial.h"
+#include "PixelDecoder.h"
+#include "DisplaySnapshot.h"
+#include "ImageCache.h"
+#include "GlyphAtlas.h"
+#include "ImageStore.h"
+#include "Playback.h"
+#include "Benchmark.h"
 
 // Protocol states
 enum ProtocolState {
@@ -42,13 +141,15 @@ enum ProtocolState {
     WAITING_FOR_SIZE,
     RECEIVING_DATA,
     WAITING_FOR_END,
-    BITMAP_COMPLETE
+    BITMAP_COMPLETE,
+    RECEIVING_BINARY_HEADER,
+    RECEIVING_BINARY_PAYLOAD
 };
 
 // Protocol handler class
-class SerialProtocol {
+class SerialProtocol : private PixelSink, private PlaybackSink {
 public:
-    SerialProtocol(DisplayManager& displayMgr, Stream& serial);
+    SerialProtocol(DisplayManager& displayMgr, BufferedSerial& serial);
     
     // Main processing
     void process();
@@ -57,34 +158,135 @@ public:
     
     // State queries
     ProtocolState getState() const { return currentState; }
+    bool isTransferActive() const;
     DisplayInstance* getActiveDisplay() const { return activeDisplay; }
+    uint8_t getSelectedMask() const { return selectedMask; }
     
     // Frame control
     void setImageFrameEnabled(bool enabled, uint16_t color = ST77XX_WHITE, uint8_t thickness = 1);
     bool getImageFrameEnabled() const { return imageFrameEnabled; }
     
+    // Local playback of an ImageStore entry (CMD:PLAY, boot splash); shows the
+    // first frame now and false if there is nothing to play
+    bool play(const char* name, uint8_t mask, uint16_t loops);
+    void stopPlayback() { Playback::stop(); }
+    bool isPlaying() const { return Playback::isActive(); }
+    
 private:
     // Protocol constants
     static const unsigned long TIMEOUT_MS = 15000;         // 15 second timeout
-    static const unsigned long DISPLAY_SELECT_TIMEOUT = 3000;  // 3 second timeout for display selection
     static const unsigned long READY_TIMEOUT = 5000;       // 5 second timeout for READY response
     static const int MAX_DIMENSION = 1000;                 // Maximum bitmap dimension
     static const int PROGRESS_REPORT_INTERVAL = 10;        // Report progress every N rows
+    static const int LINE_BUFFER_PIXELS = 1280;            // Per band buffer (8 rows of 160 pixels)
+    static const size_t RX_CHUNK_BYTES = 512;              // Bytes drained from the ring per pass
+    static const size_t COMMAND_LINE_MAX = 512;            // Longest text line (without '\n')
+    static const int MAX_STORE_FRAMES = ImageCache::MAX_ENTRIES; // Cached ids per STORE_SAVE / STORE_ADD
+    static const int MAX_PLAYLIST_ITEMS = COMMAND_LINE_MAX / 2;  // Names per STORE_PLAYLIST (each "x," at least)
     
     DisplayManager& displayManager;
-    Stream& serialPort;
+    BufferedSerial& serialPort;
     
     // State
     ProtocolState currentState;
-    DisplayInstance* activeDisplay;
+    DisplayInstance* activeDisplay;   // First selected display (CMD: target)
+    uint8_t selectedMask;             // All selected displays (bit = index)
     
     // Bitmap reception state
     int bitmapWidth;
     int bitmapHeight;
     int currentRow;
     int currentCol;
-    int offsetX;
-    int offsetY;
+    bool partialUpdate;    // Transfer carries an explicit origin (SIZE:w,h,x,y)
+    uint8_t pixelEncoding; // BinaryEncoding of the current pixel payload
+    PixelDecoder decoder;  // Used for compressed encodings
+    uint32_t pixelBytesRemaining;     // Pixel payload bytes still expected
+    int pendingPixelByte;             // High byte of a split pixel, or -1
+    const char* pixelError;           // Set once decoding failed: drain the rest, then report it
+    
+    // Credit flow control (BIN_FLAG_CREDIT / ";CREDIT")
+    bool creditEnabled;
+    uint8_t creditSequence;           // Sequence echoed in credit messages
+    uint32_t creditTotal;             // Payload bytes of the transfer
+    uint32_t creditEdge;              // Last advertised window edge
+    
+    // Displays receiving the current transfer
+    DisplayTarget targets[DisplayManager::MAX_DISPLAYS];
+    uint8_t targetCount;
+    
+    // Row band streaming: full bitmap rows, fanned out to every target
+    // Buffers hold pixels in wire (big-endian) byte order so they can be DMA'd as-is
+    uint16_t lineBuffers[2][LINE_BUFFER_PIXELS];
+    uint16_t* lineBuffer;  // Buffer currently being filled
+    int visibleRowStart;   // Union of target visible rows (end exclusive)
+    int visibleRowEnd;
+    int bandCapacity;      // Rows that fit in lineBuffer
+    int bandStartRow;      // Bitmap row of first buffered row
+    int bandRowCount;      // Rows currently buffered
+    DisplayInstance* vsyncDisplay; // TE edge the first band waits for (BIN_FLAG_VSYNC), or nullptr
+    
+    // Snapshot of the image being received (full images only), or nullptr
+    uint16_t* capturePixels;
+    
+    // Image cache entry being stored (CACHE=<id>, BIN_OP_CACHE_STORE) or shown
+    int cacheId;           // -1 until known
+    uint8_t* cacheWrite;   // Next byte of the entry being filled, or nullptr
+    
+    // Overlay text (CMD:TEXT, BIN_OP_TEXT)
+    GlyphText glyphText;
+    uint8_t textPayload[sizeof(BinaryTextParams) + GlyphText::MAX_LENGTH]; // BIN_OP_TEXT payload being received
+    
+    // Tile command list (CMD:TILES, BIN_OP_TILES) and its resolved cache pixels
+    BinaryTileDraw tileList[BINARY_MAX_TILE_DRAWS];
+    TileDraw tileDraws[BINARY_MAX_TILE_DRAWS];
+    
+    // Text line being assembled (handlers run once a complete line is buffered)
+    char commandLine[COMMAND_LINE_MAX + 1];
+    size_t commandLength;             // Bytes received for the current line (may exceed the buffer)
+    
+    // Stream mode (BIN_OP_STREAM_*), fixed by STREAM_BEGIN
+    bool streamActive;
+    DisplayTarget streamTargets[DisplayManager::MAX_DISPLAYS]; // Stream origin per display
+    uint8_t streamTargetCount;
+    uint16_t streamWidth;
+    uint16_t streamHeight;
+    uint8_t streamEncoding;
+    BinaryStreamParams streamParams;  // Parameters of the open (or last) stream
+    BinaryStreamParams pendingStreamParams; // STREAM_BEGIN payload being received
+    uint32_t streamIntervalMicros;    // Frame slot length, 0 = unpaced
+    DisplayInstance* streamVsyncDisplay; // Display the frames are synced to, or nullptr
+    unsigned long streamDueMicros;    // micros() at which the next frame slot starts
+    unsigned long streamStartMillis;
+    unsigned long streamLastFrameMillis;
+    uint32_t streamFramesShown;
+    uint32_t streamFramesDropped;
+    
+    // Binary frame reception
+    BinaryFrameHeader binaryHeader;
+    uint8_t binaryHeaderBytes;        // Header bytes received so far
+    uint32_t binaryPayloadRemaining;  // Payload bytes still expected
+    uint32_t binaryCrc;               // Running CRC over header and payload
+    bool binaryDiscard;               // Drain payload without drawing
+    uint8_t binaryStatus;             // Status to report once payload is drained
+    ProtocolState binaryReturnState;  // State to resume after the frame
+    
+    // Batch frame (BIN_OP_BATCH): each operation runs as its bytes arrive
+    BinaryBatchOp batchOp;            // Operation being received
+    uint8_t batchOpBytes;             // Bytes of batchOp received so far
+    uint32_t batchOperandRemaining;   // Operand bytes of batchOp still expected
+    uint32_t batchOpsDone;            // Operations completed (ack value)
+    
+    // Receive statistics
+    unsigned long transferStartMicros;
+    uint32_t transferBytes;
+    uint32_t lastTransferBytes;
+    unsigned long lastTransferMicros;
+    unsigned long statsIntervalStart;   // millis() of previous CMD:STATS
+    uint32_t statsIntervalBytes;        // Received-byte counter at previous CMD:STATS
+    uint32_t commandCount;              // CMD: lines dispatched
+    unsigned long lastCommandMicros;    // Parse + handler + reply of the last CMD: line
+    unsigned long maxCommandMicros;
+    uint32_t heapPeak;                  // Highest heap use seen after a command (sampleHeap)
     
     // Timeout tracking
     unsigned long lastActivity;
@@ -94,27 +296,183 @@ private:
     uint16_t imageFrameColor;
     uint8_t imageFrameThickness;
     
+    // CMD:FIT_ON - centred images are turned and scaled to each display
+    bool fitImages;
+    
     // Calibration usable area adjustments (relative to config values)
     int8_t usableAreaAdjustTop;
     int8_t usableAreaAdjustBottom;
     int8_t usableAreaAdjustLeft;
     int8_t usableAreaAdjustRight;
     
-    // Protocol handlers
+    // Protocol handlers (text lines are parsed in place in commandLine)
     void handleDisplaySelect();
-    void handleMenuCommand(const String& command);
+    void handleMenuCommand(char* command);
     void handleStart();
     void handleSize();
     void handleDataReception();
     void handleEnd();
     void handleComplete();
     
+    // Incremental line input: true once commandLine holds a complete line
+    bool readCommandLine();
+    
+    // CMD: dispatch table (MENU_COMMANDS, sorted by name). Handlers get the text
+    // after "NAME:" (writable, empty if there was none)
+    enum MenuArguments { MENU_ARGS_NONE, MENU_ARGS_REQUIRED, MENU_ARGS_OPTIONAL };
+    struct MenuCommand {
+        const char* name;
+        uint8_t arguments;   // MenuArguments
+        void (SerialProtocol::*handler)(char* args);
+    };
+    static const MenuCommand MENU_COMMANDS[];
+    static const uint8_t MENU_COMMAND_COUNT;
+    static const MenuCommand* findMenuCommand(const char* name);
+    
+    // CMD: handlers
+    void cmdReset(char* args);
+    void cmdList(char* args);
+    void cmdInfo(char* args);
+    void cmdTest(char* args);
+    void cmdTestAll(char* args);
+    void cmdFrameOn(char* args);
+    void cmdFrameOff(char* args);
+    void cmdFitOn(char* args);
+    void cmdFitOff(char* args);
+    void cmdFrameColor(char* args);
+    void cmdFrameThickness(char* args);
+    void cmdAdjustTop(char* args);
+    void cmdAdjustBottom(char* args);
+    void cmdAdjustLeft(char* args);
+    void cmdAdjustRight(char* args);
+    void cmdCalibrate(char* args);
+    void cmdUpdateConfig(char* args);
+    void cmdOrientation(char* args);
+    void cmdScrollArea(char* args);
+    void cmdScroll(char* args);
+    void cmdScrollOff(char* args);
+    void cmdPalette(char* args);
+    void cmdStats(char* args);
+    void cmdStatsReset(char* args);
+    void cmdProfile(char* args);
+    void cmdStreamStats(char* args);
+    void cmdSnapshot(char* args);
+    void cmdSnapshotInfo(char* args);
+    void cmdSnapshotClear(char* args);
+    void cmdCacheShow(char* args);
+    void cmdText(char* args);
+    void cmdTiles(char* args);
+    void cmdCacheList(char* args);
+    void cmdCacheDrop(char* args);
+    void cmdCacheClear(char* args);
+    void cmdStoreSave(char* args);
+    void cmdStoreAdd(char* args);
+    void cmdStorePlaylist(char* args);
+    void cmdStoreList(char* args);
+    void cmdStoreInfo(char* args);
+    void cmdStoreDelete(char* args);
+    void cmdStoreFormat(char* args);
+    void cmdPlay(char* args);
+    void cmdStop(char* args);
+    void cmdHelp(char* args);
+    
+    // Binary frame handlers
+    bool isBinaryFrameStart();
+    void handleBinaryHeader();
+    void handleBinaryPayload();
+    uint8_t beginBinaryFrame();
+    uint8_t resolveBinaryDisplays();
+    uint8_t selectBinaryDisplays(uint8_t mask);
+    uint8_t beginCacheStore();
+    uint8_t beginBlit(int x, int y, int width, int height, uint8_t encoding, uint8_t flags, uint32_t length);
+    void addBinaryTargets(int x, int y, int width, int height, uint8_t flags, bool fit);
+    void finishBinaryFrame();
+    void sendBinaryAck(uint8_t opcode, uint8_t sequence, uint8_t status, uint32_t value);
+    
+    // Batch frames
+    void consumeBatchBytes(const uint8_t* data, size_t length);
+    uint8_t beginBatchOp();
+    uint8_t finishBatchOp();
+    
+    // Stream mode
+    uint8_t beginStreamOpen();
+    uint8_t beginStreamFrame();
+    uint8_t openStream();
+    bool scheduleStreamFrame();
+    uint32_t streamWaitMicros() const;
+    DisplayInstance* findVsyncDisplay() const;   // First target with a TE line
+    void sendStreamStats();
+    
+    // Credit flow control
+    void beginCredit(bool enabled, uint8_t sequence, uint32_t total);
+    void updateCredit();
+    
+    // Statistics
+    void beginTransferStats();
+    void endTransferStats();
+    void sendStats();
+    void resetStats();
+    void sendProfile();
+    void sampleHeap();
+    
+    // On-device benchmark (CMD:BENCH)
+    void runBenchmark(char* args);
+    void benchmarkKernel(uint8_t kernel, DisplayInstance* display, int width, int height, uint16_t frames);
+    
+    // Display selection
+    void selectDisplays(uint8_t mask);
+    
+    // Snapshot capture / restore
+    void beginSnapshotCapture(bool fitted);
+    void showSnapshot(DisplayInstance* display);
+    
+    // Hardware scrolling
+    void fillScrollLines(DisplayInstance* display, int first, int count);
+    
+    // Image cache
+    void storeCacheBytes(const uint8_t* data, size_t length);
+    uint8_t showCachedImage(uint8_t id, uint8_t mask, bool center, bool fit, bool clear, int x, int y);
+    
+    // Replay of a stored payload through the reception path (cache, image store)
+    void beginReplay(int width, int height, uint8_t mask, bool center, bool fit, bool clear, int x, int y);
+    void finishReplay();
+    
+    // Image store: cached frames to write (checked before any is), replies
+    int parseStoreFrames(char* ids, long* frameIds, const StoredImage* entry);
+    void sendStoreError(StoreStatus status);
+    
+    // PlaybackSink (stored frames, replayed like a cached image)
+    void beginFrame(const StoredImage& item, uint16_t frame, uint8_t mask) override;
+    void frameBytes(const uint8_t* data, size_t length) override;
+    bool finishFrame(bool readOk) override;
+    
+    // Overlay text
+    uint8_t drawText(uint8_t mask, int x, int y, const BinaryTextParams& params, const char* text, size_t length);
+    
+    // Tile compositing (tileList); value = strips drawn, or the id that failed
+    uint8_t drawTiles(uint8_t mask, int x, int y, uint8_t count, bool clear, uint32_t& value);
+    
     // Validation
-    bool validateDimensions(int width, int height);
-    bool calculateOffsets(int bmpWidth, int bmpHeight, int& offsetX, int& offsetY);
+    bool validateDimensions(DisplayInstance* display, int width, int height, bool fitUsableArea = true);
+    bool calculateOffsets(DisplayInstance* display, int bmpWidth, int bmpHeight, int& offsetX, int& offsetY);
+    
+    // Row band streaming
+    void addTarget(DisplayInstance* display, int originX, int originY);
+    void addCenteredTarget(DisplayInstance* display, int width, int height, bool fit);
+    void prepareRowClip();
+    void consumePixelBytes(const uint8_t* data, size_t length);
+    void acceptPixel(uint16_t wirePixel);
+    void acceptRun(uint16_t wirePixel, uint32_t count);
+    bool parseSizeOptions(char* options, uint8_t& encoding, uint32_t& length, int& cacheEntry, bool& credit);
+    
+    // PixelSink (compressed payloads)
+    void emitPixel(uint16_t wirePixel) override { acceptPixel(wirePixel); }
+    void emitRun(uint16_t wirePixel, uint32_t count) override { acceptRun(wirePixel, count); }
+    void flushBand();
+    void finishBands();
     
     // Error handling
-    void sendError(const String& message);
+    void sendError(const char* message, const char* detail = nullptr);
 };
 
 #endif // SERIAL_PROTOCOL_H
@@ -0,0 +1,136 @@
+/*
+ * Telemetry.cpp
+ * Cycle-counter stage timing and pixel counters
+ */
+
+#include "Telemetry.h"
+
+#ifdef ST7735_TELEMETRY
+
+namespace {
+
+const uint32_t CYCLES_PER_US = F_CPU / 1000000;
+
+const char* const STAGE_NAMES[TELEMETRY_STAGE_COUNT] = {
+    "RX", "PARSE", "PAYLOAD", "CLIP", "SPI", "SPI_WAIT", "FILL"
+};
+
+const char* const COUNTER_NAMES[TELEMETRY_COUNTER_COUNT] = {
+    "PixelsWritten", "PixelsFilled", "PixelsClipped", "Timeouts"
+};
+
+const char* const BUCKET_LABELS[Telemetry::HISTOGRAM_BUCKETS] = {
+    "<1", "<4", "<16", "<64", "<256", "<1k", "<4k", ">=4k"
+};
+
+Telemetry::StageStats stages[TELEMETRY_STAGE_COUNT];
+uint32_t counters[TELEMETRY_COUNTER_COUNT];
+
+uint32_t toMicros(uint64_t cycles) {
+    return (uint32_t)(cycles / CYCLES_PER_US);
+}
+
+// Bucket i holds durations below 4^i microseconds
+uint8_t bucketFor(uint32_t cycles) {
+    uint32_t limit = CYCLES_PER_US;
+    uint8_t bucket = 0;
+    while (bucket < Telemetry::HISTOGRAM_BUCKETS - 1 && cycles >= limit) {
+        limit <<= 2;
+        bucket++;
+    }
+    return bucket;
+}
+
+} // namespace
+
+namespace Telemetry {
+
+void begin() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    reset();
+}
+
+void reset() {
+    memset(stages, 0, sizeof(stages));
+    memset(counters, 0, sizeof(counters));
+    for (uint8_t i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        stages[i].minCycles = UINT32_MAX;
+    }
+}
+
+void record(TelemetryStage stage, uint32_t elapsedCycles) {
+    StageStats& s = stages[stage];
+    s.count++;
+    s.totalCycles += elapsedCycles;
+    if (elapsedCycles < s.minCycles) {
+        s.minCycles = elapsedCycles;
+    }
+    if (elapsedCycles > s.maxCycles) {
+        s.maxCycles = elapsedCycles;
+    }
+    s.histogram[bucketFor(elapsedCycles)]++;
+}
+
+void count(TelemetryCounter counter, uint32_t amount) {
+    counters[counter] += amount;
+}
+
+const StageStats& getStage(TelemetryStage stage) {
+    return stages[stage];
+}
+
+uint32_t getCounter(TelemetryCounter counter) {
+    return counters[counter];
+}
+
+const char* stageName(TelemetryStage stage) {
+    return STAGE_NAMES[stage];
+}
+
+void printSummary(Print& out) {
+    for (uint8_t i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        const StageStats& s = stages[i];
+        out.print("Stage.");
+        out.print(STAGE_NAMES[i]);
+        out.print(":n=");
+        out.print(s.count);
+        out.print(",avg=");
+        out.print(s.count ? toMicros(s.totalCycles / s.count) : 0);
+        out.print(",min=");
+        out.print(s.count ? toMicros(s.minCycles) : 0);
+        out.print(",max=");
+        out.print(toMicros(s.maxCycles));
+        out.print(",total=");
+        out.println(toMicros(s.totalCycles));
+    }
+    for (uint8_t i = 0; i < TELEMETRY_COUNTER_COUNT; i++) {
+        out.print(COUNTER_NAMES[i]);
+        out.print(":");
+        out.println(counters[i]);
+    }
+}
+
+void printProfile(Print& out) {
+    out.print("Buckets:");
+    for (uint8_t b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        out.print(b ? "," : "");
+        out.print(BUCKET_LABELS[b]);
+    }
+    out.println(" us");
+    for (uint8_t i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        out.print("Hist.");
+        out.print(STAGE_NAMES[i]);
+        out.print(":");
+        for (uint8_t b = 0; b < HISTOGRAM_BUCKETS; b++) {
+            out.print(b ? "," : "");
+            out.print(stages[i].histogram[b]);
+        }
+        out.println();
+    }
+}
+
+} // namespace Telemetry
+
+#endif // ST7735_TELEMETRY
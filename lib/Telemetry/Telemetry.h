@@ -0,0 +1,104 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+// Hot-path instrumentation read back with CMD:STATS and CMD:PROFILE.
+// Stages are timed with the Cortex-M3 DWT cycle counter (one register read at
+// each end) and kept as count / total / min / max plus a coarse histogram.
+// Everything compiles away unless the build defines ST7735_TELEMETRY
+// (see build_flags in platformio.ini): the macros below become empty
+// statements and no counters are allocated.
+//
+// Stage times are inclusive: PAYLOAD contains the CLIP, SPI and FILL work its
+// pixels cause, and SPI contains the SPI_WAIT for the previous transfer.
+
+enum TelemetryStage {
+    TELEMETRY_RX,          // Draining the USB endpoint into the ring buffer (polls that received bytes)
+    TELEMETRY_PARSE,       // Text command / header handling
+    TELEMETRY_PAYLOAD,     // Pixel and binary payload handling (decode, bands, cache copies)
+    TELEMETRY_CLIP,        // DisplayInstance::clipTarget
+    TELEMETRY_SPI,         // Address window plus pixel write or DMA start
+    TELEMETRY_SPI_WAIT,    // Waiting for the in-flight DMA transfer
+    TELEMETRY_FILL,        // Solid rectangle fills (clears, scroll lines)
+    TELEMETRY_STAGE_COUNT
+};
+
+enum TelemetryCounter {
+    TELEMETRY_PIXELS_WRITTEN,   // Pixels sent through pushPixels / pushPixelsAsync
+    TELEMETRY_PIXELS_FILLED,    // Pixels written by fills
+    TELEMETRY_PIXELS_CLIPPED,   // Image pixels falling outside a usable area
+    TELEMETRY_TIMEOUTS,         // Transfers abandoned by SerialProtocol::checkTimeout
+    TELEMETRY_COUNTER_COUNT
+};
+
+#ifdef ST7735_TELEMETRY
+
+namespace Telemetry {
+
+// Histogram buckets in microseconds: <1, <4, <16, <64, <256, <1k, <4k, >=4k
+static const uint8_t HISTOGRAM_BUCKETS = 8;
+
+struct StageStats {
+    uint32_t count;
+    uint64_t totalCycles;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t histogram[HISTOGRAM_BUCKETS];
+};
+
+// Start the DWT cycle counter and clear all stages and counters
+void begin();
+
+// Clear all stages and counters (CMD:STATS_RESET)
+void reset();
+
+static inline uint32_t cycles() { return DWT->CYCCNT; }
+
+void record(TelemetryStage stage, uint32_t elapsedCycles);
+void count(TelemetryCounter counter, uint32_t amount);
+
+const StageStats &getStage(TelemetryStage stage);
+uint32_t getCounter(TelemetryCounter counter);
+const char *stageName(TelemetryStage stage);
+
+// "Stage.<name>:n=,avg=,min=,max=,total=" lines (microseconds) and the counters
+void printSummary(Print &out);
+
+// One "Hist.<name>:" line per stage with the bucket counts
+void printProfile(Print &out);
+
+// Records the enclosing block's duration on destruction
+class Scope {
+public:
+    explicit Scope(TelemetryStage s) : stage(s), start(cycles()) {}
+    ~Scope() { record(stage, cycles() - start); }
+
+private:
+    TelemetryStage stage;
+    uint32_t start;
+};
+
+} // namespace Telemetry
+
+#define TELEMETRY_CONCAT_(a, b) a##b
+#define TELEMETRY_CONCAT(a, b) TELEMETRY_CONCAT_(a, b)
+
+#define TELEMETRY_BEGIN() Telemetry::begin()
+#define TELEMETRY_SCOPE(stage) Telemetry::Scope TELEMETRY_CONCAT(telemetryScope_, __LINE__)(stage)
+#define TELEMETRY_MARK(name) uint32_t name = Telemetry::cycles()
+#define TELEMETRY_RECORD_SINCE(stage, name) Telemetry::record(stage, Telemetry::cycles() - (name))
+#define TELEMETRY_COUNT(counter, amount) Telemetry::count(counter, amount)
+
+#else
+
+#define TELEMETRY_BEGIN() do { } while (0)
+#define TELEMETRY_SCOPE(stage) do { } while (0)
+#define TELEMETRY_MARK(name) do { } while (0)
+#define TELEMETRY_RECORD_SINCE(stage, name) do { } while (0)
+#define TELEMETRY_COUNT(counter, amount) do { } while (0)
+
+#endif // ST7735_TELEMETRY
+
+#endif // TELEMETRY_H
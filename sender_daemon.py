@@ -0,0 +1,559 @@
+#!/usr/bin/env python3
+"""
+Sender Daemon for ST7735 Displays
+Long-running owner of the Arduino Due serial port, so several local
+producer processes can draw on the panels without contending for it
+
+Clients (st7735_tools/frame_ring.py, FrameClient) connect to a Unix control
+socket and are given a shared-memory ring; they render frames straight into
+its slots. The daemon drains every ring, converts the frames to RGB565 with
+NumPy and paints them onto a per-display canvas. Updates from all clients
+are merged into a few dirty rectangles per display, trimmed to the pixels
+that differ from what the panel already shows, and sent as one binary
+BATCH frame against the firmware's credit window, so the link runs at line
+rate with one ack per batch. A frame superseded before it is sent costs
+nothing on the wire.
+
+Per-display metrics (queue depth, submit-to-ack latency, frames, bytes)
+are available from the control socket: --metrics prints them, and
+--stats-interval logs them periodically.
+
+Requirements:
+- Python 3.8+
+- pyserial: pip install pyserial
+- NumPy: pip install numpy
+
+Usage:
+    python3 sender_daemon.py [serial_port] [--device DueLCD01,DueLCD02]
+    python3 sender_daemon.py --metrics
+
+Example:
+    python3 sender_daemon.py /dev/ttyACM0 --device all --stats-interval 10
+    python3 sender_daemon.py --metrics --socket /tmp/st7735_sender.sock
+"""
+
+import sys
+import os
+import time
+import json
+import signal
+import socket
+import argparse
+import selectors
+import threading
+from collections import deque
+import serial
+import numpy as np
+
+try:
+    from st7735_tools.config_loader import find_config_files, get_config_by_device_name
+    from st7735_tools import binary_protocol
+    from st7735_tools import frame_ring
+    from st7735_tools.dirty_rects import coalesce_rects
+except ImportError:
+    print("Error: st7735_tools module not found. Run from the project directory.")
+    sys.exit(1)
+
+SERIAL_BAUDRATE = 115200
+TIMEOUT_SECONDS = 10
+STARTUP_SECONDS = 5        # Native USB open resets the Due
+POLL_SECONDS = 0.005       # Ring poll when no doorbell arrives
+LATENCY_WINDOW = 256       # Samples kept per display for the latency percentiles
+
+
+class DisplayState:
+    """Canvas, pending updates and metrics of one served display"""
+
+    def __init__(self, name, index, width, height):
+        self.name = name
+        self.index = index
+        self.width = width
+        self.height = height
+
+        # Wanted panel contents, and what the panel is known to show
+        self.canvas = np.zeros((height, width), dtype='>u2')
+        self.shown = np.zeros((height, width), dtype='>u2')
+        self.shown_valid = np.zeros((height, width), dtype=bool)
+
+        self.dirty = []            # (x, y, w, h) painted since the last batch
+        self.waiting = []          # submit times (monotonic ns) of those frames
+        self.in_flight = 0         # Frames in the batch being sent
+
+        self.frames = 0            # Frames received
+        self.unchanged = 0         # Frames that left the panel as it was (overdrawn or repeated)
+        self.batches = 0
+        self.rects_sent = 0
+        self.bytes_sent = 0
+        self.errors = 0
+        self.latencies = deque(maxlen=LATENCY_WINDOW)   # Submit to ack, ms
+        self.last_latency_ms = 0.0
+        self.max_latency_ms = 0.0
+
+    def paint(self, record):
+        """Convert a ring frame onto the canvas (clipped to the panel); False if fully off-panel"""
+        x0 = max(record.x, 0)
+        y0 = max(record.y, 0)
+        x1 = min(record.x + record.width, self.width)
+        y1 = min(record.y + record.height, self.height)
+        if x0 >= x1 or y0 >= y1:
+            return False
+        pixels = record.pixels[y0 - record.y:y1 - record.y, x0 - record.x:x1 - record.x]
+        self.canvas[y0:y1, x0:x1] = frame_ring.to_rgb565(pixels, record.pixel_format)
+        self.dirty.append((x0, y0, x1 - x0, y1 - y0))
+        self.waiting.append(record.submitted_ns)
+        self.frames += 1
+        return True
+
+    def take_updates(self, merge_slack):
+        """
+        Rectangles to send now, as (x, y, w, h, wire bytes), and their frames' submit times
+
+        Each coalesced rectangle is trimmed to the bounding box of pixels that
+        differ from the panel (or were never confirmed); the sent pixels
+        become the expected panel contents.
+        """
+        updates = []
+        for x, y, w, h in coalesce_rects(self.dirty, merge_slack=merge_slack):
+            window = (slice(y, y + h), slice(x, x + w))
+            changed = (self.canvas[window] != self.shown[window]) | ~self.shown_valid[window]
+            rows = np.flatnonzero(changed.any(axis=1))
+            if rows.size == 0:
+                continue
+            cols = np.flatnonzero(changed.any(axis=0))
+            top, bottom = y + rows[0], y + rows[-1] + 1
+            left, right = x + cols[0], x + cols[-1] + 1
+            trimmed = (slice(top, bottom), slice(left, right))
+            pixels = self.canvas[trimmed]
+            self.shown[trimmed] = pixels
+            self.shown_valid[trimmed] = True
+            updates.append((int(left), int(top), int(right - left), int(bottom - top), pixels.tobytes()))
+
+        if not updates:
+            self.unchanged += len(self.waiting)
+        waiting = self.waiting if updates else []
+        self.dirty = []
+        self.waiting = []
+        self.in_flight = len(waiting)
+        return updates, waiting
+
+    def requeue(self, updates, waiting):
+        """A batch failed: resend its rectangles whatever the panel is thought to show"""
+        for x, y, w, h, _ in updates:
+            self.shown_valid[y:y + h, x:x + w] = False
+            self.dirty.append((x, y, w, h))
+        self.waiting = waiting + self.waiting
+        self.in_flight = 0
+        self.errors += 1
+
+    def record_ack(self, waiting, rects, sent_bytes):
+        now = time.monotonic_ns()
+        for submitted in waiting:
+            latency = (now - submitted) / 1e6
+            self.latencies.append(latency)
+            self.last_latency_ms = latency
+            self.max_latency_ms = max(self.max_latency_ms, latency)
+        self.in_flight = 0
+        self.batches += 1
+        self.rects_sent += rects
+        self.bytes_sent += sent_bytes
+
+    def metrics(self, ring_depth):
+        samples = sorted(self.latencies)
+
+        def percentile(fraction):
+            return round(samples[min(len(samples) - 1, int(fraction * len(samples)))], 2) if samples else 0.0
+
+        return {
+            'index': self.index,
+            'queue_depth': ring_depth + len(self.waiting) + self.in_flight,
+            'ring_depth': ring_depth,
+            'waiting': len(self.waiting),
+            'in_flight': self.in_flight,
+            'frames': self.frames,
+            'unchanged': self.unchanged,
+            'batches': self.batches,
+            'rects_sent': self.rects_sent,
+            'bytes_sent': self.bytes_sent,
+            'errors': self.errors,
+            'latency_ms': {
+                'last': round(self.last_latency_ms, 2),
+                'p50': percentile(0.5),
+                'p95': percentile(0.95),
+                'max': round(self.max_latency_ms, 2),
+            },
+        }
+
+
+class ClientConnection:
+    """One control socket connection, and its ring once it has said hello"""
+
+    def __init__(self, sock):
+        self.sock = sock
+        self.name = None
+        self.ring = None
+        self.buffer = b''
+
+
+class SenderDaemon:
+    def __init__(self, connection, displays, socket_path, merge_slack, verbose=False):
+        self.connection = connection
+        self.displays = {state.index: state for state in displays}
+        self.socket_path = socket_path
+        self.merge_slack = merge_slack
+        self.verbose = verbose
+        self.link = binary_protocol.BinaryFrameLink(connection, ack_timeout=TIMEOUT_SECONDS,
+                                                    on_text=self._log)
+        self.selector = selectors.DefaultSelector()
+        self.clients = []
+        self.ring_serial = 0
+        self.started = time.time()
+
+        # Canvas / dirty state is shared with the sender thread
+        self.lock = threading.Lock()
+        self.work = threading.Condition(self.lock)
+        self.running = True
+
+    def _log(self, line):
+        if self.verbose:
+            print(f"Arduino: {line}")
+
+    # Control socket
+
+    def listen(self):
+        if os.path.exists(self.socket_path):
+            probe = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            try:
+                probe.connect(self.socket_path)
+                raise RuntimeError(f"Another daemon is serving {self.socket_path}")
+            except (ConnectionRefusedError, FileNotFoundError):
+                os.unlink(self.socket_path)    # Left behind by a daemon that died
+            finally:
+                probe.close()
+        server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        server.bind(self.socket_path)
+        server.listen(16)
+        server.setblocking(False)
+        self.selector.register(server, selectors.EVENT_READ, None)
+        self.server = server
+
+    def _accept(self):
+        sock, _ = self.server.accept()
+        sock.setblocking(False)
+        client = ClientConnection(sock)
+        self.clients.append(client)
+        self.selector.register(sock, selectors.EVENT_READ, client)
+
+    def _read_client(self, client):
+        try:
+            data = client.sock.recv(65536)
+        except (BlockingIOError, InterruptedError):
+            return
+        except OSError:
+            data = b''
+        if not data:
+            self._drop_client(client)
+            return
+
+        # Doorbells only wake the loop; JSON lines are control commands
+        client.buffer += data.replace(frame_ring.DOORBELL, b'')
+        while b'\n' in client.buffer:
+            line, client.buffer = client.buffer.split(b'\n', 1)
+            if line.strip():
+                self._reply(client, self._command(client, line))
+
+    def _reply(self, client, message):
+        data = json.dumps(message).encode() + b'\n'
+        client.sock.setblocking(True)
+        try:
+            client.sock.sendall(data)
+        except OSError:
+            pass
+        finally:
+            client.sock.setblocking(False)
+
+    def _command(self, client, line):
+        try:
+            request = json.loads(line)
+            command = request.get('cmd')
+        except (ValueError, AttributeError):
+            return {'error': 'Malformed request'}
+
+        if command == 'hello':
+            if client.ring is not None:
+                return {'error': 'Already attached'}
+            slots = int(request.get('slots', frame_ring.DEFAULT_SLOTS))
+            slot_bytes = int(request.get('slot_bytes', frame_ring.DEFAULT_SLOT_BYTES))
+            if not 1 <= slots <= 256 or not 1 <= slot_bytes <= 16 * 1024 * 1024:
+                return {'error': 'Ring size out of range'}
+            self.ring_serial += 1
+            name = f'st7735_{os.getpid()}_{self.ring_serial}'
+            client.ring = frame_ring.FrameRing.create(name, slots, slot_bytes)
+            client.name = str(request.get('name', name))
+            print(f"Client {client.name} attached ({slots} x {slot_bytes} byte slots)")
+            return {'ring': name, 'displays': self._display_info()}
+        if command == 'displays':
+            return {'displays': self._display_info()}
+        if command == 'metrics':
+            return self.metrics()
+        return {'error': f'Unknown command {command}'}
+
+    def _display_info(self):
+        return {state.name: {'index': state.index, 'width': state.width, 'height': state.height}
+                for state in self.displays.values()}
+
+    def _drop_client(self, client):
+        self.selector.unregister(client.sock)
+        client.sock.close()
+        with self.lock:
+            self.clients.remove(client)
+            if client.ring is not None:
+                if self._drain_ring(client.ring):  # Frames committed before it went away still count
+                    self.work.notify()
+                client.ring.close()
+        if client.ring is not None:
+            print(f"Client {client.name} detached")
+
+    # Frame intake
+
+    def _drain_ring(self, ring):
+        """Paint every committed frame of ring; True if any arrived"""
+        painted = False
+        while True:
+            record = ring.peek()
+            if record is None:
+                return painted
+            state = self.displays.get(record.display)
+            if state is not None and state.paint(record):
+                painted = True
+            record = None      # Drop the slot view before handing it back
+            ring.release()
+
+    def _drain_all(self):
+        with self.lock:
+            painted = False
+            for client in self.clients:
+                if client.ring is not None and self._drain_ring(client.ring):
+                    painted = True
+            if painted:
+                self.work.notify()
+
+    # Sending (own thread, so conversion of the next frames overlaps the transfer)
+
+    def _sender(self):
+        while True:
+            with self.lock:
+                while self.running and not any(state.dirty for state in self.displays.values()):
+                    self.work.wait()
+                if not self.running:
+                    return
+                taken = []
+                for state in self.displays.values():
+                    updates, waiting = state.take_updates(self.merge_slack)
+                    if updates:
+                        taken.append((state, updates, waiting))
+            if taken:
+                self._send_batch(taken)
+
+    def _send_batch(self, taken):
+        batch = binary_protocol.BatchBuilder()
+        sent = {}
+        for state, updates, _ in taken:
+            rects = 0
+            for x, y, w, h, pixels in updates:
+                # Operands are limited to BATCH_OPERAND_MAX bytes: split tall rectangles into strips
+                rows = max(1, binary_protocol.BATCH_OPERAND_MAX // (w * 2))
+                for top in range(0, h, rows):
+                    strip = pixels[top * w * 2:min(h, top + rows) * w * 2]
+                    batch.blit(strip, w, min(rows, h - top), x, y + top, displays=1 << state.index)
+                    rects += 1
+            sent[state.index] = (rects, sum(len(u[4]) for u in updates))
+
+        try:
+            ack = self.link.batch(batch, flags=binary_protocol.FLAG_CREDIT)
+            ok = ack.ok
+            if not ok:
+                print(f"Batch of {len(batch)} operations failed: {ack.status_name} at operation {ack.value}")
+        except (TimeoutError, RuntimeError, serial.SerialException) as e:
+            print(f"Batch of {len(batch)} operations failed: {e}")
+            ok = False
+
+        with self.lock:
+            for state, updates, waiting in taken:
+                if ok:
+                    state.record_ack(waiting, *sent[state.index])
+                else:
+                    state.requeue(updates, waiting)
+            if not ok:
+                self.work.notify()
+        if not ok:
+            time.sleep(0.1)     # Let a resetting or unplugged board settle before retrying
+
+    # Metrics
+
+    def metrics(self):
+        with self.lock:
+            ring_depth = {index: 0 for index in self.displays}
+            clients = []
+            for client in self.clients:
+                if client.ring is None:
+                    continue
+                for index, count in client.ring.pending_displays().items():
+                    if index in ring_depth:
+                        ring_depth[index] += count
+                clients.append({'name': client.name, 'ring_depth': client.ring.depth,
+                                'dropped': client.ring.dropped})
+            return {
+                'uptime_s': round(time.time() - self.started, 1),
+                'clients': clients,
+                'displays': {state.name: state.metrics(ring_depth[index])
+                             for index, state in self.displays.items()},
+            }
+
+    def print_metrics(self):
+        for name, m in self.metrics()['displays'].items():
+            latency = m['latency_ms']
+            print(f"{name}: depth {m['queue_depth']}, frames {m['frames']} "
+                  f"({m['unchanged']} unchanged), {m['batches']} batches, "
+                  f"{m['bytes_sent'] // 1024} KiB, latency p50 {latency['p50']} ms "
+                  f"p95 {latency['p95']} ms max {latency['max']} ms, errors {m['errors']}")
+
+    # Main loop
+
+    def run(self, stats_interval=0):
+        self.listen()
+        sender = threading.Thread(target=self._sender, name='sender', daemon=True)
+        sender.start()
+        print(f"Serving {', '.join(s.name for s in self.displays.values())} on {self.socket_path}")
+        next_stats = time.time() + stats_interval if stats_interval else None
+        try:
+            while True:
+                for key, _ in self.selector.select(timeout=POLL_SECONDS):
+                    if key.data is None:
+                        self._accept()
+                    else:
+                        self._read_client(key.data)
+                self._drain_all()
+                if next_stats and time.time() >= next_stats:
+                    self.print_metrics()
+                    next_stats += stats_interval
+        finally:
+            with self.lock:
+                self.running = False
+                self.work.notify()
+            sender.join(timeout=TIMEOUT_SECONDS)
+            for client in list(self.clients):
+                self._drop_client(client)
+            self.selector.unregister(self.server)
+            self.server.close()
+            try:
+                os.unlink(self.socket_path)
+            except OSError:
+                pass
+
+
+def print_daemon_metrics(socket_path):
+    """Query a running daemon (--metrics)"""
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    sock.settimeout(TIMEOUT_SECONDS)
+    try:
+        sock.connect(socket_path)
+    except OSError as e:
+        print(f"Error: no sender daemon on {socket_path} ({e})")
+        return 1
+    sock.sendall(b'{"cmd": "metrics"}\n')
+    data = b''
+    while not data.endswith(b'\n'):
+        chunk = sock.recv(65536)
+        if not chunk:
+            break
+        data += chunk
+    sock.close()
+    print(json.dumps(json.loads(data), indent=2))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Own the ST7735 serial port and draw frames from local clients",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  python3 sender_daemon.py                                    # All configured displays
+  python3 sender_daemon.py /dev/ttyACM0 --device DueLCD01     # One display
+  python3 sender_daemon.py --stats-interval 10                # Log metrics every 10 s
+  python3 sender_daemon.py --metrics                          # Query a running daemon
+
+Client side (see st7735_tools/frame_ring.py):
+  from st7735_tools.frame_ring import FrameClient
+  with FrameClient() as client:
+      client.submit('DueLCD01', frame)        # (h, w, 3) uint8 at (0, 0)
+        """
+    )
+    parser.add_argument('serial_port', nargs='?', default='/dev/ttyACM0',
+                        help='Serial port (default: /dev/ttyACM0 - Arduino Due Native USB port)')
+    parser.add_argument('--device', '-d', type=str, default='all',
+                        help='Device name(s) to serve, comma-separated, or "all" (default)')
+    parser.add_argument('--socket', type=str, default=frame_ring.DEFAULT_SOCKET,
+                        help=f'Control socket path (default: {frame_ring.DEFAULT_SOCKET})')
+    parser.add_argument('--merge-slack', type=int, default=64,
+                        help='Unchanged pixels worth re-sending to merge two rectangles (default: 64)')
+    parser.add_argument('--stats-interval', type=float, default=0,
+                        help='Print per-display metrics every N seconds (default: off)')
+    parser.add_argument('--metrics', action='store_true',
+                        help='Print the metrics of a running daemon and exit')
+    parser.add_argument('--verbose', '-v', action='store_true', help='Echo firmware output')
+    args = parser.parse_args()
+
+    if args.metrics:
+        return print_daemon_metrics(args.socket)
+
+    if args.device.lower() == 'all':
+        names = sorted(find_config_files().keys())
+    else:
+        names = [name.strip() for name in args.device.split(',') if name.strip()]
+    configs = []
+    for name in names:
+        config = get_config_by_device_name(name)
+        if not config:
+            print(f"Error: No configuration found for device '{name}'")
+            return 1
+        configs.append(config)
+    if not configs:
+        print("Error: No displays to serve")
+        return 1
+
+    try:
+        print(f"Connecting to Arduino Due on {args.serial_port}...")
+        connection = serial.Serial(args.serial_port, SERIAL_BAUDRATE, timeout=0.5,
+                                   write_timeout=TIMEOUT_SECONDS)
+    except serial.SerialException as e:
+        print(f"Error connecting to serial port: {e}")
+        return 1
+
+    try:
+        time.sleep(STARTUP_SECONDS)
+        connection.reset_input_buffer()
+        displays = []
+        for config in configs:
+            index = binary_protocol.resolve_display_index(connection, config.name)
+            if index is None:
+                print(f"Error: Display {config.name} not registered on Arduino")
+                return 1
+            displays.append(DisplayState(config.name, index, config.width, config.height))
+
+        # systemd and friends stop with SIGTERM: unwind like Ctrl+C so the socket and rings go away
+        signal.signal(signal.SIGTERM, lambda signum, frame: sys.exit(0))
+        daemon = SenderDaemon(connection, displays, args.socket, args.merge_slack, args.verbose)
+        daemon.run(args.stats_interval)
+    except RuntimeError as e:
+        print(f"Error: {e}")
+        return 1
+    except KeyboardInterrupt:
+        print("\nSender daemon stopped")
+    finally:
+        connection.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
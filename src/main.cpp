@@ -4,7 +4,8 @@
  * 
  * Features:
  * - Multi-display support (all displays initialized at startup)
- * - Test patterns shown on all displays by default
+ * - Test patterns shown on all displays by default (-DST7735_SKIP_TEST_PATTERN
+ *   boots straight to blank screens)
  * - Runtime display selection via serial protocol
  * - Unified protocol with CMD: and DISPLAY: command routing
  * - Single Native USB port (/dev/ttyACM0) for all communications
@@ -25,6 +26,11 @@
  * CS, RST, DC, BL -> Per DisplayConfig.h (from .config files)
  * SDA -> Pin 11 (MOSI)
  * SCK -> Pin 13 (SCK)
+ *
+ * Optional SPI NOR flash image store (-DST7735_IMAGE_STORE, see ImageStore.h):
+ * shares MOSI/SCK with the displays, MISO -> SPI header MISO,
+ * CS -> IMAGE_STORE_CS (pin 4 by default). An entry named SPLASH replaces
+ * the boot test patterns
  */
 
 #include <Arduino.h>
@@ -32,9 +38,18 @@
 #include "DisplayConfig.h"
 #include "DisplayManager.h"
 #include "SerialProtocol.h"
+#include "BufferedSerial.h"
+#include "ImageStore.h"
+#include "Telemetry.h"
+
+#ifdef ST7735_IMAGE_STORE
+static_assert(!usesDisplayPin(DISPLAY_CONFIGS, NUM_DISPLAYS, IMAGE_STORE_CS),
+              "IMAGE_STORE_CS is wired to a display");
+#endif
 
 // Global managers
 DisplayManager displayManager;
+BufferedSerial usbSerial(SerialUSB);  // Statically allocated receive ring
 SerialProtocol* protocol = nullptr;
 
 void setup() {
@@ -51,6 +66,9 @@ void setup() {
   SPI.begin();
   SerialUSB.println("SPI initialized");
   
+  // Start the cycle counter behind CMD:STATS stage timings (no-op unless -DST7735_TELEMETRY)
+  TELEMETRY_BEGIN();
+  
   // Register all displays from config
   initializeDisplayRegistry(displayManager);
   SerialUSB.print("Registered ");
@@ -68,13 +86,38 @@ void setup() {
     SerialUSB.println("⚠ Some displays failed to initialize");
   }
   
-  // Show test patterns on all displays
-  SerialUSB.println("\nDisplaying test patterns on all screens...");
-  displayManager.showAllTestPatterns();
-  SerialUSB.println("✓ Test patterns displayed");
+  // Look for the flash image store once the panels are deselected (no-op
+  // unless -DST7735_IMAGE_STORE)
+  StoredImage splash;
+  bool showSplash = false;
+  if (ImageStore::begin()) {
+    SerialUSB.print("✓ Image store: ");
+    SerialUSB.print(ImageStore::getCount());
+    SerialUSB.println(" entries");
+    showSplash = ImageStore::find(IMAGE_STORE_SPLASH_NAME, splash);
+  }
   
-  // Initialize protocol handler with SerialUSB
-  protocol = new SerialProtocol(displayManager, SerialUSB);
+  if (showSplash) {
+    SerialUSB.println("✓ Playing " IMAGE_STORE_SPLASH_NAME " from the image store");
+  } else {
+#ifdef ST7735_SKIP_TEST_PATTERN
+    // Fast boot: blank screens only (CMD:TEST_ALL still draws the patterns)
+    displayManager.clearAll();
+    SerialUSB.println("✓ Displays cleared (test patterns skipped)");
+#else
+    // Show test patterns on all displays
+    SerialUSB.println("\nDisplaying test patterns on all screens...");
+    displayManager.showAllTestPatterns();
+    SerialUSB.println("✓ Test patterns displayed");
+#endif
+  }
+  
+  // Initialize protocol handler with ring-buffered SerialUSB
+  protocol = new SerialProtocol(displayManager, usbSerial);
+  if (showSplash) {
+    // Further frames of a splash sequence play from loop() until the host takes over
+    protocol->play(IMAGE_STORE_SPLASH_NAME, displayManager.resolveDisplayMask("ALL"), 1);
+  }
   
   SerialUSB.println("\n===========================================");
   SerialUSB.println("System ready!");
@@ -90,12 +133,17 @@ void setup() {
 }
 
 void loop() {
+  // Drain the USB endpoint into the ring before parsing
+  usbSerial.poll();
+  
   // Protocol processing handles all commands (CMD: and DISPLAY:)
   if (protocol) {
     protocol->process();
     protocol->checkTimeout();
   }
   
-  // Small delay to prevent overwhelming the processor
-  delay(1);
+  // Small delay only while idle - never sleep during a transfer
+  if (!protocol || (!protocol->isTransferActive() && !usbSerial.available())) {
+    delay(1);
+  }
 }
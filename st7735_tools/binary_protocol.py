@@ -0,0 +1,540 @@
+"""
+ST7735 Binary Frame Protocol
+Host-side framing for the firmware's binary bitmap protocol (see
+lib/SerialProtocol/BinaryFrame.h for the authoritative layout)
+
+A frame is a 24-byte little-endian header followed by the payload. The
+firmware answers every frame with an 8-byte ack. BinaryFrameLink enforces a
+strict one-frame-in-flight state machine so acks are never mismatched.
+
+With credit flow control (FLAG_CREDIT, or ";CREDIT" on a text SIZE line) the
+firmware also sends OP_CREDIT messages in the ack format whose value is the
+number of payload bytes the host may have sent so far; stream_payload()
+writes up to that window instead of pacing with sleeps.
+
+Stream mode (OP_STREAM_BEGIN / OP_STREAM_FRAME / OP_STREAM_END) fixes the
+displays, window and encoding once and then sends one frame (or delta
+region) per packet. With a target FPS each frame ack carries the wait until
+the next frame slot, which stream_frame() sleeps out before the next send.
+FLAG_VSYNC on stream_begin() (or blit()) starts each frame on the panel's
+tearing-effect edge when its TE pin is wired; the slots then follow the
+panel refresh, so sleeping out the ack keeps the sender locked to it.
+
+OP_TEXT draws a line of text on the device from a glyph atlas (the built-in
+5x7 font or one stored with atlas_store(), see glyph_atlas.py), so labels
+update without uploading pixels.
+
+OP_TILES composites tiles stored once with cache_store() (raw RGB565) from
+a list of (id, x, y) placements, so a dashboard refresh is a few bytes per
+tile instead of its pixels.
+
+OP_BATCH carries a list of select / fill / clear / blit / cache-show / text /
+tile operations, each optionally aimed at other displays, that the firmware
+runs in order with one ack. Build one with BatchBuilder and send it with
+BinaryFrameLink.batch().
+"""
+
+import struct
+import time
+import zlib
+from enum import Enum
+from typing import Optional, Tuple
+
+# Sync bytes (outside the ASCII range used by text commands)
+SYNC_BYTE = 0xA5
+ACK_SYNC_BYTE = 0xA6
+
+# Display id selecting the firmware's currently active display
+ACTIVE_DISPLAY = 0xFF
+
+# Opcodes
+OP_PING = 0x00
+OP_BLIT = 0x01
+OP_CACHE_STORE = 0x02   # payload = [cache id][encoded image], not drawn
+OP_CACHE_SHOW = 0x03    # payload = [cache id], drawn like a BLIT
+OP_PALETTE = 0x04       # payload = [count][count x RGB565 big-endian], session palette
+OP_CREDIT = 0x05        # firmware -> host: value = payload bytes the host may have sent
+OP_STREAM_BEGIN = 0x06   # payload = STREAM_PARAMS_FORMAT, header = stream window and encoding
+OP_STREAM_FRAME = 0x07   # payload = one encoded frame; width/height 0 = whole window
+OP_STREAM_END = 0x08     # ack value = frames drawn
+OP_TEXT = 0x09           # payload = TEXT_PARAMS_FORMAT + text, ack value = (width << 16) | height
+OP_TILES = 0x0A          # payload = TILE_DRAW_FORMAT entries, ack value = strips (or failing id)
+OP_BATCH = 0x0B          # payload = BATCH_OP_FORMAT headers + operands, ack value = operations done
+
+# BIN_OP_BATCH operations
+BATCH_SELECT = 0x00      # select the operation's displays for what follows
+BATCH_FILL = 0x01        # solid width x height window at x/y
+BATCH_CLEAR = 0x02       # whole screen in one colour
+BATCH_BLIT = 0x03        # operand = OP_BLIT payload
+BATCH_CACHE_SHOW = 0x04  # operand = [cache id]
+BATCH_TEXT = 0x05        # operand = OP_TEXT payload
+BATCH_TILES = 0x06       # operand = OP_TILES payload
+
+# Flags
+FLAG_CENTER = 0x01
+FLAG_CLEAR = 0x02
+FLAG_DISPLAY_MASK = 0x04   # display_id is a bitmask (bit i = display index i)
+FLAG_CREDIT = 0x08         # firmware sends OP_CREDIT window updates during the payload
+FLAG_FIT = 0x10            # centre, turned and scaled to each display's usable area
+FLAG_VSYNC = 0x20          # start each frame on the panel's tearing-effect (vsync) edge
+
+# Encodings
+ENC_RGB565 = 0x00
+ENC_RLE = 0x01
+ENC_QOI = 0x02
+ENC_INDEXED1 = 0x03
+ENC_INDEXED2 = 0x04
+ENC_INDEXED4 = 0x05
+ENC_INDEXED8 = 0x06
+ENC_RGB888 = 0x07          # R, G, B bytes per pixel, reduced to RGB565 by the firmware
+ENC_GLYPH_ATLAS = 0x10     # OP_CACHE_STORE only: glyph atlas for OP_TEXT
+ENC_DITHER_ORDERED = 0x20  # or'd into ENC_RGB888: 4x4 ordered dither on the device
+ENC_DITHER_DIFFUSE = 0x40  # or'd into ENC_RGB888: Floyd-Steinberg dither on the device
+ENC_DITHER_MASK = 0x60
+ENC_PALETTE = 0x80         # or'd into an indexed encoding: payload starts with a palette
+
+# Ack status codes
+STATUS_OK = 0x00
+STATUS_CRC_ERROR = 0x01
+STATUS_BAD_HEADER = 0x02
+STATUS_NO_DISPLAY = 0x03
+STATUS_UNSUPPORTED = 0x04
+STATUS_TIMEOUT = 0x05
+STATUS_DECODE_ERROR = 0x06
+STATUS_CACHE_MISS = 0x07
+STATUS_CACHE_FULL = 0x08
+STATUS_DROPPED = 0x09      # stream frame arrived intact but was skipped to catch up
+STATUS_NO_STREAM = 0x0A
+
+# Text flags (BinaryTextFlags)
+TEXT_FLAG_OPAQUE = 0x01    # fill the text box with the background colour
+
+# Atlas id of the firmware's built-in 5x7 font
+BUILTIN_ATLAS = 0xFF
+
+# Stream drop policies (BinaryStreamDrop)
+STREAM_DROP_NONE = 0x00
+STREAM_DROP_LATE = 0x01    # skip frames that arrive more than one slot late
+
+# Host-assignable cache ids (255 holds the firmware's snapshot)
+MAX_CACHE_ID = 254
+
+STATUS_NAMES = {
+    STATUS_OK: 'OK',
+    STATUS_CRC_ERROR: 'CRC_ERROR',
+    STATUS_BAD_HEADER: 'BAD_HEADER',
+    STATUS_NO_DISPLAY: 'NO_DISPLAY',
+    STATUS_UNSUPPORTED: 'UNSUPPORTED',
+    STATUS_TIMEOUT: 'TIMEOUT',
+    STATUS_DECODE_ERROR: 'DECODE_ERROR',
+    STATUS_CACHE_MISS: 'CACHE_MISS',
+    STATUS_CACHE_FULL: 'CACHE_FULL',
+    STATUS_DROPPED: 'DROPPED',
+    STATUS_NO_STREAM: 'NO_STREAM',
+}
+
+# struct layouts (must match BinaryFrameHeader / BinaryAck)
+HEADER_FORMAT = '<BBBBhhHHBBHII'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)   # 24
+HEADER_CRC_SPAN = HEADER_SIZE - 4              # bytes covered before crc32
+ACK_FORMAT = '<BBBBI'
+ACK_SIZE = struct.calcsize(ACK_FORMAT)         # 8
+STREAM_PARAMS_FORMAT = '<HBB'                  # BinaryStreamParams: target fps, drop policy, reserved
+TEXT_PARAMS_FORMAT = '<HHBBBB'                 # BinaryTextParams: fg, bg, atlas, flags, scale, reserved
+TEXT_MAX_LENGTH = 128
+TEXT_MAX_SCALE = 8
+TILE_DRAW_FORMAT = '<hhBB'                     # BinaryTileDraw: x, y offset, cache id, reserved
+MAX_TILE_DRAWS = 64
+BATCH_OP_FORMAT = '<BBBBhhHHHH'                # BinaryBatchOp: op, displays, encoding, flags, x, y,
+                                               # width, height, colour, operand length
+BATCH_OPERAND_MAX = 0xFFFF
+
+# Largest single write while streaming against credits
+STREAM_CHUNK_BYTES = 4096
+
+
+def build_frame(opcode: int, payload: bytes = b'', display_id: int = ACTIVE_DISPLAY,
+                sequence: int = 0, x: int = 0, y: int = 0, width: int = 0, height: int = 0,
+                encoding: int = ENC_RGB565, flags: int = 0) -> bytes:
+    """
+    Build a complete frame (header + payload)
+
+    Returns:
+        bytes: Frame ready to write to the serial port
+    """
+    header = struct.pack(HEADER_FORMAT, SYNC_BYTE, opcode, display_id, sequence & 0xFF,
+                         x, y, width, height, encoding, flags, 0, len(payload), 0)
+    crc = zlib.crc32(header[:HEADER_CRC_SPAN])
+    crc = zlib.crc32(payload, crc)
+    return header[:HEADER_CRC_SPAN] + struct.pack('<I', crc) + payload
+
+
+class LinkState(Enum):
+    """Sender-side frame state"""
+    IDLE = 'idle'
+    AWAITING_ACK = 'awaiting_ack'
+
+
+class BinaryAck:
+    """Parsed acknowledgement frame"""
+
+    def __init__(self, opcode: int, sequence: int, status: int, value: int):
+        self.opcode = opcode
+        self.sequence = sequence
+        self.status = status
+        self.value = value
+
+    @property
+    def ok(self) -> bool:
+        return self.status == STATUS_OK
+
+    @property
+    def status_name(self) -> str:
+        return STATUS_NAMES.get(self.status, f'0x{self.status:02X}')
+
+    def __repr__(self):
+        return (f"BinaryAck(opcode=0x{self.opcode:02X}, seq={self.sequence}, "
+                f"status={self.status_name}, value={self.value})")
+
+
+class BinaryFrameLink:
+    """
+    Strict sender state machine for the binary protocol
+
+    IDLE --send_frame()--> AWAITING_ACK --ack / timeout--> IDLE
+
+    Only one frame may be in flight. Text lines that arrive while waiting
+    for an ack (e.g. debug output) are skipped and passed to on_text.
+    """
+
+    def __init__(self, connection, ack_timeout: float = 5.0, on_text=None):
+        self.connection = connection
+        self.ack_timeout = ack_timeout
+        self.on_text = on_text
+        self.state = LinkState.IDLE
+        self.sequence = 0
+        self._pending: Optional[Tuple[int, int]] = None  # (opcode, sequence)
+        self._text = bytearray()
+        self._next_frame_at = 0.0  # time.time() of the next stream frame slot
+
+    def send_frame(self, opcode: int, payload: bytes = b'', **fields) -> BinaryAck:
+        """
+        Send one frame and block until its ack arrives (raises on timeout)
+
+        With FLAG_CREDIT in flags the payload is streamed against the
+        firmware's credit window instead of being written in one go.
+        """
+        if self.state is not LinkState.IDLE:
+            raise RuntimeError(f"Cannot send frame in state {self.state.value}")
+
+        sequence = self.sequence
+        self.sequence = (self.sequence + 1) & 0xFF
+        frame = build_frame(opcode, payload, sequence=sequence, **fields)
+        credit = bool(fields.get('flags', 0) & FLAG_CREDIT) and len(payload) > 0
+
+        self._pending = (opcode, sequence)
+        self.state = LinkState.AWAITING_ACK
+        try:
+            if credit:
+                self.connection.write(frame[:HEADER_SIZE])
+                self.connection.flush()
+                early_ack = self.stream_payload(payload, sequence, opcode=opcode)
+                if early_ack:
+                    return early_ack
+            else:
+                self.connection.write(frame)
+                self.connection.flush()
+            return self._wait_for_ack()
+        finally:
+            self._pending = None
+            self.state = LinkState.IDLE
+
+    def stream_payload(self, payload: bytes, sequence: int = 0,
+                       opcode: Optional[int] = None) -> Optional[BinaryAck]:
+        """
+        Write payload as fast as the firmware's OP_CREDIT window allows
+
+        Args:
+            payload: Bytes to send (text transfers: the pixel data after READY)
+            sequence: Sequence the credits carry (0 for text transfers)
+            opcode: Frame opcode whose early ack (e.g. a rejected header) ends the stream
+
+        Returns:
+            The frame's ack if the firmware answered before the payload was
+            sent, otherwise None once everything has been written and the
+            final credit (covering the whole payload) has been read
+
+        Raises:
+            TimeoutError: if no credit arrives within ack_timeout
+        """
+        sent = 0
+        window = 0
+        while sent < len(payload) or window < len(payload):
+            if sent < window:
+                end = min(window, sent + STREAM_CHUNK_BYTES, len(payload))
+                self.connection.write(payload[sent:end])
+                sent = end
+                continue
+            self.connection.flush()
+
+            message = self._read_message(time.time() + self.ack_timeout)
+            if message is None:
+                raise TimeoutError(f"No credit after {sent}/{len(payload)} payload bytes")
+            if message.opcode == OP_CREDIT and message.sequence == sequence:
+                window = max(window, message.value)
+            elif opcode is not None and (message.opcode, message.sequence) == (opcode, sequence):
+                return message
+        self.connection.flush()
+        return None
+
+    def ping(self) -> BinaryAck:
+        return self.send_frame(OP_PING)
+
+    def blit(self, pixels: bytes, width: int, height: int, x: int = 0, y: int = 0,
+             display_id: int = ACTIVE_DISPLAY, flags: int = 0,
+             encoding: int = ENC_RGB565) -> BinaryAck:
+        """Send an RGB565 (big-endian) pixel block"""
+        return self.send_frame(OP_BLIT, pixels, display_id=display_id, x=x, y=y,
+                               width=width, height=height, encoding=encoding, flags=flags)
+
+    def cache_store(self, cache_id: int, pixels: bytes, width: int, height: int,
+                    encoding: int = ENC_RGB565) -> BinaryAck:
+        """Store an encoded image in the firmware's image cache without drawing it"""
+        if not 0 <= cache_id <= MAX_CACHE_ID:
+            raise ValueError(f"Cache id must be 0-{MAX_CACHE_ID}")
+        return self.send_frame(OP_CACHE_STORE, bytes([cache_id]) + pixels,
+                               width=width, height=height, encoding=encoding)
+
+    def cache_show(self, cache_id: int, x: int = 0, y: int = 0,
+                   display_id: int = ACTIVE_DISPLAY, flags: int = 0) -> BinaryAck:
+        """Draw a cached image (STATUS_CACHE_MISS if it has been evicted)"""
+        if not 0 <= cache_id <= MAX_CACHE_ID:
+            raise ValueError(f"Cache id must be 0-{MAX_CACHE_ID}")
+        return self.send_frame(OP_CACHE_SHOW, bytes([cache_id]), display_id=display_id,
+                               x=x, y=y, flags=flags)
+
+    def palette(self, colors) -> BinaryAck:
+        """Load the session palette (1-256 RGB565 values) used by indexed encodings"""
+        if not 1 <= len(colors) <= 256:
+            raise ValueError("Palette must have 1-256 entries")
+        payload = bytes([len(colors) & 0xFF]) + struct.pack(f'>{len(colors)}H', *colors)
+        return self.send_frame(OP_PALETTE, payload)
+
+    def stream_begin(self, width: int, height: int, fps: int = 0, drop_late: bool = False,
+                     x: int = 0, y: int = 0, display_id: int = ACTIVE_DISPLAY, flags: int = 0,
+                     encoding: int = ENC_RGB565) -> BinaryAck:
+        """Open a stream: window, displays and encoding apply to every stream_frame()"""
+        if not 0 <= fps <= 0xFFFF:
+            raise ValueError("Target FPS must be 0-65535")
+        params = struct.pack(STREAM_PARAMS_FORMAT, fps,
+                             STREAM_DROP_LATE if drop_late else STREAM_DROP_NONE, 0)
+        self._next_frame_at = 0.0
+        return self.send_frame(OP_STREAM_BEGIN, params, display_id=display_id, x=x, y=y,
+                               width=width, height=height, encoding=encoding, flags=flags)
+
+    def stream_frame(self, payload: bytes, x: int = 0, y: int = 0, width: int = 0, height: int = 0,
+                     flags: int = FLAG_CREDIT) -> BinaryAck:
+        """
+        Send one stream frame, after waiting for the slot the previous ack announced
+
+        width/height 0 sends the whole stream window; otherwise (x, y, width,
+        height) is a delta region relative to the stream origin. A
+        STATUS_DROPPED ack means the frame arrived intact but was not drawn.
+        """
+        delay = self._next_frame_at - time.time()
+        if delay > 0:
+            time.sleep(delay)
+        ack = self.send_frame(OP_STREAM_FRAME, payload, x=x, y=y, width=width, height=height,
+                              flags=flags)
+        self._next_frame_at = time.time() + ack.value / 1e6 if ack.ok else 0.0
+        return ack
+
+    def stream_end(self) -> BinaryAck:
+        """Close the stream (ack value = frames drawn)"""
+        return self.send_frame(OP_STREAM_END)
+
+    def atlas_store(self, cache_id: int, atlas: bytes) -> BinaryAck:
+        """Store a glyph atlas (glyph_atlas.pack_atlas) for text() under cache_id"""
+        return self.cache_store(cache_id, atlas, 1, 1, encoding=ENC_GLYPH_ATLAS)
+
+    def text(self, text: str, x: int = 0, y: int = 0, foreground: int = 0xFFFF,
+             background: Optional[int] = None, scale: int = 1, atlas: int = BUILTIN_ATLAS,
+             display_id: int = ACTIVE_DISPLAY, flags: int = 0) -> BinaryAck:
+        """
+        Draw one line of text with its top-left corner at (x, y)
+
+        background None draws only the glyph pixels (transparent). The ack
+        value packs the text box size: width = value >> 16, height = value & 0xFFFF.
+        """
+        data = text.encode('latin-1', 'replace')
+        if not 1 <= len(data) <= TEXT_MAX_LENGTH:
+            raise ValueError(f"Text must be 1-{TEXT_MAX_LENGTH} characters")
+        if not 1 <= scale <= TEXT_MAX_SCALE:
+            raise ValueError(f"Scale must be 1-{TEXT_MAX_SCALE}")
+        params = struct.pack(TEXT_PARAMS_FORMAT, foreground, background or 0, atlas,
+                             TEXT_FLAG_OPAQUE if background is not None else 0, scale, 0)
+        return self.send_frame(OP_TEXT, params + data, display_id=display_id, x=x, y=y, flags=flags)
+
+    def tiles(self, draws, x: int = 0, y: int = 0, display_id: int = ACTIVE_DISPLAY,
+              flags: int = 0) -> BinaryAck:
+        """
+        Composite cached raw RGB565 tiles: draws is a sequence of (cache_id, x, y)
+
+        Placements are relative to (x, y) and drawn in order. The ack value is
+        the number of address windows used; with STATUS_CACHE_MISS or
+        STATUS_UNSUPPORTED it is the id that could not be drawn.
+        """
+        if not 1 <= len(draws) <= MAX_TILE_DRAWS:
+            raise ValueError(f"Tile list must have 1-{MAX_TILE_DRAWS} entries")
+        payload = b''.join(struct.pack(TILE_DRAW_FORMAT, tx, ty, cache_id, 0)
+                           for cache_id, tx, ty in draws)
+        return self.send_frame(OP_TILES, payload, display_id=display_id, x=x, y=y, flags=flags)
+
+    def batch(self, operations, display_id: int = ACTIVE_DISPLAY, flags: int = 0) -> BinaryAck:
+        """
+        Run a BatchBuilder (or its payload) as one frame
+
+        display_id selects the starting displays; the default keeps the
+        current selection. The ack value is the number of operations
+        completed, so on failure it is the index of the one that failed.
+        """
+        payload = operations.payload() if isinstance(operations, BatchBuilder) else bytes(operations)
+        return self.send_frame(OP_BATCH, payload, display_id=display_id, flags=flags)
+
+    def _wait_for_ack(self) -> BinaryAck:
+        deadline = time.time() + self.ack_timeout
+        while True:
+            ack = self._read_message(deadline)
+            if ack is None:
+                break
+            if (ack.opcode, ack.sequence) != self._pending:
+                # Stale ack from an earlier (timed out) frame, or a late credit
+                continue
+            return ack
+        raise TimeoutError(f"No ack for frame opcode=0x{self._pending[0]:02X} seq={self._pending[1]}")
+
+    def _read_message(self, deadline: float) -> Optional[BinaryAck]:
+        """Next ack-format message (ack or credit), skipping text; None on timeout"""
+        while time.time() < deadline:
+            byte = self.connection.read(1)
+            if not byte:
+                continue
+            if byte[0] != ACK_SYNC_BYTE:
+                self._collect_text(byte[0])
+                continue
+
+            rest = self.connection.read(ACK_SIZE - 1)
+            if len(rest) != ACK_SIZE - 1:
+                return None
+            _, opcode, sequence, status, value = struct.unpack(ACK_FORMAT, byte + rest)
+            return BinaryAck(opcode, sequence, status, value)
+        return None
+
+    def _collect_text(self, value: int):
+        if value == 0x0A:
+            line = self._text.decode('utf-8', errors='ignore').strip()
+            self._text.clear()
+            if line and self.on_text:
+                self.on_text(line)
+        elif value != 0x0D:
+            self._text.append(value)
+
+
+class BatchBuilder:
+    """
+    Operation list for BinaryFrameLink.batch()
+
+    Every method takes displays, a display index bitmask (bit i = index i)
+    that is selected before the operation runs; 0 keeps the displays already
+    selected. The selection stays in force after the batch, as with DISPLAY:.
+    """
+
+    def __init__(self):
+        self._ops = []
+
+    def __len__(self) -> int:
+        return len(self._ops)
+
+    def payload(self) -> bytes:
+        return b''.join(self._ops)
+
+    def _add(self, op: int, operand: bytes = b'', displays: int = 0, encoding: int = ENC_RGB565,
+             flags: int = 0, x: int = 0, y: int = 0, width: int = 0, height: int = 0,
+             color: int = 0) -> 'BatchBuilder':
+        if len(operand) > BATCH_OPERAND_MAX:
+            raise ValueError(f"Batch operand is {len(operand)} bytes (max {BATCH_OPERAND_MAX}); "
+                             "send large images as separate BLIT frames")
+        self._ops.append(struct.pack(BATCH_OP_FORMAT, op, displays & 0xFF, encoding, flags,
+                                     x, y, width, height, color & 0xFFFF, len(operand)) + operand)
+        return self
+
+    def select(self, displays: int) -> 'BatchBuilder':
+        return self._add(BATCH_SELECT, displays=displays)
+
+    def fill(self, x: int, y: int, width: int, height: int, color: int,
+             displays: int = 0) -> 'BatchBuilder':
+        """Solid rectangle (RGB565 colour), clipped to the frame bounds"""
+        return self._add(BATCH_FILL, displays=displays, x=x, y=y, width=width, height=height, color=color)
+
+    def clear(self, color: int = 0x0000, displays: int = 0) -> 'BatchBuilder':
+        return self._add(BATCH_CLEAR, displays=displays, color=color)
+
+    def blit(self, pixels: bytes, width: int, height: int, x: int = 0, y: int = 0,
+             encoding: int = ENC_RGB565, flags: int = 0, displays: int = 0) -> 'BatchBuilder':
+        """Pixel payload exactly as for BinaryFrameLink.blit()"""
+        return self._add(BATCH_BLIT, bytes(pixels), displays=displays, encoding=encoding, flags=flags,
+                         x=x, y=y, width=width, height=height)
+
+    def cache_show(self, cache_id: int, x: int = 0, y: int = 0, flags: int = 0,
+                   displays: int = 0) -> 'BatchBuilder':
+        if not 0 <= cache_id <= MAX_CACHE_ID:
+            raise ValueError(f"Cache id must be 0-{MAX_CACHE_ID}")
+        return self._add(BATCH_CACHE_SHOW, bytes([cache_id]), displays=displays, flags=flags, x=x, y=y)
+
+    def text(self, text: str, x: int = 0, y: int = 0, foreground: int = 0xFFFF,
+             background: Optional[int] = None, scale: int = 1, atlas: int = BUILTIN_ATLAS,
+             displays: int = 0) -> 'BatchBuilder':
+        data = text.encode('latin-1', 'replace')
+        if not 1 <= len(data) <= TEXT_MAX_LENGTH:
+            raise ValueError(f"Text must be 1-{TEXT_MAX_LENGTH} characters")
+        if not 1 <= scale <= TEXT_MAX_SCALE:
+            raise ValueError(f"Scale must be 1-{TEXT_MAX_SCALE}")
+        params = struct.pack(TEXT_PARAMS_FORMAT, foreground, background or 0, atlas,
+                             TEXT_FLAG_OPAQUE if background is not None else 0, scale, 0)
+        return self._add(BATCH_TEXT, params + data, displays=displays, x=x, y=y)
+
+    def tiles(self, draws, x: int = 0, y: int = 0, flags: int = 0, displays: int = 0) -> 'BatchBuilder':
+        if not 1 <= len(draws) <= MAX_TILE_DRAWS:
+            raise ValueError(f"Tile list must have 1-{MAX_TILE_DRAWS} entries")
+        payload = b''.join(struct.pack(TILE_DRAW_FORMAT, tx, ty, cache_id, 0)
+                           for cache_id, tx, ty in draws)
+        return self._add(BATCH_TILES, payload, displays=displays, flags=flags, x=x, y=y)
+
+
+def resolve_display_index(connection, name: str, timeout: float = 3.0) -> Optional[int]:
+    """
+    Look up a display's DisplayManager index via CMD:LIST
+
+    Returns:
+        int index, or None if the display is not registered
+    """
+    connection.reset_input_buffer()
+    connection.write(b"CMD:LIST\n")
+    connection.flush()
+
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        line = connection.readline().decode('utf-8', errors='ignore').strip()
+        if not line:
+            continue
+        if line.startswith('END_LIST'):
+            break
+        # Expected format: "[0] DueLCD01 - 160x128 (Unknown)"
+        if line.startswith('[') and ']' in line:
+            index_str, rest = line[1:].split(']', 1)
+            if rest.strip().split(' ', 1)[0] == name:
+                try:
+                    return int(index_str)
+                except ValueError:
+                    return None
+    return None
@@ -0,0 +1,149 @@
+"""
+ST7735 Dirty Rectangle Detection
+Finds the regions that changed between two RGB565 frames so only those
+windows need to be sent (SIZE:w,h,x,y or a binary BLIT at x/y)
+
+Frames are row-major sequences of packed pixels, as returned by
+BitmapSender.prepare_image(). Changes are tracked on a coarse tile grid and
+merged into rectangles: a few larger windows cost far less handshake
+overhead than many single pixels. coalesce_rects() merges rectangles that
+arrive separately (sender_daemon.py, one list per display).
+"""
+
+from typing import List, Optional, Sequence, Tuple
+
+Rect = Tuple[int, int, int, int]  # (x, y, width, height) in image coordinates
+
+DEFAULT_TILE_SIZE = 8
+DEFAULT_MAX_RECTS = 16
+DEFAULT_MERGE_SLACK = 64   # Pixels worth re-sending to save one window
+
+
+def find_dirty_rects(previous: Optional[Sequence[bytes]], current: Sequence[bytes],
+                     width: int, height: int, tile_size: int = DEFAULT_TILE_SIZE,
+                     max_rects: int = DEFAULT_MAX_RECTS) -> List[Rect]:
+    """
+    Compute the rectangles that differ between two frames
+
+    Args:
+        previous: Previous frame (None forces a full update)
+        current: New frame, same dimensions as previous
+        width, height: Frame dimensions in pixels
+        tile_size: Change-tracking granularity in pixels
+        max_rects: Above this many rectangles, fall back to their bounding box
+
+    Returns:
+        list of (x, y, width, height); empty if the frames are identical
+    """
+    if previous is None or len(previous) != len(current):
+        return [(0, 0, width, height)]
+
+    tiles_x = (width + tile_size - 1) // tile_size
+    tiles_y = (height + tile_size - 1) // tile_size
+    dirty = [[False] * tiles_x for _ in range(tiles_y)]
+
+    for y in range(height):
+        start = y * width
+        if previous[start:start + width] == current[start:start + width]:
+            continue
+        tile_row = dirty[y // tile_size]
+        for x in range(width):
+            if previous[start + x] != current[start + x]:
+                tile_row[x // tile_size] = True
+
+    # Horizontal runs per tile row, extended downwards while the run repeats
+    rects = []
+    open_runs = {}  # (tx0, tx1) -> [tx0, ty0, tx1, ty1]
+    for ty in range(tiles_y):
+        runs = []
+        tx = 0
+        while tx < tiles_x:
+            if dirty[ty][tx]:
+                start = tx
+                while tx < tiles_x and dirty[ty][tx]:
+                    tx += 1
+                runs.append((start, tx))
+            else:
+                tx += 1
+
+        next_open = {}
+        for run in runs:
+            if run in open_runs:
+                open_runs[run][3] = ty + 1
+                next_open[run] = open_runs.pop(run)
+            else:
+                next_open[run] = [run[0], ty, run[1], ty + 1]
+        rects.extend(open_runs.values())
+        open_runs = next_open
+    rects.extend(open_runs.values())
+
+    # Tile coordinates -> pixels, clipped to the frame
+    result = []
+    for tx0, ty0, tx1, ty1 in rects:
+        x0 = tx0 * tile_size
+        y0 = ty0 * tile_size
+        x1 = min(tx1 * tile_size, width)
+        y1 = min(ty1 * tile_size, height)
+        result.append((x0, y0, x1 - x0, y1 - y0))
+
+    if len(result) > max_rects:
+        return [bounding_rect(result)]
+    return sorted(result, key=lambda r: (r[1], r[0]))
+
+
+def coalesce_rects(rects: Sequence[Rect], max_rects: int = DEFAULT_MAX_RECTS,
+                   merge_slack: int = DEFAULT_MERGE_SLACK) -> List[Rect]:
+    """
+    Merge overlapping and nearby rectangles, e.g. updates from several clients to one display
+
+    Two rectangles are joined when their bounding box covers at most
+    merge_slack pixels more than the pair does on its own (overlap counted
+    once). Above max_rects the bounding box of everything is returned.
+
+    Returns:
+        list of (x, y, width, height), none of them overlapping another
+    """
+    merged = [r for r in rects if r[2] > 0 and r[3] > 0]
+    changed = True
+    while changed and len(merged) > 1:
+        changed = False
+        for i in range(len(merged)):
+            for j in range(i + 1, len(merged)):
+                a, b = merged[i], merged[j]
+                box = bounding_rect((a, b))
+                covered = a[2] * a[3] + b[2] * b[3] - _overlap_area(a, b)
+                if box[2] * box[3] - covered <= merge_slack or _overlap_area(a, b) > 0:
+                    merged[i] = box
+                    del merged[j]
+                    changed = True
+                    break
+            if changed:
+                break
+
+    if len(merged) > max_rects:
+        return [bounding_rect(merged)]
+    return sorted(merged, key=lambda r: (r[1], r[0]))
+
+
+def _overlap_area(a: Rect, b: Rect) -> int:
+    w = min(a[0] + a[2], b[0] + b[2]) - max(a[0], b[0])
+    h = min(a[1] + a[3], b[1] + b[3]) - max(a[1], b[1])
+    return w * h if w > 0 and h > 0 else 0
+
+
+def bounding_rect(rects: Sequence[Rect]) -> Rect:
+    """Smallest rectangle containing all rects"""
+    x0 = min(r[0] for r in rects)
+    y0 = min(r[1] for r in rects)
+    x1 = max(r[0] + r[2] for r in rects)
+    y1 = max(r[1] + r[3] for r in rects)
+    return (x0, y0, x1 - x0, y1 - y0)
+
+
+def extract_rect(pixels: Sequence[bytes], width: int, rect: Rect) -> List[bytes]:
+    """Pixels of rect, row-major, in the same packed form as the frame"""
+    x, y, w, h = rect
+    region = []
+    for row in range(y, y + h):
+        region.extend(pixels[row * width + x:row * width + x + w])
+    return region
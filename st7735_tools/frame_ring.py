@@ -0,0 +1,382 @@
+"""
+ST7735 Shared-Memory Frame Rings
+Local client side of sender_daemon.py, which owns the serial port and
+drives the binary protocol for every process that wants to draw
+
+A client connects to the daemon's Unix control socket, is given a ring of
+fixed-size slots in shared memory and then writes frames straight into it:
+reserve() hands out a NumPy view of the next free slot to render into (or
+submit() copies a finished array there), commit() publishes it. Nothing is
+serialised or sent through the socket except a one-byte doorbell that wakes
+the daemon. Each ring has one producer (the client) and one consumer (the
+daemon), so the head and tail counters need no lock.
+
+Ring layout (little-endian):
+    [RingHeader (64 bytes)][slot 0][slot 1]...
+    slot = [SlotHeader (32 bytes)][payload (slot_bytes)]
+A slot is published by stamping its sequence (head + 1) after the payload
+and header, then advancing head; the daemon only reads slots whose stamp
+matches.
+
+Frames are placed at (x, y) in display coordinates, like a BLIT, in one of:
+    FORMAT_RGB565 - (h, w) uint16 native RGB565 values
+    FORMAT_RGB888 - (h, w, 3) uint8 R, G, B
+    FORMAT_RGBA8888 - (h, w, 4) uint8, alpha ignored
+to_rgb565() is the daemon's (vectorised) conversion to wire byte order.
+"""
+
+import json
+import os
+import socket
+import struct
+import time
+from multiprocessing import shared_memory
+from typing import Dict, Optional, Tuple
+
+import numpy as np
+
+DEFAULT_SOCKET = '/tmp/st7735_sender.sock'
+
+RING_MAGIC = b'ST7735FR'
+RING_VERSION = 1
+
+# magic, version, slot_count, slot_bytes, reserved, head, tail, dropped (padded to 64 bytes)
+RING_HEADER_FORMAT = '<8sIIII8xQQQ8x'
+RING_HEADER_SIZE = struct.calcsize(RING_HEADER_FORMAT)
+HEAD_OFFSET = 32
+TAIL_OFFSET = 40
+DROPPED_OFFSET = 48
+
+# sequence, submit time (time.monotonic_ns), display index, format, x, y, width, height, payload bytes
+SLOT_HEADER_FORMAT = '<QQBBhhHHI2x'
+SLOT_HEADER_SIZE = struct.calcsize(SLOT_HEADER_FORMAT)
+
+FORMAT_RGB565 = 0
+FORMAT_RGB888 = 1
+FORMAT_RGBA8888 = 2
+
+# Bytes per pixel and array layout per format
+FORMAT_CHANNELS = {
+    FORMAT_RGB565: (2, None),
+    FORMAT_RGB888: (3, 3),
+    FORMAT_RGBA8888: (4, 4),
+}
+
+DEFAULT_SLOTS = 8
+DEFAULT_SLOT_BYTES = 160 * 160 * 4   # One full RGBA frame of either panel orientation
+
+# Control messages are one JSON object per line; this byte (never part of
+# JSON text) is a client's doorbell after commit()
+DOORBELL = b'!'
+
+assert RING_HEADER_SIZE == 64, "RingHeader must be 64 bytes"
+assert SLOT_HEADER_SIZE == 32, "SlotHeader must be 32 bytes"
+
+
+def to_rgb565(pixels: np.ndarray, pixel_format: int) -> np.ndarray:
+    """
+    Convert a frame to (h, w) big-endian RGB565, ready to send as-is
+
+    Truncates like the firmware's own RGB888 reduction (no dithering).
+    """
+    if pixel_format == FORMAT_RGB565:
+        return pixels.astype('>u2', copy=False)
+    rgb = pixels[..., :3].astype(np.uint16)
+    value = ((rgb[..., 0] & 0xF8) << 8) | ((rgb[..., 1] & 0xFC) << 3) | (rgb[..., 2] >> 3)
+    return value.astype('>u2')
+
+
+def attach_shared_memory(name: str) -> shared_memory.SharedMemory:
+    """Open an existing block without this process' resource tracker unlinking it on exit"""
+    try:
+        return shared_memory.SharedMemory(name=name, track=False)
+    except TypeError:
+        # Python < 3.13: no track argument, so unregister by hand
+        from multiprocessing import resource_tracker
+        block = shared_memory.SharedMemory(name=name)
+        resource_tracker.unregister(block._name, 'shared_memory')
+        return block
+
+
+def _frame_shape(pixel_format: int, width: int, height: int) -> Tuple[Tuple[int, ...], np.dtype, int]:
+    if pixel_format not in FORMAT_CHANNELS:
+        raise ValueError(f"Unknown pixel format {pixel_format}")
+    bytes_per_pixel, channels = FORMAT_CHANNELS[pixel_format]
+    if channels is None:
+        return (height, width), np.dtype(np.uint16), width * height * bytes_per_pixel
+    return (height, width, channels), np.dtype(np.uint8), width * height * bytes_per_pixel
+
+
+class FrameRecord:
+    """One frame read from a ring (pixels stay valid until release())"""
+
+    def __init__(self, sequence: int, submitted_ns: int, display: int, pixel_format: int,
+                 x: int, y: int, width: int, height: int, pixels: np.ndarray):
+        self.sequence = sequence
+        self.submitted_ns = submitted_ns
+        self.display = display
+        self.pixel_format = pixel_format
+        self.x = x
+        self.y = y
+        self.width = width
+        self.height = height
+        self.pixels = pixels
+
+
+class FrameRing:
+    """
+    Single-producer, single-consumer ring of frame slots in shared memory
+
+    The daemon creates a ring per client (create()); the client attaches by
+    name (attach()). Producer calls: reserve() / commit(). Consumer calls:
+    peek() / release().
+    """
+
+    def __init__(self, block: shared_memory.SharedMemory, owner: bool):
+        self.block = block
+        self.owner = owner
+        self.buffer = block.buf
+        magic, version, slot_count, slot_bytes, _, _, _, _ = struct.unpack_from(
+            RING_HEADER_FORMAT, self.buffer, 0)
+        if magic != RING_MAGIC or version != RING_VERSION:
+            raise ValueError(f"{block.name} is not a version {RING_VERSION} frame ring")
+        self.slot_count = slot_count
+        self.slot_bytes = slot_bytes
+        self._reserved: Optional[tuple] = None  # (slot offset, header fields) being written
+
+    @classmethod
+    def create(cls, name: str, slot_count: int = DEFAULT_SLOTS,
+               slot_bytes: int = DEFAULT_SLOT_BYTES) -> 'FrameRing':
+        size = RING_HEADER_SIZE + slot_count * (SLOT_HEADER_SIZE + slot_bytes)
+        block = shared_memory.SharedMemory(name=name, create=True, size=size)
+        struct.pack_into(RING_HEADER_FORMAT, block.buf, 0, RING_MAGIC, RING_VERSION,
+                         slot_count, slot_bytes, 0, 0, 0, 0)
+        return cls(block, owner=True)
+
+    @classmethod
+    def attach(cls, name: str) -> 'FrameRing':
+        return cls(attach_shared_memory(name), owner=False)
+
+    @property
+    def name(self) -> str:
+        return self.block.name
+
+    def _counter(self, offset: int) -> int:
+        return struct.unpack_from('<Q', self.buffer, offset)[0]
+
+    def _set_counter(self, offset: int, value: int):
+        struct.pack_into('<Q', self.buffer, offset, value)
+
+    def _slot_offset(self, index: int) -> int:
+        return RING_HEADER_SIZE + (index % self.slot_count) * (SLOT_HEADER_SIZE + self.slot_bytes)
+
+    @property
+    def depth(self) -> int:
+        """Frames committed but not yet released"""
+        return self._counter(HEAD_OFFSET) - self._counter(TAIL_OFFSET)
+
+    @property
+    def dropped(self) -> int:
+        """Frames the producer gave up on because the ring was full"""
+        return self._counter(DROPPED_OFFSET)
+
+    def count_drop(self):
+        self._set_counter(DROPPED_OFFSET, self.dropped + 1)
+
+    def pending_displays(self) -> Dict[int, int]:
+        """Committed, unreleased frames per display index"""
+        counts: Dict[int, int] = {}
+        tail = self._counter(TAIL_OFFSET)
+        for index in range(tail, self._counter(HEAD_OFFSET)):
+            display = self.buffer[self._slot_offset(index) + 16]
+            counts[display] = counts.get(display, 0) + 1
+        return counts
+
+    # Producer side
+
+    def reserve(self, display: int, width: int, height: int, pixel_format: int = FORMAT_RGB888,
+                x: int = 0, y: int = 0) -> Optional[np.ndarray]:
+        """
+        Writable view of the next free slot shaped for a width x height frame
+
+        Returns:
+            The view, or None when the ring is full (nothing is reserved)
+
+        Raises:
+            ValueError: if the frame does not fit a slot
+        """
+        shape, dtype, length = _frame_shape(pixel_format, width, height)
+        if length > self.slot_bytes or width <= 0 or height <= 0:
+            raise ValueError(f"{width}x{height} frame does not fit a {self.slot_bytes}-byte slot")
+        head = self._counter(HEAD_OFFSET)
+        if head - self._counter(TAIL_OFFSET) >= self.slot_count:
+            return None
+        offset = self._slot_offset(head)
+        self._reserved = (offset, (display, pixel_format, x, y, width, height, length))
+        payload = self.buffer[offset + SLOT_HEADER_SIZE:offset + SLOT_HEADER_SIZE + length]
+        return np.ndarray(shape, dtype=dtype, buffer=payload)
+
+    def commit(self):
+        """Publish the frame written into the reserve()d view"""
+        if self._reserved is None:
+            raise RuntimeError("commit() without reserve()")
+        offset, (display, pixel_format, x, y, width, height, length) = self._reserved
+        self._reserved = None
+        head = self._counter(HEAD_OFFSET)
+        # Fields first with a stale stamp, then the stamp, then head
+        struct.pack_into(SLOT_HEADER_FORMAT, self.buffer, offset, 0, time.monotonic_ns(),
+                         display, pixel_format, x, y, width, height, length)
+        struct.pack_into('<Q', self.buffer, offset, head + 1)
+        self._set_counter(HEAD_OFFSET, head + 1)
+
+    # Consumer side
+
+    def peek(self) -> Optional[FrameRecord]:
+        """Oldest committed frame, or None when the ring is empty"""
+        tail = self._counter(TAIL_OFFSET)
+        if tail == self._counter(HEAD_OFFSET):
+            return None
+        offset = self._slot_offset(tail)
+        fields = struct.unpack_from(SLOT_HEADER_FORMAT, self.buffer, offset)
+        sequence, submitted_ns, display, pixel_format, x, y, width, height, length = fields
+        if sequence != tail + 1:
+            return None     # Head seen before the slot stamp; read it next time
+        try:
+            shape, dtype, expected = _frame_shape(pixel_format, width, height)
+        except ValueError:
+            expected = -1
+        if expected != length or length > self.slot_bytes:
+            # Corrupt slot: skip it rather than stall the ring
+            self.release()
+            return None
+        payload = self.buffer[offset + SLOT_HEADER_SIZE:offset + SLOT_HEADER_SIZE + length]
+        return FrameRecord(sequence, submitted_ns, display, pixel_format, x, y, width, height,
+                           np.ndarray(shape, dtype=dtype, buffer=payload))
+
+    def release(self):
+        """Hand the oldest slot back to the producer"""
+        self._set_counter(TAIL_OFFSET, self._counter(TAIL_OFFSET) + 1)
+
+    def close(self):
+        self.buffer = None
+        try:
+            self.block.close()
+        except BufferError:
+            pass    # A reserve() view is still alive; the mapping goes with it
+        if self.owner:
+            self.block.unlink()
+
+
+class FrameClient:
+    """
+    Producer connection to a running sender_daemon.py
+
+    Displays are addressed by configured name (e.g. 'DueLCD01'); sizes()
+    reports each one's panel size. Typical use:
+
+        with FrameClient() as client:
+            client.submit('DueLCD01', frame)             # (h, w, 3) uint8
+            view = client.reserve('DueLCD02', 32, 16, FORMAT_RGB565, x=8, y=8)
+            view[:] = 0xF800
+            client.commit()
+    """
+
+    def __init__(self, socket_path: str = DEFAULT_SOCKET, client_name: Optional[str] = None,
+                 slots: int = DEFAULT_SLOTS, slot_bytes: int = DEFAULT_SLOT_BYTES,
+                 timeout: float = 5.0):
+        self.ring: Optional[FrameRing] = None
+        self.control = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.control.settimeout(timeout)
+        self.control.connect(socket_path)
+        self._lines = b''
+        reply = self.request({'cmd': 'hello', 'name': client_name or f'pid{os.getpid()}',
+                              'slots': slots, 'slot_bytes': slot_bytes})
+        self.displays: Dict[str, dict] = reply['displays']
+        self.ring = FrameRing.attach(reply['ring'])
+
+    def __enter__(self) -> 'FrameClient':
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def request(self, message: dict) -> dict:
+        """Send one control command and return the daemon's reply"""
+        self.control.sendall(json.dumps(message).encode() + b'\n')
+        while b'\n' not in self._lines:
+            chunk = self.control.recv(65536)
+            if not chunk:
+                raise ConnectionError("Sender daemon closed the connection")
+            self._lines += chunk
+        line, self._lines = self._lines.split(b'\n', 1)
+        reply = json.loads(line)
+        if 'error' in reply:
+            raise RuntimeError(reply['error'])
+        return reply
+
+    def metrics(self) -> dict:
+        return self.request({'cmd': 'metrics'})
+
+    def sizes(self) -> Dict[str, Tuple[int, int]]:
+        return {name: (info['width'], info['height']) for name, info in self.displays.items()}
+
+    def _display_index(self, display: str) -> int:
+        if display not in self.displays:
+            raise KeyError(f"Display {display} is not served by the daemon")
+        return self.displays[display]['index']
+
+    def reserve(self, display: str, width: int, height: int, pixel_format: int = FORMAT_RGB888,
+                x: int = 0, y: int = 0, block: bool = True, timeout: float = 1.0) -> Optional[np.ndarray]:
+        """
+        View of a free slot to render a frame into; commit() sends it
+
+        With block, waits up to timeout for the daemon to free a slot.
+        Returns None (and counts a drop) when the ring stays full.
+        """
+        index = self._display_index(display)
+        deadline = time.monotonic() + timeout
+        while True:
+            view = self.ring.reserve(index, width, height, pixel_format, x, y)
+            if view is not None:
+                return view
+            if not block or time.monotonic() >= deadline:
+                self.ring.count_drop()
+                return None
+            time.sleep(0.001)
+
+    def commit(self):
+        self.ring.commit()
+        try:
+            self.control.send(DOORBELL, socket.MSG_DONTWAIT)
+        except (BlockingIOError, InterruptedError):
+            pass    # Doorbells already queued: the daemon is waking anyway
+
+    def submit(self, display: str, pixels, x: int = 0, y: int = 0,
+               block: bool = True, timeout: float = 1.0) -> bool:
+        """
+        Copy a finished frame into the ring and publish it
+
+        pixels: (h, w) uint16 RGB565, (h, w, 3) / (h, w, 4) uint8, or a PIL image
+        Returns False if the frame was dropped because the ring stayed full.
+        """
+        array = np.asarray(pixels)
+        if array.ndim == 2 and array.dtype == np.uint16:
+            pixel_format = FORMAT_RGB565
+        elif array.ndim == 3 and array.shape[2] == 4:
+            pixel_format = FORMAT_RGBA8888
+        elif array.ndim == 3 and array.shape[2] == 3:
+            pixel_format = FORMAT_RGB888
+        else:
+            raise ValueError(f"Unsupported frame shape {array.shape}")
+        view = self.reserve(display, array.shape[1], array.shape[0], pixel_format, x, y, block, timeout)
+        if view is None:
+            return False
+        view[...] = array
+        self.commit()
+        return True
+
+    def close(self):
+        if self.ring is not None:
+            self.ring.close()
+            self.ring = None
+        self.control.close()
@@ -0,0 +1,237 @@
+"""
+ST7735 Glyph Atlas Packer
+Host-side builder for the firmware's text overlay atlases (see
+lib/GlyphAtlas/GlyphAtlas.h for the authoritative format)
+
+An atlas is an 8-byte header, one width byte per glyph and then each
+glyph's rows, (width + 7) // 8 bytes per row with the most significant bit
+as the leftmost pixel. Atlases are uploaded once with OP_CACHE_STORE and
+ENC_GLYPH_ATLAS and then referenced by cache id from CMD:TEXT / OP_TEXT;
+the firmware's built-in 5x7 font is classic_atlas(), generated into
+lib/GlyphAtlas/GlyphAtlasFont.cpp with --c-array.
+
+Usage:
+    python3 -m st7735_tools.glyph_atlas --preview "Hello"
+    python3 -m st7735_tools.glyph_atlas --font DejaVuSans.ttf --size 12 -o atlas.bin
+    python3 -m st7735_tools.glyph_atlas --c-array
+"""
+
+import argparse
+import struct
+import sys
+from typing import List, Sequence, Tuple
+
+ATLAS_MAGIC = 0x47                  # 'G'
+ATLAS_HEADER_FORMAT = '<BBBBBBBB'   # magic, first char, glyph count, height, spacing, fallback, reserved x2
+ATLAS_HEADER_SIZE = struct.calcsize(ATLAS_HEADER_FORMAT)
+MAX_GLYPH_WIDTH = 32
+MAX_GLYPH_HEIGHT = 32
+
+# (width, rows) with each row an int whose bit (width - 1) is the leftmost pixel
+Glyph = Tuple[int, List[int]]
+
+# Classic 5x7 LCD font, 0x20-0x7E: five columns per glyph, bit 0 = top row
+CLASSIC_5X7 = [
+    0x00, 0x00, 0x00, 0x00, 0x00,  0x00, 0x00, 0x5F, 0x00, 0x00,  # ' ' !
+    0x00, 0x07, 0x00, 0x07, 0x00,  0x14, 0x7F, 0x14, 0x7F, 0x14,  # " #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,  0x23, 0x13, 0x08, 0x64, 0x62,  # $ %
+    0x36, 0x49, 0x55, 0x22, 0x50,  0x00, 0x05, 0x03, 0x00, 0x00,  # & '
+    0x00, 0x1C, 0x22, 0x41, 0x00,  0x00, 0x41, 0x22, 0x1C, 0x00,  # ( )
+    0x14, 0x08, 0x3E, 0x08, 0x14,  0x08, 0x08, 0x3E, 0x08, 0x08,  # * +
+    0x00, 0x50, 0x30, 0x00, 0x00,  0x08, 0x08, 0x08, 0x08, 0x08,  # , -
+    0x00, 0x60, 0x60, 0x00, 0x00,  0x20, 0x10, 0x08, 0x04, 0x02,  # . /
+    0x3E, 0x51, 0x49, 0x45, 0x3E,  0x00, 0x42, 0x7F, 0x40, 0x00,  # 0 1
+    0x42, 0x61, 0x51, 0x49, 0x46,  0x21, 0x41, 0x45, 0x4B, 0x31,  # 2 3
+    0x18, 0x14, 0x12, 0x7F, 0x10,  0x27, 0x45, 0x45, 0x45, 0x39,  # 4 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30,  0x01, 0x71, 0x09, 0x05, 0x03,  # 6 7
+    0x36, 0x49, 0x49, 0x49, 0x36,  0x06, 0x49, 0x49, 0x29, 0x1E,  # 8 9
+    0x00, 0x36, 0x36, 0x00, 0x00,  0x00, 0x56, 0x36, 0x00, 0x00,  # : ;
+    0x08, 0x14, 0x22, 0x41, 0x00,  0x14, 0x14, 0x14, 0x14, 0x14,  # < =
+    0x00, 0x41, 0x22, 0x14, 0x08,  0x02, 0x01, 0x51, 0x09, 0x06,  # > ?
+    0x32, 0x49, 0x79, 0x41, 0x3E,  0x7E, 0x11, 0x11, 0x11, 0x7E,  # @ A
+    0x7F, 0x49, 0x49, 0x49, 0x36,  0x3E, 0x41, 0x41, 0x41, 0x22,  # B C
+    0x7F, 0x41, 0x41, 0x22, 0x1C,  0x7F, 0x49, 0x49, 0x49, 0x41,  # D E
+    0x7F, 0x09, 0x09, 0x09, 0x01,  0x3E, 0x41, 0x49, 0x49, 0x7A,  # F G
+    0x7F, 0x08, 0x08, 0x08, 0x7F,  0x00, 0x41, 0x7F, 0x41, 0x00,  # H I
+    0x20, 0x40, 0x41, 0x3F, 0x01,  0x7F, 0x08, 0x14, 0x22, 0x41,  # J K
+    0x7F, 0x40, 0x40, 0x40, 0x40,  0x7F, 0x02, 0x0C, 0x02, 0x7F,  # L M
+    0x7F, 0x04, 0x08, 0x10, 0x7F,  0x3E, 0x41, 0x41, 0x41, 0x3E,  # N O
+    0x7F, 0x09, 0x09, 0x09, 0x06,  0x3E, 0x41, 0x51, 0x21, 0x5E,  # P Q
+    0x7F, 0x09, 0x19, 0x29, 0x46,  0x46, 0x49, 0x49, 0x49, 0x31,  # R S
+    0x01, 0x01, 0x7F, 0x01, 0x01,  0x3F, 0x40, 0x40, 0x40, 0x3F,  # T U
+    0x1F, 0x20, 0x40, 0x20, 0x1F,  0x3F, 0x40, 0x38, 0x40, 0x3F,  # V W
+    0x63, 0x14, 0x08, 0x14, 0x63,  0x07, 0x08, 0x70, 0x08, 0x07,  # X Y
+    0x61, 0x51, 0x49, 0x45, 0x43,  0x00, 0x7F, 0x41, 0x41, 0x00,  # Z [
+    0x02, 0x04, 0x08, 0x10, 0x20,  0x00, 0x41, 0x41, 0x7F, 0x00,  # \ ]
+    0x04, 0x02, 0x01, 0x02, 0x04,  0x40, 0x40, 0x40, 0x40, 0x40,  # ^ _
+    0x00, 0x01, 0x02, 0x04, 0x00,  0x20, 0x54, 0x54, 0x54, 0x78,  # ` a
+    0x7F, 0x48, 0x44, 0x44, 0x38,  0x38, 0x44, 0x44, 0x44, 0x20,  # b c
+    0x38, 0x44, 0x44, 0x48, 0x7F,  0x38, 0x54, 0x54, 0x54, 0x18,  # d e
+    0x08, 0x7E, 0x09, 0x01, 0x02,  0x0C, 0x52, 0x52, 0x52, 0x3E,  # f g
+    0x7F, 0x08, 0x04, 0x04, 0x78,  0x00, 0x44, 0x7D, 0x40, 0x00,  # h i
+    0x20, 0x40, 0x44, 0x3D, 0x00,  0x7F, 0x10, 0x28, 0x44, 0x00,  # j k
+    0x00, 0x41, 0x7F, 0x40, 0x00,  0x7C, 0x04, 0x18, 0x04, 0x78,  # l m
+    0x7C, 0x08, 0x04, 0x04, 0x78,  0x38, 0x44, 0x44, 0x44, 0x38,  # n o
+    0x7C, 0x14, 0x14, 0x14, 0x08,  0x08, 0x14, 0x14, 0x18, 0x7C,  # p q
+    0x7C, 0x08, 0x04, 0x04, 0x08,  0x48, 0x54, 0x54, 0x54, 0x20,  # r s
+    0x04, 0x3F, 0x44, 0x40, 0x20,  0x3C, 0x40, 0x40, 0x20, 0x7C,  # t u
+    0x1C, 0x20, 0x40, 0x20, 0x1C,  0x3C, 0x40, 0x30, 0x40, 0x3C,  # v w
+    0x44, 0x28, 0x10, 0x28, 0x44,  0x0C, 0x50, 0x50, 0x50, 0x3C,  # x y
+    0x44, 0x64, 0x54, 0x4C, 0x44,  0x00, 0x08, 0x36, 0x41, 0x00,  # z {
+    0x00, 0x00, 0x7F, 0x00, 0x00,  0x00, 0x41, 0x36, 0x08, 0x00,  # | }
+    0x02, 0x01, 0x02, 0x04, 0x02,                                 # ~
+]
+CLASSIC_FIRST_CHAR = 0x20
+
+
+def pack_atlas(glyphs: Sequence[Glyph], height: int, first_char: int = 0x20,
+               spacing: int = 1, fallback: int = ord('?')) -> bytes:
+    """
+    Pack glyphs (consecutive codes from first_char) into the firmware atlas format
+
+    Returns:
+        bytes: Atlas ready for OP_CACHE_STORE with ENC_GLYPH_ATLAS
+    """
+    if not 1 <= len(glyphs) <= 255 or first_char + len(glyphs) > 256:
+        raise ValueError("Atlas must hold 1-255 glyphs within codes 0-255")
+    if not 1 <= height <= MAX_GLYPH_HEIGHT or not 0 <= spacing <= MAX_GLYPH_WIDTH:
+        raise ValueError(f"Glyph height must be 1-{MAX_GLYPH_HEIGHT}, spacing 0-{MAX_GLYPH_WIDTH}")
+    widths = bytearray()
+    bitmaps = bytearray()
+    for width, rows in glyphs:
+        if not 0 <= width <= MAX_GLYPH_WIDTH or len(rows) != height:
+            raise ValueError(f"Glyphs must be 0-{MAX_GLYPH_WIDTH} wide and {height} rows tall")
+        row_bytes = (width + 7) // 8
+        widths.append(width)
+        for row in rows:
+            # Left-align the row in its bytes (MSB = leftmost pixel)
+            bitmaps += (row << (row_bytes * 8 - width)).to_bytes(row_bytes, 'big')
+    header = struct.pack(ATLAS_HEADER_FORMAT, ATLAS_MAGIC, first_char, len(glyphs), height,
+                         spacing, fallback, 0, 0)
+    return header + bytes(widths) + bytes(bitmaps)
+
+
+def unpack_atlas(atlas: bytes) -> Tuple[int, int, int, int, List[Glyph]]:
+    """Split an atlas into (first_char, height, spacing, fallback, glyphs)"""
+    magic, first_char, count, height, spacing, fallback, _, _ = struct.unpack_from(
+        ATLAS_HEADER_FORMAT, atlas)
+    if magic != ATLAS_MAGIC:
+        raise ValueError("Not a glyph atlas")
+    offset = ATLAS_HEADER_SIZE + count
+    glyphs = []
+    for width in atlas[ATLAS_HEADER_SIZE:offset]:
+        row_bytes = (width + 7) // 8
+        rows = []
+        for _ in range(height):
+            value = int.from_bytes(atlas[offset:offset + row_bytes], 'big')
+            rows.append(value >> (row_bytes * 8 - width))
+            offset += row_bytes
+        glyphs.append((width, rows))
+    return first_char, height, spacing, fallback, glyphs
+
+
+def classic_atlas() -> bytes:
+    """The firmware's built-in 5x7 font (7 rows plus one blank baseline row)"""
+    glyphs = []
+    for start in range(0, len(CLASSIC_5X7), 5):
+        columns = CLASSIC_5X7[start:start + 5]
+        rows = [sum(((columns[col] >> row) & 1) << (4 - col) for col in range(5))
+                for row in range(8)]
+        glyphs.append((5, rows))
+    return pack_atlas(glyphs, 8, CLASSIC_FIRST_CHAR)
+
+
+def rasterize_font(path: str, size: int, first_char: int = 0x20, last_char: int = 0x7E,
+                   threshold: int = 128, spacing: int = 0) -> bytes:
+    """Render a TrueType/OpenType font at size pixels into a 1-bit atlas (needs Pillow)"""
+    from PIL import Image, ImageDraw, ImageFont
+
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    height = min(ascent + descent, MAX_GLYPH_HEIGHT)
+    glyphs = []
+    for code in range(first_char, last_char + 1):
+        width = min(int(round(font.getlength(chr(code)))), MAX_GLYPH_WIDTH)
+        image = Image.new('L', (max(width, 1), height), 0)
+        ImageDraw.Draw(image).text((0, 0), chr(code), font=font, fill=255)
+        rows = []
+        for y in range(height):
+            row = 0
+            for x in range(width):
+                row = (row << 1) | (image.getpixel((x, y)) >= threshold)
+            rows.append(row)
+        glyphs.append((width, rows))
+    return pack_atlas(glyphs, height, first_char, spacing)
+
+
+def text_size(atlas: bytes, text: str, scale: int = 1) -> Tuple[int, int]:
+    """Pixel size the firmware reports (OK:TEXT:<w>,<h>) for text drawn with atlas"""
+    first_char, height, spacing, fallback, glyphs = unpack_atlas(atlas)
+    widths = []
+    for code in text.encode('latin-1', 'replace'):
+        index = code - first_char if 0 <= code - first_char < len(glyphs) else fallback - first_char
+        if 0 <= index < len(glyphs):
+            widths.append(glyphs[index][0])
+    if not widths:
+        return 0, 0
+    return (sum(widths) + spacing * (len(widths) - 1)) * scale, height * scale
+
+
+def preview(atlas: bytes, text: str) -> str:
+    """ASCII-art rendering of text, for checking an atlas without a display"""
+    first_char, height, spacing, fallback, glyphs = unpack_atlas(atlas)
+    lines = [''] * height
+    for code in text.encode('latin-1', 'replace'):
+        index = code - first_char if 0 <= code - first_char < len(glyphs) else fallback - first_char
+        if not 0 <= index < len(glyphs):
+            continue
+        width, rows = glyphs[index]
+        for y in range(height):
+            lines[y] += ''.join('#' if rows[y] >> (width - 1 - x) & 1 else '.' for x in range(width))
+            lines[y] += '.' * spacing
+    return '\n'.join(lines)
+
+
+def c_array(atlas: bytes, name: str = 'GLYPH_ATLAS_BUILTIN_DATA') -> str:
+    """C++ definition of atlas as a flash-resident byte array and its length"""
+    lines = [f'const uint8_t {name}[{len(atlas)}] = {{']
+    for start in range(0, len(atlas), 16):
+        chunk = atlas[start:start + 16]
+        lines.append('  ' + ', '.join(f'0x{b:02X}' for b in chunk) + ',')
+    lines.append('};')
+    lines.append(f'const uint32_t {name.replace("_DATA", "")}_LENGTH = sizeof({name});')
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build glyph atlases for ST7735 text overlays')
+    parser.add_argument('--font', help='TrueType/OpenType font to rasterize (default: built-in 5x7)')
+    parser.add_argument('--size', type=int, default=8, help='Font size in pixels (default: 8)')
+    parser.add_argument('--first', type=lambda v: int(v, 0), default=0x20, help='First character code')
+    parser.add_argument('--last', type=lambda v: int(v, 0), default=0x7E, help='Last character code')
+    parser.add_argument('--spacing', type=int, default=0, help='Blank columns between glyphs')
+    parser.add_argument('-o', '--output', help='Write the atlas bytes to this file')
+    parser.add_argument('--preview', metavar='TEXT', help='Print TEXT rendered with the atlas')
+    parser.add_argument('--c-array', action='store_true', help='Print the atlas as a C++ array')
+    args = parser.parse_args()
+
+    if args.font:
+        atlas = rasterize_font(args.font, args.size, args.first, args.last, spacing=args.spacing)
+    else:
+        atlas = classic_atlas()
+
+    if args.output:
+        with open(args.output, 'wb') as f:
+            f.write(atlas)
+        print(f"Wrote {len(atlas)} byte atlas to {args.output}")
+    if args.preview is not None:
+        print(preview(atlas, args.preview))
+        width, height = text_size(atlas, args.preview)
+        print(f"{width}x{height} pixels")
+    if args.c_array:
+        print(c_array(atlas))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
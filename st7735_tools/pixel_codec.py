@@ -0,0 +1,252 @@
+"""
+ST7735 Pixel Codecs
+Host-side encoders for the firmware's compressed and indexed pixel
+encodings (see lib/SerialProtocol/PixelDecoder.h for the authoritative format)
+
+Input is a sequence of native RGB565 values (ints), row-major. Both the
+text protocol (SIZE:...;ENC=<name>;LEN=<bytes>) and binary BLIT frames
+(encoding field) carry the same byte streams. Indexed encodings produced
+here carry their own palette (ENC_PALETTE, ";PAL" in the SIZE options).
+
+ENC_RGB888 is not produced here: its payload is the image's RGB bytes as
+they are, and the firmware does the RGB565 reduction (optionally dithered).
+"""
+
+import struct
+from typing import List, Optional, Sequence, Tuple
+
+from st7735_tools import binary_protocol
+
+ENCODING_NAMES = {
+    binary_protocol.ENC_RGB565: 'RGB565',
+    binary_protocol.ENC_RLE: 'RLE',
+    binary_protocol.ENC_QOI: 'QOI',
+    binary_protocol.ENC_INDEXED1: 'IDX1',
+    binary_protocol.ENC_INDEXED2: 'IDX2',
+    binary_protocol.ENC_INDEXED4: 'IDX4',
+    binary_protocol.ENC_INDEXED8: 'IDX8',
+    binary_protocol.ENC_RGB888: 'RGB888',
+}
+
+# SIZE ";DITHER=" option for each ENC_RGB888 dither modifier
+DITHER_NAMES = {
+    binary_protocol.ENC_DITHER_ORDERED: 'ORDERED',
+    binary_protocol.ENC_DITHER_DIFFUSE: 'FS',
+}
+
+# Bits per index for each indexed encoding
+INDEX_BITS = {
+    binary_protocol.ENC_INDEXED1: 1,
+    binary_protocol.ENC_INDEXED2: 2,
+    binary_protocol.ENC_INDEXED4: 4,
+    binary_protocol.ENC_INDEXED8: 8,
+}
+
+RLE_MAX_PACKET = 128
+QOI_MAX_RUN = 62
+QOI_OP_RGB565 = 0xFE
+
+
+def encoding_name(encoding: int) -> str:
+    """Text protocol name (ENC=<name>), ignoring the palette and dither modifiers"""
+    return ENCODING_NAMES[encoding & ~(binary_protocol.ENC_PALETTE | binary_protocol.ENC_DITHER_MASK)]
+
+
+def has_palette(encoding: int) -> bool:
+    return bool(encoding & binary_protocol.ENC_PALETTE)
+
+
+def is_true_color(encoding: int) -> bool:
+    return encoding & ~binary_protocol.ENC_DITHER_MASK == binary_protocol.ENC_RGB888
+
+
+def dither_name(encoding: int) -> Optional[str]:
+    """SIZE ;DITHER= value of an ENC_RGB888 encoding, None when undithered"""
+    return DITHER_NAMES.get(encoding & binary_protocol.ENC_DITHER_MASK)
+
+
+def rgb888_to_rgb565(pixel_data: Sequence[bytes]) -> List[bytes]:
+    """3-byte RGB pixels -> packed big-endian RGB565 (truncating, like the firmware)"""
+    return [struct.pack('>H', ((p[0] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[2] >> 3))
+            for p in pixel_data]
+
+
+def unpack_pixels(pixel_data: Sequence[bytes]) -> List[int]:
+    """Packed big-endian pixels (BitmapSender.prepare_image) -> RGB565 ints"""
+    return [struct.unpack('>H', p)[0] for p in pixel_data]
+
+
+def encode_raw(pixels: Sequence[int]) -> bytes:
+    return b''.join(struct.pack('>H', p) for p in pixels)
+
+
+def encode_rle(pixels: Sequence[int]) -> bytes:
+    """PackBits-style runs (1hhhhhhh P) and literals (0hhhhhhh P...)"""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:RLE_MAX_PACKET]
+            del literal[:RLE_MAX_PACKET]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend(struct.pack('>H', p))
+
+    i = 0
+    count = len(pixels)
+    while i < count:
+        run = 1
+        while i + run < count and run < RLE_MAX_PACKET and pixels[i + run] == pixels[i]:
+            run += 1
+        # A 2-pixel run costs the same as a literal; only break literals for 3+
+        if run >= 3 or (run == 2 and not literal):
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out += struct.pack('>H', pixels[i])
+            i += run
+        else:
+            literal.append(pixels[i])
+            i += 1
+    flush_literal()
+    return bytes(out)
+
+
+def _qoi_hash(pixel: int) -> int:
+    r, g, b = pixel >> 11, (pixel >> 5) & 0x3F, pixel & 0x1F
+    return (r * 3 + g * 5 + b * 7) & 0x3F
+
+
+def _wrap(delta: int, bits: int) -> int:
+    """Signed channel difference with the decoder's modular arithmetic"""
+    half = 1 << (bits - 1)
+    return ((delta + half) % (1 << bits)) - half
+
+
+def encode_qoi(pixels: Sequence[int]) -> bytes:
+    """QOI-style INDEX/DIFF/LUMA/RUN ops on 5/6/5-bit channels"""
+    out = bytearray()
+    index = [0] * 64
+    previous = 0
+    run = 0
+
+    for pixel in pixels:
+        if pixel == previous:
+            run += 1
+            if run == QOI_MAX_RUN:
+                out.append(0xC0 | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(0xC0 | (run - 1))
+            run = 0
+
+        slot = _qoi_hash(pixel)
+        if index[slot] == pixel:
+            out.append(slot)
+        else:
+            dr = _wrap((pixel >> 11) - (previous >> 11), 5)
+            dg = _wrap(((pixel >> 5) & 0x3F) - ((previous >> 5) & 0x3F), 6)
+            db = _wrap((pixel & 0x1F) - (previous & 0x1F), 5)
+            dr_dg = dr - dg
+            db_dg = db - dg
+            if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                out.append(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2))
+            elif -32 <= dg <= 31 and -8 <= dr_dg <= 7 and -8 <= db_dg <= 7:
+                out.append(0x80 | (dg + 32))
+                out.append(((dr_dg + 8) << 4) | (db_dg + 8))
+            else:
+                out.append(QOI_OP_RGB565)
+                out += struct.pack('>H', pixel)
+        index[slot] = pixel
+        previous = pixel
+
+    if run:
+        out.append(0xC0 | (run - 1))
+    return bytes(out)
+
+
+def build_palette(pixels: Sequence[int]) -> Optional[List[int]]:
+    """Distinct colours in first-seen order, or None if there are more than 256"""
+    palette = {}
+    for pixel in pixels:
+        if pixel not in palette:
+            if len(palette) == 256:
+                return None
+            palette[pixel] = len(palette)
+    return list(palette)
+
+
+def encode_palette(palette: Sequence[int]) -> bytes:
+    """[count][count x RGB565 big-endian], count 0 meaning 256"""
+    return bytes([len(palette) & 0xFF]) + struct.pack(f'>{len(palette)}H', *palette)
+
+
+def encode_indexed(pixels: Sequence[int], bits: int, palette: Optional[Sequence[int]] = None,
+                   inline_palette: bool = True) -> bytes:
+    """
+    Pack palette indices MSB first, continuously across rows
+
+    Args:
+        pixels: RGB565 values; every one must be in the palette
+        bits: 1, 2, 4 or 8 bits per index
+        palette: Colour table (default: build_palette(pixels))
+        inline_palette: Prefix the payload with the palette (ENC_PALETTE)
+
+    Raises:
+        ValueError: if the palette has more than 2**bits colours
+    """
+    if palette is None:
+        palette = build_palette(pixels)
+    if palette is None or len(palette) > (1 << bits):
+        raise ValueError(f"Image needs more than {1 << bits} colours for {bits}-bit indices")
+    lookup = {color: i for i, color in enumerate(palette)}
+
+    out = bytearray(encode_palette(palette) if inline_palette else b'')
+    per_byte = 8 // bits
+    for start in range(0, len(pixels), per_byte):
+        value = 0
+        group = pixels[start:start + per_byte]
+        for pixel in group:
+            value = (value << bits) | lookup[pixel]
+        out.append(value << (bits * (per_byte - len(group))))
+    return bytes(out)
+
+
+def smallest_index_encoding(colors: int) -> Optional[int]:
+    """Narrowest indexed encoding for a palette of this size, or None"""
+    for encoding, bits in INDEX_BITS.items():
+        if colors <= (1 << bits):
+            return encoding
+    return None
+
+
+ENCODERS = {
+    binary_protocol.ENC_RGB565: encode_raw,
+    binary_protocol.ENC_RLE: encode_rle,
+    binary_protocol.ENC_QOI: encode_qoi,
+}
+
+
+def encode(pixels: Sequence[int], encoding: int) -> Tuple[int, bytes]:
+    """
+    Encode with one encoding
+
+    Returns:
+        (encoding, payload) - indexed encodings gain ENC_PALETTE (palette inlined)
+    """
+    if encoding in INDEX_BITS:
+        return (encoding | binary_protocol.ENC_PALETTE,
+                encode_indexed(pixels, INDEX_BITS[encoding]))
+    return encoding, ENCODERS[encoding](pixels)
+
+
+def best_encoding(pixels: Sequence[int]) -> Tuple[int, bytes]:
+    """Try every encoding and return (encoding, payload) for the smallest"""
+    results = [(encoding, encoder(pixels)) for encoding, encoder in ENCODERS.items()]
+    palette = build_palette(pixels)
+    if palette is not None:
+        encoding = smallest_index_encoding(len(palette))
+        results.append((encoding | binary_protocol.ENC_PALETTE,
+                        encode_indexed(pixels, INDEX_BITS[encoding], palette)))
+    return min(results, key=lambda result: len(result[1]))
@@ -0,0 +1,15 @@
+/*
+ * Arduino.h
+ * Minimal stand-in for host builds of the platform-independent firmware
+ * sources (PixelDecoder): fixed-width types and the C string functions
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,67 @@
+/*
+ * pixel_decoder_host.cpp
+ * Host build of the firmware's PixelDecoder, driven by test_pixel_codec.py
+ *
+ * Usage: pixel_decoder_host <encoding> <width> <pixels> <chunk bytes> < payload
+ *
+ * The payload is fed to PixelDecoder::decode() chunk bytes at a time, the
+ * way SerialProtocol hands it over from the receive ring. Decoded pixels
+ * (runs expanded) go to stdout as RGB565 big-endian, i.e. the raw BLIT
+ * payload of the same image. Exit status 1 on a decode error, 2 if the
+ * payload ended before every pixel was decoded.
+ */
+
+#include <stdio.h>
+#include <vector>
+
+#include "PixelDecoder.h"
+
+class StdoutSink : public PixelSink {
+public:
+    void emitPixel(uint16_t wirePixel) override {
+        // Wire order keeps the high byte in the low half
+        putchar(wirePixel & 0xFF);
+        putchar(wirePixel >> 8);
+    }
+    
+    void emitRun(uint16_t wirePixel, uint32_t count) override {
+        while (count--) {
+            emitPixel(wirePixel);
+        }
+    }
+};
+
+int main(int argc, char** argv) {
+    if (argc != 5) {
+        fprintf(stderr, "usage: %s <encoding> <width> <pixels> <chunk bytes> < payload\n", argv[0]);
+        return 64;
+    }
+    uint8_t encoding = (uint8_t)strtoul(argv[1], nullptr, 0);
+    uint16_t width = (uint16_t)strtoul(argv[2], nullptr, 0);
+    uint32_t pixels = strtoul(argv[3], nullptr, 0);
+    size_t chunkBytes = strtoul(argv[4], nullptr, 0);
+    
+    std::vector<uint8_t> payload;
+    int c;
+    while ((c = getchar()) != EOF) {
+        payload.push_back((uint8_t)c);
+    }
+    
+    // PixelDecoder carries a 2 KB dither row; keep it off the stack
+    static PixelDecoder decoder;
+    StdoutSink sink;
+    if (!decoder.begin(encoding, pixels, width)) {
+        fprintf(stderr, "unsupported encoding 0x%02X\n", encoding);
+        return 64;
+    }
+    for (size_t offset = 0; offset < payload.size() && !decoder.hasError(); offset += chunkBytes) {
+        size_t length = payload.size() - offset < chunkBytes ? payload.size() - offset : chunkBytes;
+        decoder.decode(payload.data() + offset, length, sink);
+    }
+    fflush(stdout);
+    
+    if (decoder.hasError()) {
+        return 1;
+    }
+    return decoder.isComplete() ? 0 : 2;
+}
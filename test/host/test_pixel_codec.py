@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Round trip of the host pixel encoders through the firmware decoder
+
+st7735_tools/pixel_codec.py and lib/SerialProtocol/PixelDecoder.cpp are two
+implementations of the same wire formats. This test builds PixelDecoder for
+the host (pixel_decoder_host.cpp, with the Arduino.h stand-in next to it),
+encodes fixtures with pixel_codec and checks that the decoder reproduces
+the raw RGB565 payload, fed in chunks of several sizes.
+
+Requirements:
+    - A host C++ compiler (c++, g++ or clang++; CXX overrides)
+
+Usage:
+    python3 test/host/test_pixel_codec.py
+"""
+
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import unittest
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+sys.path.insert(0, str(REPO_ROOT))
+
+from st7735_tools import binary_protocol, pixel_codec  # noqa: E402
+
+HOST_DIR = Path(__file__).resolve().parent
+DECODER_SOURCES = [
+    HOST_DIR / 'pixel_decoder_host.cpp',
+    REPO_ROOT / 'lib' / 'SerialProtocol' / 'PixelDecoder.cpp',
+]
+
+# Chunk sizes the payload is handed to decode() in: byte by byte, odd
+# splits that cut packets and pixels apart, and one receive block
+CHUNK_SIZES = (1, 2, 3, 7, 512)
+
+# Exit codes of pixel_decoder_host
+EXIT_DECODE_ERROR = 1
+EXIT_INCOMPLETE = 2
+
+
+def find_compiler():
+    for name in (os.environ.get('CXX'), 'c++', 'g++', 'clang++'):
+        if name and shutil.which(name):
+            return name
+    return None
+
+
+def rgb565(r, g, b):
+    """Native RGB565 from 5/6/5-bit channels"""
+    return (r << 11) | (g << 5) | b
+
+
+def qoi_collision():
+    """Two distinct colours that share a QOI index slot"""
+    seen = {}
+    for g in range(64):
+        for r in range(32):
+            pixel = rgb565(r, g, 0)
+            slot = pixel_codec._qoi_hash(pixel)
+            if slot in seen:
+                return seen[slot], pixel
+            seen[slot] = pixel
+    raise AssertionError("no QOI hash collision found")
+
+
+class PixelCodecRoundTrip(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        compiler = find_compiler()
+        if compiler is None:
+            raise unittest.SkipTest("no host C++ compiler")
+        cls.build_dir = tempfile.TemporaryDirectory()
+        cls.decoder = os.path.join(cls.build_dir.name, 'pixel_decoder_host')
+        subprocess.run([compiler, '-std=gnu++11', '-O1', '-Wall', '-Wextra',
+                        '-I', str(HOST_DIR), '-I', str(REPO_ROOT / 'lib' / 'SerialProtocol'),
+                        *map(str, DECODER_SOURCES), '-o', cls.decoder], check=True)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.build_dir.cleanup()
+
+    def decode(self, encoding, width, pixel_count, payload, chunk):
+        result = subprocess.run([self.decoder, str(encoding), str(width), str(pixel_count), str(chunk)],
+                                input=payload, stdout=subprocess.PIPE, check=False)
+        return result.returncode, result.stdout
+
+    def assert_round_trip(self, encoding, width, pixels, payload=None):
+        if payload is None:
+            encoding, payload = pixel_codec.encode(pixels, encoding)
+        expected = pixel_codec.encode_raw(pixels)
+        for chunk in CHUNK_SIZES:
+            with self.subTest(encoding=pixel_codec.encoding_name(encoding), chunk=chunk):
+                status, decoded = self.decode(encoding, width, len(pixels), payload, chunk)
+                self.assertEqual(status, 0)
+                self.assertEqual(decoded, expected)
+
+    # RLE
+
+    def test_rle_run_crosses_rows(self):
+        # 5-pixel rows: the 9-pixel run starts mid-row and ends two rows later
+        width = 5
+        pixels = [0x1234, 0x5678, 0x9ABC] + [0xF800] * 9 + [0x07E0, 0x001F, 0x07E0]
+        self.assert_round_trip(binary_protocol.ENC_RLE, width, pixels)
+
+    def test_rle_packets_split_at_maximum(self):
+        # Runs and literals longer than one 128-pixel packet
+        literal = [(i * 37) & 0xFFFF for i in range(300)]
+        pixels = [0xFFFF] * 300 + literal + [0x0000] * 129
+        self.assert_round_trip(binary_protocol.ENC_RLE, 160, pixels)
+
+    def test_rle_run_crosses_bands(self):
+        # A whole-screen colour run spans every receive band
+        self.assert_round_trip(binary_protocol.ENC_RLE, 160, [0x3186] * (160 * 128))
+
+    # QOI
+
+    def test_qoi_index_hash_collision(self):
+        first, second = qoi_collision()
+        # The slot holds the most recent colour, so the revisit of the first
+        # colour must be sent in full rather than as an INDEX op
+        pixels = [first, second, first, second, second, first]
+        self.assert_round_trip(binary_protocol.ENC_QOI, 3, pixels)
+
+    def test_qoi_all_ops(self):
+        pixels = [rgb565(10, 20, 10),   # RGB565 literal
+                  rgb565(11, 21, 9),    # DIFF
+                  rgb565(15, 40, 20),   # LUMA
+                  rgb565(10, 20, 10),   # INDEX
+                  rgb565(31, 0, 31),    # Literal
+                  rgb565(0, 63, 0)]     # Wrapping DIFF/LUMA arithmetic
+        pixels += [rgb565(0, 63, 0)] * 70   # RUN longer than 62
+        pixels += [rgb565(1, 0, 1), rgb565(0, 63, 0)]
+        self.assert_round_trip(binary_protocol.ENC_QOI, 13, pixels)
+
+    def test_qoi_run_crosses_rows(self):
+        pixels = [0x0000] * 7 + [0x2104] * 20 + [0xFFFF]
+        self.assert_round_trip(binary_protocol.ENC_QOI, 6, pixels)
+
+    # Indexed
+
+    def test_indexed_padding(self):
+        # Odd widths: indices run on across rows and only the last byte is padded
+        palette_sizes = {binary_protocol.ENC_INDEXED1: 2, binary_protocol.ENC_INDEXED2: 4,
+                         binary_protocol.ENC_INDEXED4: 16, binary_protocol.ENC_INDEXED8: 256}
+        for encoding, colors in palette_sizes.items():
+            for width, height in ((3, 3), (5, 2), (7, 1), (1, 9)):
+                pixels = [(i % colors) * 0x0101 + 0x0841 for i in range(width * height)]
+                with self.subTest(encoding=pixel_codec.encoding_name(encoding), width=width):
+                    self.assert_round_trip(encoding, width, pixels)
+
+    def test_indexed_padding_bits_ignored(self):
+        # Set padding bits after the last index must not become pixels
+        pixels = [0x0000, 0xFFFF, 0xFFFF]
+        encoding, payload = pixel_codec.encode(pixels, binary_protocol.ENC_INDEXED1)
+        payload = payload[:-1] + bytes([payload[-1] | 0x1F])
+        self.assert_round_trip(encoding, 3, pixels, payload)
+
+    def test_indexed_partial_palette(self):
+        # A 3-colour palette used with 2-bit indices
+        pixels = [0xF800, 0x07E0, 0x001F] * 5
+        self.assert_round_trip(binary_protocol.ENC_INDEXED2, 5, pixels)
+
+    # Malformed payloads
+
+    def test_truncated_payload_is_incomplete(self):
+        pixels = [0x1234] * 4 + [0x4321, 0x1111]
+        for encoding in (binary_protocol.ENC_RLE, binary_protocol.ENC_QOI):
+            encoding, payload = pixel_codec.encode(pixels, encoding)
+            with self.subTest(encoding=pixel_codec.encoding_name(encoding)):
+                status, _ = self.decode(encoding, 3, len(pixels), payload[:-1], 512)
+                self.assertEqual(status, EXIT_INCOMPLETE)
+
+    def test_overlong_payload_is_an_error(self):
+        pixels = [0xAAAA] * 4
+        _, payload = pixel_codec.encode(pixels, binary_protocol.ENC_RLE)
+        status, _ = self.decode(binary_protocol.ENC_RLE, 2, len(pixels), payload * 2, 512)
+        self.assertEqual(status, EXIT_DECODE_ERROR)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -85,6 +85,18 @@ SavedState lastSavedState = {1, 0, 0, 0, 0, 2};
 bool hasUnsavedChanges = false;
 bool hasEverSaved = false;
 
+// Frame as last painted by redrawFrame() on an otherwise black screen, so
+// arrow-key edits repaint only the strips that changed
+struct FrameRect {
+  int x;
+  int y;
+  int w;
+  int h;
+  int thickness;
+};
+FrameRect shownFrame = {0, 0, 0, 0, 0};
+bool shownFrameValid = false;  // Cleared by anything else that draws
+
 // Display configuration
 String currentDisplayName = "";  // Name of display being calibrated
 bool configExists = false;       // Whether a valid config exists
@@ -116,6 +128,8 @@ void moveFrame(char direction);
 void adjustThickness(char direction);
 void rotateDisplay(char direction);
 void redrawFrame();
+FrameRect currentFrame();
+bool frameStrip(const FrameRect& frame, int index, int& x, int& y, int& w, int& h);
 void initializeBoundsFromPublished();
 void handleEscapeKey();
 bool validateAndClampBounds();
@@ -249,6 +263,7 @@ void setRotation(int rotation) {
   if (rotation >= 0 && rotation <= 3) {
     currentRotation = rotation;
     tft.setRotation(rotation);
+    shownFrameValid = false;
     SerialUSB.println("Rotation set to: " + String(rotation));
     SerialUSB.println("Display size: " + String(tft.width()) + " x " + String(tft.height()));
     
@@ -266,39 +281,49 @@ void setRotation(int rotation) {
 
 void clearScreen() {
   tft.fillScreen(ST77XX_BLACK);
+  shownFrameValid = false;
   SerialUSB.println("Screen cleared to black using fillScreen().");
 }
 
+FrameRect currentFrame() {
+  // Usable bounds clamped to the display, thickness limited to fit inside
+  int maxX = tft.width();
+  int maxY = tft.height();
+  FrameRect frame;
+  frame.x = constrain(usableOriginX, 0, maxX - 1);
+  frame.y = constrain(usableOriginY, 0, maxY - 1);
+  frame.w = constrain(usableWidth, 1, maxX - frame.x);
+  frame.h = constrain(usableHeight, 1, maxY - frame.y);
+  frame.thickness = min(frameThickness, min(frame.w / 2, frame.h / 2));
+  return frame;
+}
+
+bool frameStrip(const FrameRect& frame, int index, int& x, int& y, int& w, int& h) {
+  // Strips 0-3: top and bottom span the full width, left and right the rows between
+  int t = frame.thickness;
+  bool horizontal = index < 2;
+  x = (index == 3) ? frame.x + frame.w - t : frame.x;
+  y = (index == 1) ? frame.y + frame.h - t : frame.y + (horizontal ? 0 : t);
+  w = horizontal ? frame.w : t;
+  h = horizontal ? t : frame.h - 2 * t;
+  return t > 0 && w > 0 && h > 0;
+}
+
 void drawFrame() {
+  shownFrameValid = false;
+  
   // If usable bounds are set, draw frame at those bounds
   if (usableWidth > 0 && usableHeight > 0) {
-    // Ensure bounds are within display limits
-    int maxX = tft.width();
-    int maxY = tft.height();
-    
-    // Clamp values to valid range
-    int clampedX = constrain(usableOriginX, 0, maxX - 1);
-    int clampedY = constrain(usableOriginY, 0, maxY - 1);
-    int clampedW = constrain(usableWidth, 1, maxX - clampedX);
-    int clampedH = constrain(usableHeight, 1, maxY - clampedY);
-    
     // Draw frame with current thickness, ensuring it stays within bounds
-    int maxThickness = min(frameThickness, min(clampedW / 2, clampedH / 2));
-    for (int i = 0; i < maxThickness; i++) {
-      int rectW = clampedW - (2 * i);
-      int rectH = clampedH - (2 * i);
-      if (rectW > 0 && rectH > 0) {
-        tft.drawRect(
-          clampedX + i, 
-          clampedY + i, 
-          rectW, 
-          rectH, 
-          ST77XX_WHITE
-        );
+    FrameRect frame = currentFrame();
+    int x, y, w, h;
+    for (int strip = 0; strip < 4; strip++) {
+      if (frameStrip(frame, strip, x, y, w, h)) {
+        tft.fillRect(x, y, w, h, ST77XX_WHITE);
       }
     }
     SerialUSB.print("Frame drawn at usable bounds with thickness ");
-    SerialUSB.println(maxThickness);
+    SerialUSB.println(frame.thickness);
     return;
   }
   
@@ -504,6 +529,7 @@ void exportConfig() {
   SerialUSB.println("manufacturer = \"Unknown\"  # TODO: Set manufacturer");
   SerialUSB.println("model = \"Generic ST7735\"  # TODO: Set model");
   SerialUSB.println("published_resolution = [" + String(PUBLISHED_WIDTH) + ", " + String(PUBLISHED_HEIGHT) + "]");
+  SerialUSB.println("max_spi_hz = 32000000  # Raise (84 MHz / n, up to 42 MHz) if the panel stays clean");
   SerialUSB.println();
   SerialUSB.println("[pinout]");
   SerialUSB.println("# Arduino Due pin assignments");
@@ -511,6 +537,7 @@ void exportConfig() {
   SerialUSB.println("dc = " + String(TFT_DC));
   SerialUSB.println("cs = " + String(TFT_CS));
   SerialUSB.println("bl = " + String(TFT_BL));
+  SerialUSB.println("# te = 2  # Tearing-effect (vsync) output, if wired");
   SerialUSB.println();
   SerialUSB.println("[calibration]");
   SerialUSB.println("orientation = \"" + orientation + "\"");
@@ -823,8 +850,47 @@ bool validateAndClampBounds() {
 void redrawFrame() {
   // Validate bounds before drawing
   validateAndClampBounds();
-  clearScreen();
-  drawFrame();
+  FrameRect next = currentFrame();
+  if (!shownFrameValid) {
+    clearScreen();
+    drawFrame();
+    shownFrame = next;
+    shownFrameValid = true;
+    return;
+  }
+  
+  // Only the strips that changed: the parts of each old strip outside its
+  // replacement go back to black (strips of one frame never overlap), then
+  // the new strips are filled - a 1-pixel edge step repaints a few hundred pixels
+  bool changed[4];
+  for (int strip = 0; strip < 4; strip++) {
+    int ox, oy, ow, oh, nx, ny, nw, nh;
+    bool hadOld = frameStrip(shownFrame, strip, ox, oy, ow, oh);
+    bool hasNew = frameStrip(next, strip, nx, ny, nw, nh);
+    changed[strip] = hadOld != hasNew || ox != nx || oy != ny || ow != nw || oh != nh;
+    if (!hadOld || !changed[strip]) {
+      continue;
+    }
+    int left = max(ox, nx);
+    int right = min(ox + ow, nx + nw);
+    int top = max(oy, ny);
+    int bottom = min(oy + oh, ny + nh);
+    if (!hasNew || left >= right || top >= bottom) {
+      tft.fillRect(ox, oy, ow, oh, ST77XX_BLACK);
+      continue;
+    }
+    if (top > oy) tft.fillRect(ox, oy, ow, top - oy, ST77XX_BLACK);
+    if (bottom < oy + oh) tft.fillRect(ox, bottom, ow, oy + oh - bottom, ST77XX_BLACK);
+    if (left > ox) tft.fillRect(ox, top, left - ox, bottom - top, ST77XX_BLACK);
+    if (right < ox + ow) tft.fillRect(right, top, ox + ow - right, bottom - top, ST77XX_BLACK);
+  }
+  for (int strip = 0; strip < 4; strip++) {
+    int x, y, w, h;
+    if (changed[strip] && frameStrip(next, strip, x, y, w, h)) {
+      tft.fillRect(x, y, w, h, ST77XX_WHITE);
+    }
+  }
+  shownFrame = next;
 }
 
 void adjustEdge(char direction) {